@@ -107,6 +107,11 @@ class comm_t {
   /*MPI_Comm_dup and MPI_Comm_delete*/
   comm_t Dup() const;
   comm_t Split(const int color, const int key) const;
+  /*MPI_Comm_split_type, ranks which can share memory*/
+  comm_t SplitShared(const int key) const;
+  /*MPI_Dist_graph_create_adjacent*/
+  comm_t DistGraphCreateAdjacent(const memory<int> sources,
+                                 const memory<int> destinations) const;
   void Free();
 
   /*Rank and size getters*/
@@ -553,6 +558,36 @@ class comm_t {
     mpiType<T>::freeMpiType(type);
   }
 
+  /*libp::memory neighborhood alltoallv (distributed graph comms)*/
+  template <template<typename> class mem, typename T>
+  void Neighbor_alltoallv(const mem<T> snd,
+                          const memory<int> sendCounts,
+                          const memory<int> sendOffsets,
+                                mem<T> rcv,
+                          const memory<int> recvCounts,
+                          const memory<int> recvOffsets) const {
+    MPI_Datatype type = mpiType<T>::getMpiType();
+    MPI_Neighbor_alltoallv(snd.ptr(), sendCounts.ptr(), sendOffsets.ptr(), type,
+                           rcv.ptr(), recvCounts.ptr(), recvOffsets.ptr(), type,
+                           comm());
+    mpiType<T>::freeMpiType(type);
+  }
+
+  template <template<typename> class mem, typename T>
+  void Ineighbor_alltoallv(const mem<T> snd,
+                           const memory<int> sendCounts,
+                           const memory<int> sendOffsets,
+                                 mem<T> rcv,
+                           const memory<int> recvCounts,
+                           const memory<int> recvOffsets,
+                           Comm::request_t &request) const {
+    MPI_Datatype type = mpiType<T>::getMpiType();
+    MPI_Ineighbor_alltoallv(snd.ptr(), sendCounts.ptr(), sendOffsets.ptr(), type,
+                            rcv.ptr(), recvCounts.ptr(), recvOffsets.ptr(), type,
+                            comm(), &request);
+    mpiType<T>::freeMpiType(type);
+  }
+
   void Wait(Comm::request_t &request) const;
   void Waitall(const int count, memory<Comm::request_t> &requests) const;
   void Barrier() const;
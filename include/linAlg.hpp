@@ -111,6 +111,17 @@ class linAlg_t {
   dfloat innerProd(const dlong N, deviceMemory<dfloat> o_x, deviceMemory<dfloat> o_y,
                     comm_t comm);
 
+  // dots[i] = o_X_i.o_y, i<Nvec, with the o_X_i stored back to back with stride Nstride
+  // (a single device reduction and a single Allreduce)
+  void multiInnerProd(const dlong N, const int Nvec, const dlong Nstride,
+                      deviceMemory<dfloat> o_X, deviceMemory<dfloat> o_y,
+                      memory<dfloat> dots, comm_t comm);
+
+  // o_y[n] = beta*o_y[n] + \sum_i alpha[i]*o_X_i[n], i<Nvec
+  void multiAxpy(const dlong N, const int Nvec, const dlong Nstride,
+                 const memory<dfloat> alpha, deviceMemory<dfloat> o_X,
+                 const dfloat beta, deviceMemory<dfloat> o_y);
+
   // ||o_a||_w2
   dfloat weightedNorm2(const dlong N, deviceMemory<dfloat> o_w, deviceMemory<dfloat> o_a,
                        comm_t comm);
@@ -172,6 +183,25 @@ class linAlg_t {
                               const memory<long long int>  A, const int LDA,
                               memory<long long int> AT, const int LDAT);
 
+  // Host sparse product C = A*B, threaded with OpenMP.
+  //  A is held as a diag and an offd CSR block whose column ids index rows
+  //  of B. B and C carry global column ids, and rows of C are column sorted.
+  //  The symbolic pass fills CrowStarts, the numeric pass fills Ccols/Cvals
+  static void SpGEMMSymbolic(const dlong Nrows,
+                             const memory<dlong> AdiagRowStarts, const memory<dlong> AdiagCols,
+                             const memory<dlong> AoffdRowStarts, const memory<dlong> AoffdCols,
+                             const memory<dlong> BrowStarts, const memory<hlong> Bcols,
+                             memory<dlong> CrowStarts);
+  static void SpGEMMNumeric(const dlong Nrows,
+                            const memory<dlong> AdiagRowStarts, const memory<dlong> AdiagCols,
+                            const memory<pfloat> AdiagVals,
+                            const memory<dlong> AoffdRowStarts, const memory<dlong> AoffdCols,
+                            const memory<pfloat> AoffdVals,
+                            const memory<dlong> BrowStarts, const memory<hlong> Bcols,
+                            const memory<pfloat> Bvals,
+                            const memory<dlong> CrowStarts,
+                            memory<hlong> Ccols, memory<pfloat> Cvals);
+
  private:
   platform_t *platform;
   properties_t kernelInfo;
@@ -182,6 +212,11 @@ class linAlg_t {
   deviceMemory<dfloat> o_scratch;
   pinnedMemory<dfloat> h_scratch;
 
+  //scratch space for batched multi-vector operations, grown on demand
+  deviceMemory<dfloat> o_multiScratch;
+  pinnedMemory<dfloat> h_multiScratch;
+  void MultiScratch(const size_t Nentries);
+
   kernel_t setKernel;
   kernel_t addKernel;
   kernel_t scaleKernel;
@@ -207,6 +242,9 @@ class linAlg_t {
   kernel_t innerProdKernel2;
   kernel_t weightedInnerProdKernel1;
   kernel_t weightedInnerProdKernel2;
+  kernel_t multiInnerProdKernel1;
+  kernel_t multiInnerProdKernel2;
+  kernel_t multiAxpyKernel;
 };
 
 } //namespace libp
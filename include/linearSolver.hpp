@@ -106,9 +106,17 @@ private:
   int flexible;
 
   kernel_t updatePCGKernel;
+  kernel_t dotsPCGKernel;
+  kernel_t updateDiagonalPCGKernel;
 
   dfloat UpdatePCG(const dfloat alpha, deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r);
 
+  void DotsPCG(deviceMemory<dfloat>& o_r, dfloat& rdotz, dfloat& zdotAp);
+
+  dfloat UpdateDiagonalPCG(const dfloat alpha, deviceMemory<dfloat>& o_invD,
+                           deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r,
+                           dfloat& rdotz, dfloat& zdotAp);
+
 public:
   pcg(dlong _N, dlong _Nhalo,
        platform_t& _platform, settings_t& _settings, comm_t _comm);
@@ -118,15 +126,51 @@ public:
             const dfloat tol, const int MAXIT, const int verbose);
 };
 
+//Block Preconditioned Conjugate Gradient
+// Solves Nrhs independent systems in lockstep. The vectors are stored back
+// to back with stride N+Nhalo and the reductions of all right-hand sides
+// are fused into a single Allreduce.
+class blockpcg: public linearSolverBase_t {
+private:
+  int Nrhs;
+  dlong Nlocal, Nstride;
+
+  deviceMemory<dfloat> o_p, o_Ap, o_z, o_Ax;
+
+  pinnedMemory<dfloat> h_dots;
+  deviceMemory<dfloat> o_dots;
+
+  deviceMemory<dfloat> o_coefs;
+
+  kernel_t innerProdKernel;
+  kernel_t updatePKernel;
+  kernel_t updatePCGKernel;
+
+  void InnerProd(deviceMemory<dfloat>& o_a, deviceMemory<dfloat>& o_b, memory<dfloat> dots);
+  void UpdateP(const memory<dfloat> beta);
+  void UpdatePCG(const memory<dfloat> alpha, deviceMemory<dfloat>& o_x,
+                 deviceMemory<dfloat>& o_r, memory<dfloat> rdotr);
+
+public:
+  blockpcg(dlong _N, dlong _Nhalo, int _Nrhs,
+           platform_t& _platform, settings_t& _settings, comm_t _comm);
+
+  int Solve(operator_t& linearOperator, operator_t& precon,
+            deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_rhs,
+            const dfloat tol, const int MAXIT, const int verbose);
+};
+
 //Preconditioned GMRES
 class pgmres: public linearSolverBase_t {
 private:
   deviceMemory<dfloat> o_Ax, o_z, o_r;
-  memory<deviceMemory<dfloat>> o_V;
+  deviceMemory<dfloat> o_V;
 
   int restart;
+  dlong Ntotal;
 
   memory<dfloat> H, sn, cs, s, y;
+  memory<dfloat> proj1, proj2, alpha;
 
   void UpdateGMRES(deviceMemory<dfloat>& o_x, const int I);
 
@@ -213,6 +257,74 @@ public:
             const dfloat tol, const int MAXIT, const int verbose);
 };
 
+//Pipelined Preconditioned Conjugate Gradient (Ghysels & Vanroose)
+// A single non-blocking reduction per iteration, overlapped with the
+// preconditioner and operator applications.
+class pipecg: public linearSolverBase_t {
+private:
+  deviceMemory<dfloat> o_u, o_w, o_m, o_n, o_z, o_q, o_s, o_p, o_Ax;
+
+  pinnedMemory<dfloat> dots;
+  deviceMemory<dfloat> o_dots;
+
+  kernel_t updatePIPECGKernel;
+
+  Comm::request_t request;
+
+  void UpdatePIPECG(const dfloat alpha, const dfloat beta,
+                    deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r);
+
+public:
+  pipecg(dlong _N, dlong _Nhalo,
+       platform_t& _platform, settings_t& _settings, comm_t _comm);
+
+  int Solve(operator_t& linearOperator, operator_t& precon,
+            deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_rhs,
+            const dfloat tol, const int MAXIT, const int verbose);
+};
+
+//s-step Preconditioned Conjugate Gradient (Chronopoulos & Gear)
+// Takes s CG steps at a time over the basis [z, MAz, ..., (MA)^(s-1) z],
+// with z = M r. Each block of s steps needs a single reduction for its
+// Gram matrices, plus one non-blocking r.r overlapped with M*r.
+class sstepcg: public linearSolverBase_t {
+private:
+  int s;
+  dlong Nstride;
+
+  deviceMemory<dfloat> o_R, o_AR, o_P, o_AP, o_Ax;
+  memory<deviceMemory<dfloat>> o_Rv, o_ARv;
+
+  pinnedMemory<dfloat> h_dots, h_rdotr;
+  deviceMemory<dfloat> o_dots, o_rdotr;
+
+  pinnedMemory<dfloat> h_coefs;
+  deviceMemory<dfloat> o_coefs;
+
+  //small dense systems, solved redundantly on every rank
+  int NsPrev=0;
+  memory<dfloat> G, C, g, B, a;
+  memory<dfloat> L, D, Lprev, Dprev;
+
+  kernel_t multiDotKernel;
+  kernel_t updatePKernel;
+  kernel_t updateXKernel;
+
+  Comm::request_t request;
+
+  void GramMatrices(deviceMemory<dfloat>& o_r);
+  int SolveBlock(const int maxNs);
+  void UpdateX(const int Ns, deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r);
+
+public:
+  sstepcg(dlong _N, dlong _Nhalo,
+       platform_t& _platform, settings_t& _settings, comm_t _comm);
+
+  int Solve(operator_t& linearOperator, operator_t& precon,
+            deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_rhs,
+            const dfloat tol, const int MAXIT, const int verbose);
+};
+
 } //namespace LinearSolver
 
 } //namespace libp
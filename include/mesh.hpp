@@ -504,6 +504,7 @@ class mesh_t {
   void ReadGmshQuad3D(const std::string fileName);
   void ReadGmshTet3D(const std::string fileName);
   void ReadGmshHex3D(const std::string fileName);
+  void ReadGmshParallel(const std::string fileName);
 
   // reference nodes and operators
   void ReferenceNodes() {
@@ -548,6 +549,13 @@ class mesh_t {
   /* build global connectivity in parallel */
   void ConnectNodes();
 
+  /* load/store partitioned and connected mesh */
+  uint64_t CacheKey();
+  bool ReadCache(const std::string cacheName, const std::string meshFile,
+                 const uint64_t cacheKey);
+  void WriteCache(const std::string cacheName, const std::string meshFile,
+                  const uint64_t cacheKey, const memory<hlong> connectedEToE);
+
   /* build global gather scatter ops */
   void GatherScatterSetup();
 
@@ -0,0 +1,117 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MESH_VTU_HPP
+#define MESH_VTU_HPP 1
+
+#include "mesh.hpp"
+#include <thread>
+#include <vector>
+
+namespace libp {
+
+namespace Mesh {
+  /*VTU output formats*/
+  enum VTUFormat {
+    ASCII,    //human readable text
+    BINARY,   //base64 encoded inline binary
+    APPENDED  //raw binary appended at end of file
+  };
+} //namespace Mesh
+
+/*Writes nodal fields, interpolated to the plot nodes of each element,
+  to one VTU piece per rank and a PVTU index written by rank 0.
+  Fields are interpolated over all local elements when they are added
+  and the file write itself may be deferred to a host thread.*/
+class vtuWriter_t {
+ public:
+  vtuWriter_t()=default;
+  vtuWriter_t(mesh_t& _mesh) {
+    Setup(_mesh);
+  }
+
+  void Setup(mesh_t& _mesh);
+
+  bool isInitialized() const {
+    return setup;
+  }
+
+  /*Interpolate a nodal field to the plot nodes and stage it for output.
+    Component c of element e is read from q + (e*Nfields + fieldOffset + c)*Np*/
+  void AddPointData(const std::string name,
+                    const memory<dfloat> q,
+                    const int Ncomponents=1,
+                    const int Nfields=1,
+                    const int fieldOffset=0);
+
+  /*Write staged fields to name_RANK_FRAME.vtu and name_FRAME.pvtu.
+    Frame numbers are omitted when frame<0.*/
+  void Write(const std::string name, const int frame=-1);
+
+  /*Wait for an outstanding asynchronous write to complete*/
+  void Finish();
+
+ private:
+  struct field_t {
+    std::string name;
+    int Ncomponents;
+    memory<float> data;
+  };
+
+  mesh_t mesh;
+  bool setup=false;
+
+  Mesh::VTUFormat format=Mesh::APPENDED;
+  bool async=false;
+
+  //plot mesh, built once at setup
+  memory<float> points;
+  memory<int> connectivity;
+  memory<int> offsets;
+  memory<unsigned char> types;
+
+  std::vector<field_t> fields;
+
+  std::shared_ptr<std::thread> writeThread;
+
+  static void WritePiece(const std::string fileName,
+                         const Mesh::VTUFormat format,
+                         const memory<float> points,
+                         const memory<int> connectivity,
+                         const memory<int> offsets,
+                         const memory<unsigned char> types,
+                         const std::vector<field_t> fields);
+
+  static void WriteIndex(const std::string fileName,
+                         const std::string pieceName,
+                         const int size,
+                         const int frame,
+                         const std::vector<field_t> fields);
+};
+
+} //namespace libp
+
+#endif
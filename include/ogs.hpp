@@ -127,6 +127,14 @@ SOFTWARE.
   with summation here being vector summation. Number of messages sent
   is independent of k.
 
+  Several separately stored vectors can also be communicated together, e.g.,
+
+    std::vector<deviceMemory<dfloat>> o_vs = {o_u, o_v, o_w};
+    ogs.GatherScatter(o_vs, ogs::Add, ogs::Sym);
+
+  The halo values of all the vectors are packed into a single buffer so that
+  each neighbor receives one message per exchange, rather than one per vector.
+
   Asynchronous versions of the various GatherScatter functions are provided by
 
     ogs.GatherScatterStart(o_v, k, ogs::Add, ogs::Sym);
@@ -154,7 +162,12 @@ SOFTWARE.
     halo.Exchange(o_v, k);
 
   which has the effect of filling all "flagged" pairs (p,i) on all processes with
-  the corresponding value from the unique "unflagged" pair in S_j.
+  the corresponding value from the unique "unflagged" pair in S_j. Setting
+
+    halo.compressed = true;
+
+  sends double precision device data rounded to float, halving the message
+  size. The "unflagged" entries are unchanged; only the filled copies are rounded.
 
   An additional untility operation available in the halo_t object is
 
@@ -194,7 +207,7 @@ typedef enum { Add, Mul, Max, Min} Op;
 typedef enum { Sym, NoTrans, Trans } Transpose;
 
 /* method switch */
-typedef enum { Auto, Pairwise, CrystalRouter, AllToAll} Method;
+typedef enum { Auto, Pairwise, CrystalRouter, AllToAll, Neighborhood, Hierarchical} Method;
 
 /* kind enum */
 typedef enum { Unsigned, Signed, Halo} Kind;
@@ -229,6 +242,12 @@ public:
 
   void SetupGlobalToLocalMapping(memory<dlong> GlobalToLocal);
 
+  //time the device GatherScatter and report effective bandwidth
+  void ReportThroughput(const int k=1);
+
+  //check the batched device GatherScatter and Gather against one call per vector
+  void CheckBatch();
+
   // Synchronous host versions
   template<typename T>
   void GatherScatter(memory<T> v,
@@ -263,6 +282,11 @@ public:
                            const int k,
                            const Op op,
                            const Transpose trans);
+  // Synchronous batched device version, one exchange for all vectors
+  template<typename T>
+  void GatherScatter(std::vector<deviceMemory<T>>& o_vs,
+                     const Op op,
+                     const Transpose trans);
 
   // Synchronous host versions
   template<typename T>
@@ -304,6 +328,12 @@ public:
                     const int k,
                     const Op op,
                     const Transpose trans);
+  // Synchronous batched device version, one exchange for all vectors
+  template<typename T>
+  void Gather(std::vector<deviceMemory<T>>& o_gvs,
+              std::vector<deviceMemory<T>>& o_vs,
+              const Op op,
+              const Transpose trans);
 
   // Synchronous host versions
   template<typename T>
@@ -341,6 +371,12 @@ public:
                      const Transpose trans);
 
   friend class halo_t;
+
+private:
+  //choose between the split and fused finish of the device GatherScatter
+  void FusedAutoSetup(const bool verbose);
+
+  double GatherScatterTime(deviceMemory<dfloat>& o_v, const int k);
 };
 
 // OCCA Halo
@@ -352,6 +388,10 @@ public:
   bool gathered_halo=false;
   dlong Nhalo=0;
 
+  //send double precision data rounded to float in the device exchange.
+  // Only the received halo copies lose precision
+  bool compressed=false;
+
   void Setup(const dlong _N,
              memory<hlong> ids,
              comm_t _comm,
@@ -377,6 +417,9 @@ public:
   void ExchangeStart (deviceMemory<T> o_v, const int k);
   template<typename T>
   void ExchangeFinish(deviceMemory<T> o_v, const int k);
+  // Synchronous batched device version, one exchange for all vectors
+  template<typename T>
+  void Exchange(std::vector<deviceMemory<T>>& o_vs);
 
   // Synchronous Host version
   template<typename T>
@@ -394,6 +437,18 @@ public:
   void CombineStart (deviceMemory<T> o_v, const int k);
   template<typename T>
   void CombineFinish(deviceMemory<T> o_v, const int k);
+
+  //compare the compressed and full precision device exchanges of o_v
+  void ReportCompression(deviceMemory<dfloat>& o_v, const int k);
+
+  //check the batched device Exchange against one exchange per vector
+  void CheckBatch();
+
+private:
+  deviceMemory<char> o_haloSpace;
+
+  void CompressedExchangeStart (deviceMemory<double> o_v, const int k);
+  void CompressedExchangeFinish(deviceMemory<double> o_v, const int k);
 };
 
 } //namespace ogs
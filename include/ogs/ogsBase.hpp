@@ -81,8 +81,19 @@ protected:
   std::shared_ptr<ogsOperator_t> gatherHalo;
   std::shared_ptr<ogsExchange_t> exchange;
 
+  //local gather-scatter and halo write-back in one sweep
+  std::shared_ptr<ogsFusedOperator_t> gatherFused;
+  bool fused=false;
+
   void AssertGatherDefined();
 
+  //MPI exchange of a halo buffer interleaving Nf vectors
+  template<typename T>
+  void ExchangeBatch(deviceMemory<T> o_haloBuf,
+                     const dlong Nsend, const dlong Nrecv,
+                     const dlong recvOffset, const int Nf,
+                     const Op op, const Transpose trans);
+
 private:
   void FindSharedNodes(const dlong Nids,
                        memory<parallelNode_t> &nodes,
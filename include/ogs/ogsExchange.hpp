@@ -48,6 +48,10 @@ public:
 
   stream_t dataStream;
   static kernel_t extractKernel[4];
+  static kernel_t packBatchKernel[4];
+  static kernel_t unpackBatchKernel[4];
+  static kernel_t packFloatKernel;
+  static kernel_t unpackFloatKernel;
 
 #ifdef GPU_AWARE_MPI
   bool gpu_aware=true;
@@ -247,6 +251,92 @@ public:
   virtual void AllocBuffer(size_t Nbytes);
 };
 
+//MPI communcation via neighborhood collectives on a
+// distributed graph communicator of the fixed exchange pattern
+class ogsNeighborhood_t: public ogsExchange_t {
+private:
+
+  dlong NsendN=0, NsendT=0;
+  memory<dlong> sendIdsN, sendIdsT;
+  deviceMemory<dlong> o_sendIdsN, o_sendIdsT;
+
+  ogsOperator_t postmpi;
+
+  comm_t graphComm;
+
+  dlong NrecvN=0, NrecvT=0;
+  int NranksSend=0, NranksRecv=0;
+  memory<int> sendCountsN;
+  memory<int> sendCountsT;
+  memory<int> recvCountsN;
+  memory<int> recvCountsT;
+  memory<int> sendOffsetsN;
+  memory<int> sendOffsetsT;
+  memory<int> recvOffsetsN;
+  memory<int> recvOffsetsT;
+
+  memory<int> sendCounts;
+  memory<int> recvCounts;
+  memory<int> sendOffsets;
+  memory<int> recvOffsets;
+
+  Comm::request_t request;
+
+  void SetCounts(const int k, const Transpose trans);
+
+public:
+  ogsNeighborhood_t(dlong Nshared,
+                    memory<parallelNode_t> &sharedNodes,
+                    ogsOperator_t &gatherHalo,
+                    stream_t _dataStream,
+                    comm_t _comm,
+                    platform_t &_platform);
+
+  template<typename T>
+  void Start(pinnedMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  template<typename T>
+  void Finish(pinnedMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  virtual void Start(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  template<typename T>
+  void Start(deviceMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  template<typename T>
+  void Finish(deviceMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  virtual void Start(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  virtual void AllocBuffer(size_t Nbytes);
+};
+
 //MPI communcation via Crystal Router
 class ogsCrystalRouter_t: public ogsExchange_t {
 private:
@@ -329,6 +419,96 @@ public:
   virtual void AllocBuffer(size_t Nbytes);
 };
 
+//Two-level MPI communcation. Ranks on the same node combine their shared
+// nodes through an MPI shared memory window, and one leader rank per node
+// exchanges the node totals with the leaders of the other nodes
+class ogsHierarchical_t: public ogsExchange_t {
+private:
+
+  comm_t nodeComm;   //ranks which share memory with this rank
+  comm_t leaderComm; //one rank per node, only used by the leaders
+  int nodeRank=0, nodeSize=1;
+  bool leader=false;
+
+  //node group of each of this rank's halo nodes
+  memory<dlong> groupIds;
+
+  //shared memory window, holding a segment for each rank on the node
+  MPI_Win window=MPI_WIN_NULL;
+  size_t windowNbytes=0;
+  memory<char*> segments;
+  char* results=nullptr;
+  dlong leaderNhalo=0;
+
+  //leader only: each rank's halo nodes gathered into node groups
+  dlong Ngroups=0;
+  dlong NnodeHalo=0;
+  memory<dlong> segmentNhalo;
+  memory<dlong> segmentNhaloP;
+  memory<dlong> segmentOffsets;
+  memory<char> h_nodespace;
+
+  ogsOperator_t nodeGather;
+  std::shared_ptr<ogsExchange_t> leaderExchange;
+
+  void AllocWindow(size_t Nbytes);
+
+public:
+  ogsHierarchical_t(dlong Nshared,
+                    memory<parallelNode_t> &sharedNodes,
+                    ogsOperator_t &gatherHalo,
+                    stream_t _dataStream,
+                    comm_t _comm,
+                    platform_t &_platform);
+  ogsHierarchical_t(const ogsHierarchical_t&)=delete;
+  ogsHierarchical_t& operator=(const ogsHierarchical_t&)=delete;
+  ~ogsHierarchical_t();
+
+  template<typename T>
+  void Start(pinnedMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  template<typename T>
+  void Finish(pinnedMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  virtual void Start(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  template<typename T>
+  void Start(deviceMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  template<typename T>
+  void Finish(deviceMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  virtual void Start(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  virtual void AllocBuffer(size_t Nbytes);
+};
+
 } //namespace ogs
 
 } //namespace libp
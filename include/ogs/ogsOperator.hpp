@@ -105,6 +105,19 @@ public:
   void GatherScatter(deviceMemory<T> v, const int k,
                      const Op op, const Transpose trans);
 
+  //Apply Z to one field of a batch, writing slot f of a
+  // buffer that interleaves Nf fields
+  template<typename T>
+  void GatherBatch(deviceMemory<T> gv, const deviceMemory<T> v,
+                   const int Nf, const int f,
+                   const Op op, const Transpose trans);
+
+  //Apply Z^T to slot f of a buffer that interleaves Nf fields
+  template<typename T>
+  void ScatterBatch(deviceMemory<T> v, const deviceMemory<T> gv,
+                    const int Nf, const int f,
+                    const Transpose trans);
+
 private:
   template <template<typename> class U,
             template<typename> class V,
@@ -127,6 +140,40 @@ private:
   static kernel_t gatherScatterKernel[4][4];
   static kernel_t gatherKernel[4][4];
   static kernel_t scatterKernel[4];
+  static kernel_t gatherBatchKernel[4][4];
+  static kernel_t scatterBatchKernel[4];
+
+  friend void InitializeKernels(platform_t& platform, const Type type, const Op op);
+};
+
+// Local gather-scatter fused with the scatter of an exchanged halo
+// buffer, so the end of a gather-scatter is a single device sweep.
+// Local rows gather from the vector itself while halo rows take their
+// value from the halo buffer.
+class ogsFusedOperator_t {
+public:
+  platform_t platform;
+
+  std::shared_ptr<ogsOperator_t> gatherLocal;
+  std::shared_ptr<ogsOperator_t> gatherHalo;
+
+  ogsFusedOperator_t()=default;
+  ogsFusedOperator_t(platform_t& _platform,
+                     std::shared_ptr<ogsOperator_t> _gatherLocal,
+                     std::shared_ptr<ogsOperator_t> _gatherHalo)
+   : platform(_platform),
+     gatherLocal(_gatherLocal),
+     gatherHalo(_gatherHalo) {};
+
+  //Apply Z^T*Z to local rows and Z^T to the halo buffer
+  template<typename T>
+  void GatherScatter(deviceMemory<T> v, const deviceMemory<T> haloBuf,
+                     const int k, const Op op, const Transpose trans);
+
+private:
+  //4 types - Float, Double, Int32, Int64
+  //4 ops - Add, Mul, Max, Min
+  static kernel_t fusedGatherScatterKernel[4][4];
 
   friend void InitializeKernels(platform_t& platform, const Type type, const Op op);
 };
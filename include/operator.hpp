@@ -37,6 +37,18 @@ public:
   virtual void Operator(deviceMemory<dfloat> &o_r, deviceMemory<dfloat> &o_Mr) {
     LIBP_FORCE_ABORT("Operator not implemented in this object");
   };
+
+  //Operators which are a pointwise scaling Mr = D.*r can expose D, so that
+  // solvers may fuse their application into other vector updates
+  virtual bool Diagonal(deviceMemory<dfloat> &o_D) {
+    return false;
+  };
+
+  //Preconditioners of a shifted operator A + lambda*M may refresh their
+  // numeric data for a new shift, reusing their symbolic setup
+  virtual bool UpdateLambda(const dfloat lambda) {
+    return false;
+  };
 };
 
 } //namespace libp
@@ -52,6 +52,9 @@ void MeshPartition(platform_t &platform,
                    memory<dfloat>& EX,
                    memory<dfloat>& EY,
                    memory<dfloat>& EZ,
+                   memory<hlong>& elementInfo,
+                   const memory<dfloat>& weights,
+                   const int Nconstraints,
                    comm_t comm);
 
 } //namespace paradogs
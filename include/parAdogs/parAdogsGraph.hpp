@@ -41,6 +41,7 @@ public:
   static constexpr int MAX_NVERTS=8;
   static constexpr int MAX_NFACES=6;
   static constexpr int MAX_NFACEVERTS=4;
+  static constexpr int MAX_NCONSTRAINTS=8;
 
 private:
   platform_t platform;
@@ -57,12 +58,20 @@ private:
   hlong gNVertsGlobal=0;
   hlong gVoffsetL=0, gVoffsetU=0;
   
+  /*Node topology (for node-aware bisection)*/
+  bool nodeAware=false;
+  int Nnodes=1;
+  memory<int> nodeIds;    //node of each global rank
+  memory<int> nodeStarts; //first global rank of each node
+  int grankL=0;           //global rank of rank 0 in comm
+  std::vector<int> bisectionStarts; //grankL after each bisection
 
   dlong Nelements=0;
   int dim=0;
   int Nfaces=0;
   int NelementVerts=0;
   int NfaceVerts=0;
+  int Nconstraints=0; //number of element weights (0 for unweighted)
   struct element_t {
     dfloat EX[MAX_NVERTS]; //x coordinates of verts
     dfloat EY[MAX_NVERTS]; //y coordinates of verts
@@ -71,6 +80,9 @@ private:
 
     hlong E[MAX_NFACES];   //Global element ids of neighbors
     int F[MAX_NFACES];     //Face ids of neighbors
+
+    hlong info;                //Element tag
+    dfloat W[MAX_NCONSTRAINTS]; //Element weights
   };
   memory<element_t> elements;
 
@@ -97,8 +109,14 @@ public:
           const memory<dfloat>& EX,
           const memory<dfloat>& EY,
           const memory<dfloat>& EZ,
+          const memory<hlong>& elementInfo,
+          const memory<dfloat>& weights,
+          const int _Nconstraints,
           comm_t _comm);
 
+  /*Find which ranks share a node*/
+  void NodeTopology(const bool _nodeAware);
+
   void InertialPartition();
 
   void SpectralPartition();
@@ -115,12 +133,24 @@ public:
                    memory<int>& EToF,
                    memory<dfloat>& EX,
                    memory<dfloat>& EY,
-                   memory<dfloat>& EZ);
+                   memory<dfloat>& EZ,
+                   memory<hlong>& elementInfo);
 
 private:
   void InertialBipartition(const dfloat targetFraction[2]);
   void SpectralBipartition(const dfloat targetFraction[2]);
 
+  /*Bipartition a vector F, balancing element counts or weights*/
+  void Bisect(memory<dfloat>& F,
+              const dfloat targetFraction[2],
+              memory<int>& partition);
+
+  /*Total weight of each vertex, summed over constraints*/
+  memory<dfloat> VertexWeights();
+
+
+  /*Number of ranks to hold the left partition of the next bisection*/
+  int BisectionSize();
 
   /*Divide graph into two pieces according to a bisection*/
   void Split(const memory<int>& partition);
@@ -99,6 +99,18 @@ typedef enum {COARSEEXACT=0,COARSEOAS=1} CoarseType;
 
 class coarseSolver_t;
 
+//wall-clock breakdown of an AMG setup, in seconds
+struct amgTimings_t {
+  double coarsen=0.0;   //strength graph, aggregation, and prolongators
+  double galerkin=0.0;  //Galerkin products
+  double smoother=0.0;  //diagonals and spectral radius estimates
+  double coarse=0.0;    //coarse solver setup
+  double total=0.0;
+  bool numeric=false;   //values-only update of an existing hierarchy
+
+  std::vector<double> levels; //per AMG level, finest first. The last entry is the coarse solver
+};
+
 //multigrid preconditioner
 class multigrid_t: public operator_t {
 public:
@@ -220,6 +232,11 @@ public:
                memory<dfloat> nullVector,
                dfloat nullSpacePenalty);
 
+  // Numeric-only AMG re-setup
+  //-- A must have the same sparsity pattern and entry ordering as the
+  //   matrix passed to AMGSetup. Aggregates and prolongators are reused
+  void AMGUpdate(parCOO& A);
+
   void Operator(deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_x);
 
   void Report();
@@ -231,6 +248,14 @@ private:
   settings_t settings;
 
   std::shared_ptr<multigrid_t> multigrid=nullptr;
+
+  //AMG hierarchy data kept for numeric updates
+  int amgBaseLevel=-1;
+  bool amgNullSpace=false;
+  dfloat amgNullSpacePenalty=0.0;
+  memory<dfloat> amgCoarseNull;
+
+  amgTimings_t amgTimings;
 };
 
 } //namespace parAlmond
@@ -51,7 +51,10 @@ public:
 
 amgLevel coarsenAmgLevel(amgLevel& level, memory<dfloat>& null,
                          StrengthType strtype, dfloat theta,
-                         AggType aggtype);
+                         AggType aggtype, amgTimings_t& timings);
+
+void updateCoarseAmgLevel(amgLevel& level, amgLevel& coarseLevel,
+                          AggType aggtype, amgTimings_t& timings);
 
 strongGraph_t strongGraph(parCSR& A, StrengthType type, dfloat theta);
 
@@ -67,8 +70,10 @@ parCSR smoothProlongator(parCSR& A, parCSR& T);
 parCSR transpose(parCSR& A);
 
 parCSR SpMM(parCSR& A, parCSR& B);
+void SpMM(parCSR& A, parCSR& B, parCSR& C);
 
 parCSR galerkinProd(parCSR& A, parCSR& P);
+void galerkinProd(parCSR& A, parCSR& P, parCSR& Ac);
 
 } //namespace parAlmond
 
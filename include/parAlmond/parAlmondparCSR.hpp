@@ -101,6 +101,9 @@ public:
   //build a parCSR matrix from a distributed COO matrix
   parCSR(parCOO& A);
 
+  //overwrite the values from a COO matrix with the same sparsity pattern
+  void updateValues(parCOO& A);
+
   void haloSetup(memory<hlong> colIds);
 
   void diagSetup();
@@ -108,6 +111,7 @@ public:
   dfloat rhoDinvA();
 
   void syncToDevice();
+  void syncValuesToDevice();
 
   void SpMV(const dfloat alpha, memory<dfloat>& x,
             const dfloat beta, memory<dfloat>& y);
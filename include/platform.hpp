@@ -38,6 +38,7 @@ SOFTWARE.
 #include "comm.hpp"
 #include "settings.hpp"
 #include "linAlg.hpp"
+#include "workspace.hpp"
 
 namespace libp {
 
@@ -53,9 +54,13 @@ class iplatform_t {
 public:
   platformSettings_t settings;
   properties_t props;
+  std::string cacheDir;
+
+  std::shared_ptr<workspace_t> workspace;
 
   iplatform_t(platformSettings_t& _settings):
     settings(_settings) {
+    workspace = std::make_shared<workspace_t>();
   }
 };
 
@@ -120,6 +125,7 @@ public:
   deviceMemory<T> malloc(const size_t count,
                          const properties_t &prop = properties_t()) {
     assertInitialized();
+    CountMalloc(count*sizeof(T));
     if (occa::dtype::get<T>() == occa::dtype::none) {
       return deviceMemory<T>(device.malloc(count*sizeof(T), occa::dtype::byte, prop));
     } else {
@@ -132,6 +138,7 @@ public:
                          const memory<T> src,
                          const properties_t &prop = properties_t()) {
     assertInitialized();
+    CountMalloc(count*sizeof(T));
     if (occa::dtype::get<T>() == occa::dtype::none) {
       return deviceMemory<T>(device.malloc(count*sizeof(T), occa::dtype::byte, src.ptr(), prop));
     } else {
@@ -143,6 +150,7 @@ public:
   deviceMemory<T> malloc(const memory<T> src,
                          const properties_t &prop = properties_t()) {
     assertInitialized();
+    CountMalloc(src.size());
     if (occa::dtype::get<T>() == occa::dtype::none) {
       return deviceMemory<T>(device.malloc(src.size(), occa::dtype::byte, src.ptr(), prop));
     } else {
@@ -153,6 +161,7 @@ public:
   template <typename T>
   pinnedMemory<T> hostMalloc(const size_t count){
     assertInitialized();
+    CountMalloc(count*sizeof(T));
     properties_t hostProp("host", true);
     if (occa::dtype::get<T>() == occa::dtype::none) {
       return pinnedMemory<T>(device.malloc(count*sizeof(T), occa::dtype::byte, nullptr, hostProp));
@@ -165,6 +174,7 @@ public:
   pinnedMemory<T> hostMalloc(const size_t count,
                              const memory<T> src){
     assertInitialized();
+    CountMalloc(count*sizeof(T));
     properties_t hostProp("host", true);
     if (occa::dtype::get<T>() == occa::dtype::none) {
       return pinnedMemory<T>(device.malloc(count*sizeof(T), occa::dtype::byte, src.ptr(), hostProp));
@@ -176,6 +186,7 @@ public:
   template <typename T>
   pinnedMemory<T> hostMalloc(const memory<T> src){
     assertInitialized();
+    CountMalloc(src.size());
     properties_t hostProp("host", true);
     if (occa::dtype::get<T>() == occa::dtype::none) {
       return pinnedMemory<T>(device.malloc(src.size(), occa::dtype::byte, src.ptr(), hostProp));
@@ -184,6 +195,35 @@ public:
     }
   }
 
+  /*Scratch buffers recycled through the platform workspace*/
+  template <typename T>
+  scratchMemory<T> reserve(const size_t count) {
+    assertInitialized();
+    if (count==0) return scratchMemory<T>();
+    std::shared_ptr<internal::workspace_t>& workspace = iplatform->workspace;
+    return scratchMemory<T>(workspace,
+                            workspace->Reserve(device, count*sizeof(T), false),
+                            count);
+  }
+
+  template <typename T>
+  scratchPinnedMemory<T> hostReserve(const size_t count) {
+    assertInitialized();
+    if (count==0) return scratchPinnedMemory<T>();
+    std::shared_ptr<internal::workspace_t>& workspace = iplatform->workspace;
+    return scratchPinnedMemory<T>(workspace,
+                                  workspace->Reserve(device, count*sizeof(T), true),
+                                  count);
+  }
+
+  memoryStats_t& memoryStats() {
+    assertInitialized();
+    return iplatform->workspace->stats;
+  }
+
+  /*Print allocation counts since 'start' and workspace usage*/
+  void MemoryReport(const std::string name, const memoryStats_t& start);
+
   linAlg_t& linAlg() {
     assertInitialized();
     return *ilinAlg;
@@ -224,12 +264,23 @@ public:
   }
 
   void setCacheDir(const std::string cacheDir) {
+    iplatform->cacheDir = cacheDir;
     occa::env::setOccaCacheDir(cacheDir);
   }
 
+  const std::string& getCacheDir() const {
+    return iplatform->cacheDir;
+  }
+
  private:
   void DeviceConfig();
   void DeviceProperties();
+
+  void CountMalloc(const size_t bytes) {
+    memoryStats_t& stats = iplatform->workspace->stats;
+    stats.Nmallocs++;
+    stats.mallocBytes += bytes;
+  }
 };
 
 } //namespace libp
@@ -40,6 +40,16 @@ class precon_t: public operator_t {
     precon->Operator(o_r, o_Mr);
   }
 
+  bool Diagonal(deviceMemory<dfloat> &o_D) {
+    assertInitialized();
+    return precon->Diagonal(o_D);
+  }
+
+  bool UpdateLambda(const dfloat lambda) {
+    assertInitialized();
+    return precon->UpdateLambda(lambda);
+  }
+
   /*Generic setup. Create a Precon object and wrap it in a shared_ptr*/
   template<class Precon, class... Args>
   void Setup(Args&& ... args) {
@@ -53,6 +53,15 @@ public:
     LIBP_FORCE_ABORT("Report not implemented in this solver");
   }
 
+  //Largest stable time step for the current solution, used to adapt dt during time stepping
+  virtual dfloat MaxTimeStep(deviceMemory<dfloat>& o_q, const dfloat time) {
+    LIBP_FORCE_ABORT("MaxTimeStep not implemented in this solver");
+    return 0.0;
+  }
+
+  //Device fields, besides the time stepped solution, which must be saved to resume from a checkpoint
+  virtual void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {}
+
   //Full rhs evaluation of solver in form dq/dt = rhsf(q,t)
   virtual void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time) {
     LIBP_FORCE_ABORT("rhsf not implemented in this solver");
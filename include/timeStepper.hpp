@@ -50,6 +50,14 @@ class timeStepper_t {
 
   void Run(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat start, dfloat end);
 
+  /*Write checkpoints and resume from a restart file during Run, as
+    requested in the solver settings*/
+  void EnableCheckpointing();
+
+  /*Adapt the time step to the solver's CFL bound during Run, as requested
+    in the solver settings*/
+  void EnableAdaptiveTimeStep();
+
   void SetTimeStep(dfloat dt_);
 
   dfloat GetTimeStep();
@@ -59,11 +67,65 @@ class timeStepper_t {
  private:
   std::shared_ptr<TimeStepper::timeStepperBase_t> ts=nullptr;
 
+  bool checkpointing=false;
+  bool adaptive=false;
+
   void assertInitialized();
 };
 
 namespace TimeStepper {
 
+void AddSettings(settings_t& settings);
+void ReportSettings(settings_t& settings);
+
+/*Variable step multistep weights. The history levels sit at t, t-dtPrev[0],
+  t-dtPrev[0]-dtPrev[1], ...*/
+void AdamsBashforthWeights(const int order, const dfloat dt,
+                           const memory<dfloat> dtPrev, memory<dfloat> a);
+void ExtrapolationWeights(const int order, const dfloat dt,
+                          const memory<dfloat> dtPrev, memory<dfloat> a);
+void BackwardDifferenceWeights(const int order, const dfloat dt,
+                               const memory<dfloat> dtPrev, memory<dfloat> b);
+
+/* Parallel binary checkpoint of time stepper state. Every rank writes its
+   slice of each field into one shared file with MPI-IO, so a checkpoint
+   can be resumed on the same number of ranks. */
+class checkpoint_t {
+public:
+  checkpoint_t() = default;
+  checkpoint_t(platform_t& _platform, comm_t _comm,
+               const std::string _fileName,
+               std::vector<deviceMemory<dfloat>> _o_fields);
+
+  /*Snapshot the fields on device and start copying them to the host
+    on a separate stream. The file is written by the next Flush*/
+  void Stage(const int tstep, const memory<dfloat> _state);
+
+  /*Write a staged checkpoint to disk*/
+  void Flush();
+
+  /*Read a checkpoint into the fields and return the host state and
+    the time step it was written at*/
+  memory<dfloat> Read(const std::string restartFile, int& tstep);
+
+private:
+  platform_t platform;
+  comm_t comm;
+  std::string fileName;
+
+  stream_t dataStream;
+
+  std::vector<deviceMemory<dfloat>> o_fields;
+  memory<hlong> Nentries;
+  dlong Ntotal=0;
+
+  deviceMemory<dfloat> o_snapshot;
+  pinnedMemory<dfloat> h_snapshot;
+  memory<dfloat> state;
+
+  int stagedStep=-1;
+};
+
 //base time stepper class
 class timeStepperBase_t {
 public:
@@ -75,6 +137,16 @@ public:
 
   dfloat dt;
 
+  //CFL-adaptive time step
+  int adaptInterval=0;
+  bool variableStep=false;
+
+  //checkpoint/restart
+  int checkpointInterval=0;
+  int checkpointStep=0;
+  std::string restartFile;
+  checkpoint_t checkpoint;
+
   timeStepperBase_t(dlong Nelements, dlong NhaloElements,
                     int Np, int Nfields,
                     platform_t& _platform, comm_t _comm):
@@ -93,6 +165,44 @@ public:
     LIBP_FORCE_ABORT("GetGamma() not available in this Timestepper");
     return 0.0;
   }
+
+  void SetupAdaptiveTimeStep(solver_t& solver);
+
+  /*Called before every step. Every adaptInterval steps, reset dt from the
+    solver's stability bound, capping growth so multistep methods stay stable*/
+  void AdaptTimeStep(solver_t& solver, deviceMemory<dfloat>& o_q,
+                     const dfloat time, const int tstep) {
+    if (adaptInterval>0 && tstep>0 && tstep%adaptInterval==0)
+      dt = std::min(solver.MaxTimeStep(o_q, time), maxGrowth*dt);
+  }
+
+  void SetupCheckpoint(solver_t& solver, deviceMemory<dfloat>& o_q);
+  void FinishCheckpoint();
+
+  /*Called after every step. Writes the checkpoint staged on the previous
+    step and stages a new one every checkpointInterval steps*/
+  void Checkpoint(const dfloat time, const int tstep) {
+    if (checkpointInterval==0) return;
+    checkpoint.Flush();
+    if (tstep%checkpointInterval==0 && tstep!=checkpointStep)
+      StageCheckpoint(time, tstep);
+  }
+
+  /*Resume from the restart file, if one was requested*/
+  bool Restart(dfloat& time, int& tstep);
+
+protected:
+  static constexpr dfloat maxGrowth = 1.2;
+
+  void StageCheckpoint(const dfloat time, const int tstep);
+
+  /*Device history, besides the solution, carried between steps. Every
+    rank must register the same fields, even if some are empty locally*/
+  virtual void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {}
+
+  /*Host state (history index, step controller) carried between steps*/
+  virtual void PackState(std::vector<dfloat>& state) {}
+  virtual void UnpackState(const memory<dfloat> state) {}
 };
 
 /* Adams Bashforth, order 3 */
@@ -104,10 +214,21 @@ protected:
   memory<dfloat> ab_a;
   deviceMemory<dfloat> o_ab_a;
 
+  //previous step sizes and variable step coefficients
+  memory<dfloat> dtPrev;
+  memory<dfloat> ab_vs;
+  deviceMemory<dfloat> o_ab_vs;
+
   deviceMemory<dfloat> o_rhsq;
 
   kernel_t updateKernel;
 
+  deviceMemory<dfloat> Coefficients(const dfloat _dt, const int order);
+
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+  void PackState(std::vector<dfloat>& state);
+  void UnpackState(const memory<dfloat> state);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
 public:
@@ -187,6 +308,9 @@ protected:
   virtual void Restore(deviceMemory<dfloat> &o_Q);
   virtual void AcceptStep(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_rq);
 
+  void PackState(std::vector<dfloat>& state);
+  void UnpackState(const memory<dfloat> state);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt);
 
   virtual dfloat Estimater(deviceMemory<dfloat>& o_q);
@@ -217,6 +341,10 @@ protected:
 
   kernel_t updateKernel;
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+  void PackState(std::vector<dfloat>& state);
+  void UnpackState(const memory<dfloat> state);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
   virtual void UpdateCoefficients();
@@ -279,6 +407,9 @@ protected:
   virtual void Restore(deviceMemory<dfloat> &o_Q);
   virtual void AcceptStep(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_rq);
 
+  void PackState(std::vector<dfloat>& state);
+  void UnpackState(const memory<dfloat> state);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt);
 
   dfloat Estimater(deviceMemory<dfloat>& o_q);
@@ -344,6 +475,9 @@ protected:
   virtual void Restore(deviceMemory<dfloat> &o_Q);
   virtual void AcceptStep(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_rq);
 
+  void PackState(std::vector<dfloat>& state);
+  void UnpackState(const memory<dfloat> state);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt);
 
   dfloat Estimater(deviceMemory<dfloat>& o_q);
@@ -370,12 +504,21 @@ protected:
   deviceMemory<dfloat> o_extbdf_a;
   deviceMemory<dfloat> o_extbdf_b;
 
+  //previous step sizes and variable step coefficients
+  memory<dfloat> dtPrev;
+  memory<dfloat> extbdf_vs_a, extbdf_vs_b;
+  deviceMemory<dfloat> o_extbdf_vs_a, o_extbdf_vs_b;
+
   deviceMemory<dfloat> o_rhs;
   deviceMemory<dfloat> o_qn;
   deviceMemory<dfloat> o_F;
 
   kernel_t rhsKernel;
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+  void PackState(std::vector<dfloat>& state);
+  void UnpackState(const memory<dfloat> state);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
 public:
@@ -403,6 +546,10 @@ protected:
 
   kernel_t rhsKernel;
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+  void PackState(std::vector<dfloat>& state);
+  void UnpackState(const memory<dfloat> state);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
 public:
@@ -438,6 +585,10 @@ protected:
   kernel_t updateKernel;
   kernel_t traceUpdateKernel;
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+  void PackState(std::vector<dfloat>& state);
+  void UnpackState(const memory<dfloat> state);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
 public:
@@ -473,6 +624,10 @@ protected:
   kernel_t updateKernel;
   kernel_t traceUpdateKernel;
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+  void PackState(std::vector<dfloat>& state);
+  void UnpackState(const memory<dfloat> state);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
   void UpdateCoefficients();
@@ -500,6 +655,8 @@ private:
   deviceMemory<dfloat> o_pmlq;
   deviceMemory<dfloat> o_rhspmlq;
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+
   void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
 public:
@@ -517,6 +674,8 @@ private:
   deviceMemory<dfloat> o_rhspmlq;
   deviceMemory<dfloat> o_respmlq;
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+
   void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt);
 
 public:
@@ -544,6 +703,8 @@ private:
   void Restore(deviceMemory<dfloat> &o_Q);
   void AcceptStep(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_rq);
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+
   void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt);
 
 public:
@@ -566,6 +727,8 @@ private:
 
   kernel_t pmlUpdateKernel;
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+
   void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
 public:
@@ -598,6 +761,8 @@ private:
   void Restore(deviceMemory<dfloat> &o_Q);
   void AcceptStep(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_rq);
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+
   void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt);
 
 public:
@@ -629,6 +794,8 @@ private:
   void Restore(deviceMemory<dfloat> &o_Q);
   void AcceptStep(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_rq);
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+
   void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt);
 
 public:
@@ -649,6 +816,8 @@ private:
 
   kernel_t pmlUpdateKernel;
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+
   void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
 public:
@@ -672,6 +841,8 @@ private:
 
   kernel_t pmlUpdateKernel;
 
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+
   void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
 public:
@@ -0,0 +1,103 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef LIBP_WORKSPACE_HPP
+#define LIBP_WORKSPACE_HPP
+
+#include "core.hpp"
+#include "memory.hpp"
+
+namespace libp {
+
+/* Counters for device and pinned allocations made through a platform */
+struct memoryStats_t {
+  size_t Nmallocs=0;        // platform malloc/hostMalloc calls
+  size_t mallocBytes=0;     // bytes allocated by those calls
+  size_t Nreserves=0;       // scratch buffers handed out by the workspace
+  size_t NreserveMisses=0;  // reserves which had to allocate a new buffer
+  size_t bytesInUse=0;      // scratch bytes currently handed out
+  size_t peakBytesInUse=0;  // high-water mark of bytesInUse
+  size_t bytesPooled=0;     // bytes owned by the workspace
+};
+
+namespace internal {
+
+/* Pool of scratch buffers binned by power-of-two size class. Buffers are
+   recycled when their scratchMemory handles are destroyed */
+class workspace_t {
+ public:
+  memoryStats_t stats;
+
+  occa::memory Reserve(device_t& device, const size_t bytes, const bool pinned);
+  void Release(occa::memory block, const bool pinned);
+
+  /*Free all buffers not currently in use*/
+  void Trim();
+
+ private:
+  static constexpr int Nclasses = 64;
+  std::vector<occa::memory> freeDevice[Nclasses];
+  std::vector<occa::memory> freePinned[Nclasses];
+
+  static int SizeClass(const size_t bytes);
+};
+
+} //namespace internal
+
+/* Scratch device buffer from platform_t::reserve. The underlying block is
+   returned to the workspace when the last copy of this handle goes out of
+   scope, so keep the handle (not a plain deviceMemory copy) alive while the
+   buffer is in use */
+template<typename T>
+class scratchMemory: public deviceMemory<T> {
+ private:
+  std::shared_ptr<void> token;
+
+ public:
+  scratchMemory() = default;
+  scratchMemory(std::shared_ptr<internal::workspace_t> workspace,
+                occa::memory block, const size_t count):
+    deviceMemory<T>(block.slice(0, count*sizeof(T))),
+    token(nullptr, [workspace, block](void*) { workspace->Release(block, false); }) {}
+};
+
+/* Scratch pinned host buffer from platform_t::hostReserve */
+template<typename T>
+class scratchPinnedMemory: public pinnedMemory<T> {
+ private:
+  std::shared_ptr<void> token;
+
+ public:
+  scratchPinnedMemory() = default;
+  scratchPinnedMemory(std::shared_ptr<internal::workspace_t> workspace,
+                      occa::memory block, const size_t count):
+    pinnedMemory<T>(block.slice(0, count*sizeof(T))),
+    token(nullptr, [workspace, block](void*) { workspace->Release(block, true); }) {}
+};
+
+} //namespace libp
+
+#endif
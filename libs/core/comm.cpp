@@ -87,6 +87,47 @@ comm_t comm_t::Split(const int color, const int key) const {
   return c;
 }
 
+/*Sub-communicator of the ranks which can create shared memory windows*/
+comm_t comm_t::SplitShared(const int key) const {
+  comm_t c;
+  /*Make a new comm shared_ptr, which will call MPI_Comm_free when destroyed*/
+  c.comm_ptr = std::shared_ptr<MPI_Comm>(new MPI_Comm,
+                                        [](MPI_Comm *comm) {
+                                          if (*comm != MPI_COMM_NULL)
+                                            MPI_Comm_free(comm);
+                                          delete comm;
+                                        });
+
+  MPI_Comm_split_type(comm(), MPI_COMM_TYPE_SHARED, key,
+                      MPI_INFO_NULL, c.comm_ptr.get());
+  MPI_Comm_rank(c.comm(), &(c._rank));
+  MPI_Comm_size(c.comm(), &(c._size));
+  return c;
+}
+
+/*Distributed graph communicator with fixed neighbor lists*/
+comm_t comm_t::DistGraphCreateAdjacent(const memory<int> sources,
+                                       const memory<int> destinations) const {
+  comm_t c;
+  /*Make a new comm shared_ptr, which will call MPI_Comm_free when destroyed*/
+  c.comm_ptr = std::shared_ptr<MPI_Comm>(new MPI_Comm,
+                                        [](MPI_Comm *comm) {
+                                          if (*comm != MPI_COMM_NULL)
+                                            MPI_Comm_free(comm);
+                                          delete comm;
+                                        });
+
+  const int indegree  = static_cast<int>(sources.length());
+  const int outdegree = static_cast<int>(destinations.length());
+  MPI_Dist_graph_create_adjacent(comm(),
+                                 indegree,  sources.ptr(),      MPI_UNWEIGHTED,
+                                 outdegree, destinations.ptr(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, 0, c.comm_ptr.get());
+  MPI_Comm_rank(c.comm(), &(c._rank));
+  MPI_Comm_size(c.comm(), &(c._size));
+  return c;
+}
+
 /*Rank and size getters*/
 const int comm_t::rank() const {
   return _rank;
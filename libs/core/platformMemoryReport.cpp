@@ -0,0 +1,56 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "platform.hpp"
+
+namespace libp {
+
+void platform_t::MemoryReport(const std::string name, const memoryStats_t& start) {
+
+  const memoryStats_t& stats = memoryStats();
+
+  memory<long long int> counts(6);
+  counts[0] = static_cast<long long int>(stats.Nmallocs - start.Nmallocs);
+  counts[1] = static_cast<long long int>(stats.mallocBytes - start.mallocBytes);
+  counts[2] = static_cast<long long int>(stats.Nreserves - start.Nreserves);
+  counts[3] = static_cast<long long int>(stats.NreserveMisses - start.NreserveMisses);
+  counts[4] = static_cast<long long int>(stats.peakBytesInUse);
+  counts[5] = static_cast<long long int>(stats.bytesPooled);
+
+  //report the worst rank
+  comm.Allreduce(counts, Comm::Max);
+
+  if (comm.rank()==0) {
+    printf("%s memory: %lld mallocs (%.2f MB), %lld scratch reserves (%lld new), "
+           "peak scratch %.2f MB, workspace %.2f MB\n",
+           name.c_str(),
+           counts[0], counts[1]/1.0e6,
+           counts[2], counts[3],
+           counts[4]/1.0e6, counts[5]/1.0e6);
+  }
+}
+
+} //namespace libp
@@ -53,6 +53,11 @@ platformSettings_t::platformSettings_t(comm_t _comm):
   newSetting("CACHE DIR",
              LIBP_DIR "/.occa",
              "Path for OCCA to place kernel cache");
+
+  newSetting("MEMORY REPORT",
+             "FALSE",
+             "Report device allocations made during time stepping",
+             {"TRUE", "FALSE"});
 }
 
 void platformSettings_t::report() {
@@ -70,6 +75,8 @@ void platformSettings_t::report() {
         ||compareSetting("THREAD MODEL","HIP")
         ||compareSetting("THREAD MODEL","OpenCL") ))
       reportSetting("DEVICE NUMBER");
+
+    reportSetting("MEMORY REPORT");
   }
 }
 
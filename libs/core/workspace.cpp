@@ -0,0 +1,92 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "workspace.hpp"
+
+namespace libp {
+
+namespace internal {
+
+/*smallest size class is 256 bytes*/
+int workspace_t::SizeClass(const size_t bytes) {
+  int c = 8;
+  while ((size_t(1) << c) < bytes) c++;
+  return c;
+}
+
+occa::memory workspace_t::Reserve(device_t& device, const size_t bytes, const bool pinned) {
+
+  const int c = SizeClass(bytes);
+  const size_t blockBytes = size_t(1) << c;
+
+  std::vector<occa::memory>& freeList = pinned ? freePinned[c] : freeDevice[c];
+
+  occa::memory block;
+  if (freeList.size()) {
+    block = freeList.back();
+    freeList.pop_back();
+  } else {
+    if (pinned) {
+      properties_t hostProp("host", true);
+      block = device.malloc(blockBytes, occa::dtype::byte, nullptr, hostProp);
+    } else {
+      block = device.malloc(blockBytes, occa::dtype::byte);
+    }
+    stats.NreserveMisses++;
+    stats.bytesPooled += blockBytes;
+  }
+
+  stats.Nreserves++;
+  stats.bytesInUse += blockBytes;
+  stats.peakBytesInUse = std::max(stats.peakBytesInUse, stats.bytesInUse);
+
+  return block;
+}
+
+void workspace_t::Release(occa::memory block, const bool pinned) {
+  const int c = SizeClass(block.size());
+
+  stats.bytesInUse -= block.size();
+
+  if (pinned) {
+    freePinned[c].push_back(block);
+  } else {
+    freeDevice[c].push_back(block);
+  }
+}
+
+void workspace_t::Trim() {
+  for (int c=0;c<Nclasses;++c) {
+    for (auto& block : freeDevice[c]) stats.bytesPooled -= block.size();
+    for (auto& block : freePinned[c]) stats.bytesPooled -= block.size();
+    freeDevice[c].clear();
+    freePinned[c].clear();
+  }
+}
+
+} //namespace internal
+
+} //namespace libp
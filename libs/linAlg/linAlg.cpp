@@ -186,6 +186,54 @@ dfloat linAlg_t::innerProd(const dlong N, deviceMemory<dfloat> o_x, deviceMemory
   return globaldot;
 }
 
+// dots[i] = o_X_i.o_y
+void linAlg_t::multiInnerProd(const dlong N, const int Nvec, const dlong Nstride,
+                              deviceMemory<dfloat> o_X, deviceMemory<dfloat> o_y,
+                              memory<dfloat> dots, comm_t comm) {
+  if (Nvec<=0) return;
+
+  int Nblock = (N+blocksize-1)/blocksize;
+  Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
+
+  //partial sums, followed by the Nvec results
+  MultiScratch(Nvec*(blocksize+1));
+  deviceMemory<dfloat> o_result = o_multiScratch + Nvec*blocksize;
+
+  if (Nblock>0) {
+    multiInnerProdKernel1(Nblock, N, Nvec, Nstride, o_X, o_y, o_multiScratch);
+    multiInnerProdKernel2(Nblock, Nvec, o_multiScratch, o_result);
+
+    h_multiScratch.copyFrom(o_result, Nvec, 0, properties_t("async", true));
+    platform->finish();
+
+    for (int i=0;i<Nvec;++i) dots[i] = h_multiScratch[i];
+  } else {
+    for (int i=0;i<Nvec;++i) dots[i] = 0.0;
+  }
+
+  comm.Allreduce(dots, Comm::Sum, Nvec);
+}
+
+// o_y[n] = beta*o_y[n] + \sum_i alpha[i]*o_X_i[n]
+void linAlg_t::multiAxpy(const dlong N, const int Nvec, const dlong Nstride,
+                         const memory<dfloat> alpha, deviceMemory<dfloat> o_X,
+                         const dfloat beta, deviceMemory<dfloat> o_y) {
+  MultiScratch(std::max(Nvec, 1));
+  if (Nvec>0) {
+    for (int i=0;i<Nvec;++i) h_multiScratch[i] = alpha[i];
+    o_multiScratch.copyFrom(h_multiScratch, Nvec);
+  }
+
+  multiAxpyKernel(N, Nvec, Nstride, o_multiScratch, o_X, beta, o_y);
+}
+
+void linAlg_t::MultiScratch(const size_t Nentries) {
+  if (o_multiScratch.length() < Nentries) {
+    h_multiScratch = platform->hostMalloc<dfloat>(Nentries);
+    o_multiScratch = platform->malloc<dfloat>(Nentries);
+  }
+}
+
 // o_w.o_x.o_y
 dfloat linAlg_t::weightedInnerProd(const dlong N, deviceMemory<dfloat> o_w,
                                    deviceMemory<dfloat> o_x, deviceMemory<dfloat> o_y,
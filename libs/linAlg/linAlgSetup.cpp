@@ -195,6 +195,23 @@ void linAlg_t::InitKernels(std::vector<std::string> kernels) {
                                         "weightedInnerProd2",
                                         kernelInfo);
       }
+    } else if (name=="multiInnerProd") {
+      if (multiInnerProdKernel1.isInitialized()==false) {
+        multiInnerProdKernel1 = platform->buildKernel(LINALG_DIR "/okl/"
+                                        "linAlgMultiInnerProd.okl",
+                                        "multiInnerProd1",
+                                        kernelInfo);
+        multiInnerProdKernel2 = platform->buildKernel(LINALG_DIR "/okl/"
+                                        "linAlgMultiInnerProd.okl",
+                                        "multiInnerProd2",
+                                        kernelInfo);
+      }
+    } else if (name=="multiAxpy") {
+      if (multiAxpyKernel.isInitialized()==false)
+        multiAxpyKernel = platform->buildKernel(LINALG_DIR "/okl/"
+                                        "linAlgMultiAXPY.okl",
+                                        "multiAxpy",
+                                        kernelInfo);
     } else {
       LIBP_FORCE_ABORT("Requested linAlg routine \"" << name << "\" not found");
     }
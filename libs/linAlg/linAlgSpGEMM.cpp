@@ -0,0 +1,222 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "linAlg.hpp"
+
+namespace libp {
+
+//Rows of C are accumulated in open addressing hash tables, one per thread,
+// sized to twice the upper bound on the row length. The symbolic pass only
+// counts distinct columns, the numeric pass sums the products and writes
+// the row out in column order.
+
+static constexpr hlong emptySlot = -1;
+
+//number of products A(i,:)*B contributing to row i of C
+static inline
+dlong RowBound(const dlong i,
+               const memory<dlong>& AdiagRowStarts, const memory<dlong>& AdiagCols,
+               const memory<dlong>& AoffdRowStarts, const memory<dlong>& AoffdCols,
+               const memory<dlong>& BrowStarts) {
+  dlong bound = 0;
+  for (dlong j=AdiagRowStarts[i];j<AdiagRowStarts[i+1];j++) {
+    const dlong col = AdiagCols[j];
+    bound += BrowStarts[col+1]-BrowStarts[col];
+  }
+  for (dlong j=AoffdRowStarts[i];j<AoffdRowStarts[i+1];j++) {
+    const dlong col = AoffdCols[j];
+    bound += BrowStarts[col+1]-BrowStarts[col];
+  }
+  return bound;
+}
+
+//smallest power of two holding 2*bound entries
+static inline
+size_t TableSize(const dlong bound) {
+  size_t size = 1;
+  while (size < 2*static_cast<size_t>(bound)) size *= 2;
+  return size;
+}
+
+//find the slot holding col, claiming an empty one if col is new
+static inline
+size_t HashSlot(hlong* keys, const size_t mask, const hlong col, bool& isNew) {
+  size_t slot = (static_cast<size_t>(col)*2654435761u) & mask;
+  while (keys[slot]!=emptySlot && keys[slot]!=col) slot = (slot+1) & mask;
+  isNew = (keys[slot]==emptySlot);
+  keys[slot] = col;
+  return slot;
+}
+
+static dlong MaxRowBound(const dlong Nrows,
+                         const memory<dlong>& AdiagRowStarts, const memory<dlong>& AdiagCols,
+                         const memory<dlong>& AoffdRowStarts, const memory<dlong>& AoffdCols,
+                         const memory<dlong>& BrowStarts) {
+  dlong maxBound = 0;
+  #pragma omp parallel for reduction(max:maxBound)
+  for (dlong i=0;i<Nrows;i++) {
+    const dlong bound = RowBound(i, AdiagRowStarts, AdiagCols,
+                                    AoffdRowStarts, AoffdCols, BrowStarts);
+    maxBound = std::max(maxBound, bound);
+  }
+  return maxBound;
+}
+
+void linAlg_t::SpGEMMSymbolic(const dlong Nrows,
+                              const memory<dlong> AdiagRowStarts, const memory<dlong> AdiagCols,
+                              const memory<dlong> AoffdRowStarts, const memory<dlong> AoffdCols,
+                              const memory<dlong> BrowStarts, const memory<hlong> Bcols,
+                              memory<dlong> CrowStarts) {
+
+  const dlong maxBound = MaxRowBound(Nrows, AdiagRowStarts, AdiagCols,
+                                     AoffdRowStarts, AoffdCols, BrowStarts);
+
+  CrowStarts[0] = 0;
+
+  #pragma omp parallel
+  {
+    memory<hlong> table(TableSize(maxBound), emptySlot);
+    hlong* keys = table.ptr();
+
+    #pragma omp for schedule(dynamic, 64)
+    for (dlong i=0;i<Nrows;i++) {
+      const dlong bound = RowBound(i, AdiagRowStarts, AdiagCols,
+                                      AoffdRowStarts, AoffdCols, BrowStarts);
+      const size_t size = TableSize(bound);
+      const size_t mask = size-1;
+
+      dlong cnt = 0;
+      bool isNew;
+      for (dlong j=AdiagRowStarts[i];j<AdiagRowStarts[i+1];j++) {
+        const dlong row = AdiagCols[j];
+        for (dlong jj=BrowStarts[row];jj<BrowStarts[row+1];jj++) {
+          HashSlot(keys, mask, Bcols[jj], isNew);
+          if (isNew) cnt++;
+        }
+      }
+      for (dlong j=AoffdRowStarts[i];j<AoffdRowStarts[i+1];j++) {
+        const dlong row = AoffdCols[j];
+        for (dlong jj=BrowStarts[row];jj<BrowStarts[row+1];jj++) {
+          HashSlot(keys, mask, Bcols[jj], isNew);
+          if (isNew) cnt++;
+        }
+      }
+      CrowStarts[i+1] = cnt;
+
+      //clear the part of the table this row used
+      for (size_t n=0;n<size;n++) keys[n] = emptySlot;
+    }
+  }
+
+  //cumulative sum
+  for (dlong i=0;i<Nrows;i++) CrowStarts[i+1] += CrowStarts[i];
+}
+
+void linAlg_t::SpGEMMNumeric(const dlong Nrows,
+                             const memory<dlong> AdiagRowStarts, const memory<dlong> AdiagCols,
+                             const memory<pfloat> AdiagVals,
+                             const memory<dlong> AoffdRowStarts, const memory<dlong> AoffdCols,
+                             const memory<pfloat> AoffdVals,
+                             const memory<dlong> BrowStarts, const memory<hlong> Bcols,
+                             const memory<pfloat> Bvals,
+                             const memory<dlong> CrowStarts,
+                             memory<hlong> Ccols, memory<pfloat> Cvals) {
+
+  const dlong maxBound = MaxRowBound(Nrows, AdiagRowStarts, AdiagCols,
+                                     AoffdRowStarts, AoffdCols, BrowStarts);
+
+  bool mismatch = false;
+
+  #pragma omp parallel
+  {
+    const size_t maxSize = TableSize(maxBound);
+    memory<hlong> table(maxSize, emptySlot);
+    memory<dfloat> tableVals(maxSize);
+    hlong*  keys = table.ptr();
+    dfloat* vals = tableVals.ptr();
+
+    //row buffer for sorting by column
+    std::vector<std::pair<hlong, dfloat>> row;
+
+    #pragma omp for schedule(dynamic, 64) reduction(||:mismatch)
+    for (dlong i=0;i<Nrows;i++) {
+      const dlong bound = RowBound(i, AdiagRowStarts, AdiagCols,
+                                      AoffdRowStarts, AoffdCols, BrowStarts);
+      const size_t size = TableSize(bound);
+      const size_t mask = size-1;
+
+      bool isNew;
+      for (dlong j=AdiagRowStarts[i];j<AdiagRowStarts[i+1];j++) {
+        const dlong Brow = AdiagCols[j];
+        const dfloat Aval = AdiagVals[j];
+        for (dlong jj=BrowStarts[Brow];jj<BrowStarts[Brow+1];jj++) {
+          const size_t slot = HashSlot(keys, mask, Bcols[jj], isNew);
+          if (isNew) vals[slot] = 0.0;
+          vals[slot] += Aval*Bvals[jj];
+        }
+      }
+      for (dlong j=AoffdRowStarts[i];j<AoffdRowStarts[i+1];j++) {
+        const dlong Brow = AoffdCols[j];
+        const dfloat Aval = AoffdVals[j];
+        for (dlong jj=BrowStarts[Brow];jj<BrowStarts[Brow+1];jj++) {
+          const size_t slot = HashSlot(keys, mask, Bcols[jj], isNew);
+          if (isNew) vals[slot] = 0.0;
+          vals[slot] += Aval*Bvals[jj];
+        }
+      }
+
+      //harvest the row and clear the table
+      row.clear();
+      for (size_t n=0;n<size;n++) {
+        if (keys[n]!=emptySlot) {
+          row.push_back({keys[n], vals[n]});
+          keys[n] = emptySlot;
+        }
+      }
+
+      if (static_cast<dlong>(row.size()) != CrowStarts[i+1]-CrowStarts[i]) {
+        mismatch = true;
+        continue;
+      }
+
+      std::sort(row.begin(), row.end(),
+                [](const std::pair<hlong, dfloat>& a, const std::pair<hlong, dfloat>& b) {
+                  return a.first < b.first;
+                });
+
+      const dlong start = CrowStarts[i];
+      for (size_t n=0;n<row.size();n++) {
+        Ccols[start+n] = row[n].first;
+        Cvals[start+n] = static_cast<pfloat>(row[n].second);
+      }
+    }
+  }
+
+  LIBP_ABORT("SpGEMMNumeric called with a row pattern that does not match SpGEMMSymbolic",
+             mismatch);
+}
+
+} //namespace libp
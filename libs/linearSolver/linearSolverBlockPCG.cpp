@@ -0,0 +1,227 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "linearSolver.hpp"
+
+namespace libp {
+
+namespace LinearSolver {
+
+#define BLOCKPCG_BLOCKSIZE 512
+
+blockpcg::blockpcg(dlong _N, dlong _Nhalo, int _Nrhs,
+                   platform_t& _platform, settings_t& _settings, comm_t _comm):
+  linearSolverBase_t(_Nrhs*(_N+_Nhalo), 0, _platform, _settings, _comm),
+  Nrhs(_Nrhs), Nlocal(_N), Nstride(_N+_Nhalo) {
+
+  platform.linAlg().InitKernels({"axpy"});
+
+  LIBP_ABORT("Flexible PCG not supported by block PCG",
+             settings.compareSetting("LINEAR SOLVER", "FPCG"));
+
+  dlong Ntotal = Nrhs*Nstride;
+
+  /*aux variables */
+  memory<dfloat> dummy(Ntotal, 0.0); //need this to avoid uninitialized memory warnings
+  o_p  = platform.malloc<dfloat>(dummy);
+  o_z  = platform.malloc<dfloat>(dummy);
+  o_Ax = platform.malloc<dfloat>(dummy);
+  o_Ap = platform.malloc<dfloat>(dummy);
+
+  //pinned tmp buffer for reductions
+  h_dots = platform.hostMalloc<dfloat>(Nrhs*BLOCKPCG_BLOCKSIZE);
+  o_dots = platform.malloc<dfloat>(Nrhs*BLOCKPCG_BLOCKSIZE);
+
+  //per-rhs alpha/beta
+  o_coefs = platform.malloc<dfloat>(Nrhs);
+
+  /* build kernels */
+  properties_t kernelInfo = platform.props(); //copy base properties
+
+  //add defines
+  kernelInfo["defines/" "p_blockSize"] = (int)BLOCKPCG_BLOCKSIZE;
+
+  innerProdKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdateBlockPCG.okl",
+                                         "blockInnerProdPCG", kernelInfo);
+  updatePKernel   = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdateBlockPCG.okl",
+                                         "blockUpdateP", kernelInfo);
+  updatePCGKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdateBlockPCG.okl",
+                                         "blockUpdatePCG", kernelInfo);
+}
+
+int blockpcg::Solve(operator_t& linearOperator, operator_t& precon,
+                    deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r,
+                    const dfloat tol, const int MAXIT, const int verbose) {
+
+  int rank = comm.rank();
+  linAlg_t &linAlg = platform.linAlg();
+
+  // per-rhs scalars
+  memory<dfloat> rdotz1(Nrhs, 0.0);
+  memory<dfloat> rdotz2(Nrhs, 0.0);
+  memory<dfloat> alpha(Nrhs, 0.0);
+  memory<dfloat> beta(Nrhs, 0.0);
+  memory<dfloat> pAp(Nrhs, 0.0);
+  memory<dfloat> rdotr0(Nrhs, 0.0);
+  memory<dfloat> TOL(Nrhs, 0.0);
+  memory<int> active(Nrhs, 1);
+
+  // Comput norm of RHS (for stopping tolerance).
+  if (settings.compareSetting("LINEAR SOLVER STOPPING CRITERION", "ABS/REL-RHS-2NORM")) {
+    memory<dfloat> normb(Nrhs);
+    InnerProd(o_r, o_r, normb);
+    for (int f=0;f<Nrhs;++f) TOL[f] = std::max(tol*tol*normb[f], tol*tol);
+  }
+
+  // compute A*x
+  linearOperator.Operator(o_x, o_Ax);
+
+  // subtract r = r - A*x
+  linAlg.axpy(N, -1.f, o_Ax, 1.f, o_r);
+
+  InnerProd(o_r, o_r, rdotr0);
+
+  if (settings.compareSetting("LINEAR SOLVER STOPPING CRITERION", "ABS/REL-INITRESID")) {
+    for (int f=0;f<Nrhs;++f) TOL[f] = std::max(tol*tol*rdotr0[f],tol*tol);
+  }
+
+  if (verbose&&(rank==0)) {
+    for (int f=0;f<Nrhs;++f)
+      printf("BPCG: rhs %d, initial res norm %12.12f \n", f, sqrt(rdotr0[f]));
+  }
+
+  int iter;
+  for(iter=0;iter<MAXIT;++iter){
+
+    // Exit once every rhs has reached tolerance, taking at least one step.
+    int Nactive = 0;
+    for (int f=0;f<Nrhs;++f) {
+      active[f] = !(((iter == 0) && (rdotr0[f] == 0.0)) ||
+                    ((iter > 0) && (rdotr0[f] <= TOL[f])));
+      Nactive += active[f];
+    }
+    if (Nactive==0) break;
+
+    // z = Precon^{-1} r
+    precon.Operator(o_r, o_z);
+
+    // r.z
+    rdotz2.copyFrom(rdotz1);
+    InnerProd(o_r, o_z, rdotz1);
+
+    for (int f=0;f<Nrhs;++f) {
+      beta[f] = (iter==0 || rdotz2[f]==0.0) ? 0.0 : rdotz1[f]/rdotz2[f];
+    }
+
+    // p = z + beta*p
+    UpdateP(beta);
+
+    // A*p
+    linearOperator.Operator(o_p, o_Ap);
+
+    // p.Ap
+    InnerProd(o_p, o_Ap, pAp);
+
+    // converged systems are frozen
+    for (int f=0;f<Nrhs;++f) {
+      alpha[f] = (active[f] && pAp[f]!=0.0) ? rdotz1[f]/pAp[f] : 0.0;
+    }
+
+    //  x <= x + alpha*p
+    //  r <= r - alpha*A*p
+    //  dot(r,r)
+    UpdatePCG(alpha, o_x, o_r, rdotr0);
+
+    if (verbose&&(rank==0)) {
+      for (int f=0;f<Nrhs;++f) {
+        if(rdotr0[f]<0)
+          printf("WARNING BPCG: rhs %d, rdotr = %17.15lf\n", f, rdotr0[f]);
+
+        printf("BPCG: it %d, rhs %d, r norm %12.12le, alpha = %le \n", iter+1, f, sqrt(rdotr0[f]), alpha[f]);
+      }
+    }
+  }
+
+  return iter;
+}
+
+void blockpcg::InnerProd(deviceMemory<dfloat>& o_a, deviceMemory<dfloat>& o_b,
+                         memory<dfloat> dots){
+
+  int Nblocks = (Nlocal+BLOCKPCG_BLOCKSIZE-1)/BLOCKPCG_BLOCKSIZE;
+  Nblocks = std::min(Nblocks, BLOCKPCG_BLOCKSIZE); //limit to BLOCKPCG_BLOCKSIZE entries
+  Nblocks = std::max(Nblocks, 1);
+
+  innerProdKernel(Nlocal, Nstride, Nrhs, Nblocks, o_a, o_b, o_dots);
+
+  h_dots.copyFrom(o_dots, Nrhs*Nblocks);
+
+  for(int f=0;f<Nrhs;++f) {
+    dots[f] = 0.0;
+    for(int n=0;n<Nblocks;++n)
+      dots[f] += h_dots[f*Nblocks+n];
+  }
+
+  //one reduction for all right-hand sides
+  comm.Allreduce(dots);
+}
+
+void blockpcg::UpdateP(const memory<dfloat> beta){
+
+  o_coefs.copyFrom(beta, Nrhs);
+
+  if (Nlocal)
+    updatePKernel(Nlocal, Nstride, Nrhs, o_coefs, o_z, o_p);
+}
+
+void blockpcg::UpdatePCG(const memory<dfloat> alpha, deviceMemory<dfloat>& o_x,
+                         deviceMemory<dfloat>& o_r, memory<dfloat> rdotr){
+
+  // x <= x + alpha*p
+  // r <= r - alpha*A*p
+  // dot(r,r)
+  int Nblocks = (Nlocal+BLOCKPCG_BLOCKSIZE-1)/BLOCKPCG_BLOCKSIZE;
+  Nblocks = std::min(Nblocks, BLOCKPCG_BLOCKSIZE); //limit to BLOCKPCG_BLOCKSIZE entries
+  Nblocks = std::max(Nblocks, 1);
+
+  o_coefs.copyFrom(alpha, Nrhs);
+
+  updatePCGKernel(Nlocal, Nstride, Nrhs, Nblocks, o_coefs, o_p, o_Ap, o_x, o_r, o_dots);
+
+  h_dots.copyFrom(o_dots, Nrhs*Nblocks);
+
+  for(int f=0;f<Nrhs;++f) {
+    rdotr[f] = 0.0;
+    for(int n=0;n<Nblocks;++n)
+      rdotr[f] += h_dots[f*Nblocks+n];
+  }
+
+  comm.Allreduce(rdotr);
+}
+
+} //namespace LinearSolver
+
+} //namespace libp
@@ -50,8 +50,8 @@ pcg::pcg(dlong _N, dlong _Nhalo,
   o_Ap = platform.malloc<dfloat>(dummy);
 
   //pinned tmp buffer for reductions
-  rdotr = platform.hostMalloc<dfloat>(PCG_BLOCKSIZE);
-  o_rdotr = platform.malloc<dfloat>(PCG_BLOCKSIZE);
+  rdotr = platform.hostMalloc<dfloat>(3*PCG_BLOCKSIZE);
+  o_rdotr = platform.malloc<dfloat>(3*PCG_BLOCKSIZE);
 
   /* build kernels */
   properties_t kernelInfo = platform.props(); //copy base properties
@@ -62,6 +62,14 @@ pcg::pcg(dlong _N, dlong _Nhalo,
   // combined PCG update and r.r kernel
   updatePCGKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdatePCG.okl",
                                 "updatePCG", kernelInfo);
+
+  // combined r.z and z.Ap kernel
+  dotsPCGKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdatePCG.okl",
+                                "dotsPCG", kernelInfo);
+
+  // PCG update fused with a diagonal preconditioner and its reductions
+  updateDiagonalPCGKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdatePCG.okl",
+                                "updateDiagonalPCG", kernelInfo);
 }
 
 int pcg::Solve(operator_t& linearOperator, operator_t& precon,
@@ -74,10 +82,16 @@ int pcg::Solve(operator_t& linearOperator, operator_t& precon,
   // register scalars
   dfloat rdotz1 = 0.0;
   dfloat rdotz2 = 0.0;
+  dfloat rdotz = 0.0, zdotAp = 0.0;
   dfloat alpha = 0.0, beta = 0.0, pAp = 0.0;
   dfloat rdotr0 = 0.0;
   dfloat TOL = 0.0;
 
+  // A pointwise preconditioner is applied inside the residual update, so each
+  // iteration after the first streams the vectors in three fused passes
+  deviceMemory<dfloat> o_invD;
+  const bool diagonalPrecon = precon.Diagonal(o_invD);
+
   // Comput norm of RHS (for stopping tolerance).
   if (settings.compareSetting("LINEAR SOLVER STOPPING CRITERION", "ABS/REL-RHS-2NORM")) {
     dfloat normb = linAlg.norm2(N, o_r, comm);
@@ -109,15 +123,18 @@ int pcg::Solve(operator_t& linearOperator, operator_t& precon,
       break;
     }
 
-    // z = Precon^{-1} r
-    precon.Operator(o_r, o_z);
+    if (iter==0 || !diagonalPrecon) {
+      // z = Precon^{-1} r
+      precon.Operator(o_r, o_z);
+
+      // r.z and z.Ap
+      DotsPCG(o_r, rdotz, zdotAp);
+    }
 
-    // r.z
     rdotz2 = rdotz1;
-    rdotz1 = linAlg.innerProd(N, o_r, o_z, comm);
+    rdotz1 = rdotz;
 
     if(flexible){
-      dfloat zdotAp = linAlg.innerProd(N, o_z, o_Ap, comm);
       beta = (iter==0) ? 0.0 : -alpha*zdotAp/rdotz2;
     } else {
       beta = (iter==0) ? 0.0 : rdotz1/rdotz2;
@@ -137,7 +154,12 @@ int pcg::Solve(operator_t& linearOperator, operator_t& precon,
     //  x <= x + alpha*p
     //  r <= r - alpha*A*p
     //  dot(r,r)
-    rdotr0 = UpdatePCG(alpha, o_x, o_r);
+    if (diagonalPrecon) {
+      //  z <= invD.*r, dot(r,z), dot(z,Ap)
+      rdotr0 = UpdateDiagonalPCG(alpha, o_invD, o_x, o_r, rdotz, zdotAp);
+    } else {
+      rdotr0 = UpdatePCG(alpha, o_x, o_r);
+    }
 
     if (verbose&&(rank==0)) {
       if(rdotr0<0)
@@ -170,6 +192,70 @@ dfloat pcg::UpdatePCG(const dfloat alpha, deviceMemory<dfloat>& o_x, deviceMemor
   return rdotr1;
 }
 
+void pcg::DotsPCG(deviceMemory<dfloat>& o_r, dfloat& rdotz, dfloat& zdotAp){
+
+  // dot(r,z)
+  // dot(z,Ap)
+  int Nblocks = (N+PCG_BLOCKSIZE-1)/PCG_BLOCKSIZE;
+  Nblocks = std::min(Nblocks, PCG_BLOCKSIZE); //limit to PCG_BLOCKSIZE entries
+
+  dotsPCGKernel(N, Nblocks, flexible, o_r, o_z, o_Ap, o_rdotr);
+
+  if (Nblocks>0) {
+    rdotr.copyFrom(o_rdotr, 2*Nblocks);
+  } else {
+    rdotr[0] = 0.0;
+    rdotr[1] = 0.0;
+  }
+
+  for(int n=1;n<Nblocks;++n) {
+    rdotr[0] += rdotr[0+2*n];
+    rdotr[1] += rdotr[1+2*n];
+  }
+
+  comm.Allreduce(rdotr, Comm::Sum, 2);
+
+  rdotz = rdotr[0];
+  zdotAp = rdotr[1];
+}
+
+dfloat pcg::UpdateDiagonalPCG(const dfloat alpha, deviceMemory<dfloat>& o_invD,
+                              deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r,
+                              dfloat& rdotz, dfloat& zdotAp){
+
+  // x <= x + alpha*p
+  // r <= r - alpha*A*p
+  // z <= invD.*r
+  // dot(r,r)
+  // dot(r,z)
+  // dot(z,Ap)
+  int Nblocks = (N+PCG_BLOCKSIZE-1)/PCG_BLOCKSIZE;
+  Nblocks = std::min(Nblocks, PCG_BLOCKSIZE); //limit to PCG_BLOCKSIZE entries
+
+  updateDiagonalPCGKernel(N, Nblocks, flexible, o_invD, o_p, o_Ap, alpha,
+                          o_x, o_r, o_z, o_rdotr);
+
+  if (Nblocks>0) {
+    rdotr.copyFrom(o_rdotr, 3*Nblocks);
+  } else {
+    rdotr[0] = 0.0;
+    rdotr[1] = 0.0;
+    rdotr[2] = 0.0;
+  }
+
+  for(int n=1;n<Nblocks;++n) {
+    rdotr[0] += rdotr[0+3*n];
+    rdotr[1] += rdotr[1+3*n];
+    rdotr[2] += rdotr[2+3*n];
+  }
+
+  comm.Allreduce(rdotr, Comm::Sum, 3);
+
+  rdotz = rdotr[1];
+  zdotAp = rdotr[2];
+  return rdotr[0];
+}
+
 } //namespace LinearSolver
 
 } //namespace libp
@@ -37,21 +37,20 @@ pgmres::pgmres(dlong _N, dlong _Nhalo,
   linearSolverBase_t(_N, _Nhalo, _platform, _settings, _comm) {
 
   // Make sure LinAlg has the necessary kernels
-  platform.linAlg().InitKernels({"axpy", "zaxpy",
-                               "innerProd", "norm2"});
+  platform.linAlg().InitKernels({"axpy", "zaxpy", "norm2",
+                                 "multiInnerProd", "multiAxpy"});
 
-  dlong Ntotal = N + Nhalo;
+  Ntotal = N + Nhalo;
 
   //Number of iterations between restarts
   //TODO make this modifyable via settings
   restart=PGMRES_RESTART;
 
-  memory<dfloat> dummy(Ntotal, 0.0); //need this to avoid uninitialized memory warnings
+  memory<dfloat> dummy((restart+1)*Ntotal, 0.0); //need this to avoid uninitialized memory warnings
 
-  o_V.malloc(restart);
-  for(int i=0; i<restart; ++i){
-    o_V[i] = platform.malloc<dfloat>(dummy);
-  }
+  //Krylov basis, stored as one contiguous block with stride Ntotal. The
+  // extra column holds the next basis vector while it is orthogonalized.
+  o_V = platform.malloc<dfloat>(dummy);
 
   H .malloc((restart+1)*(restart+1), 0.0);
   sn.malloc(restart);
@@ -59,10 +58,14 @@ pgmres::pgmres(dlong _N, dlong _Nhalo,
   s.malloc(restart+1);
   y.malloc(restart);
 
+  proj1.malloc(restart+1);
+  proj2.malloc(restart+1);
+  alpha.malloc(restart+1);
+
   /*aux variables */
-  o_Ax = platform.malloc<dfloat>(dummy);
-  o_z  = platform.malloc<dfloat>(dummy);
-  o_r  = platform.malloc<dfloat>(dummy);
+  o_Ax = platform.malloc<dfloat>(Ntotal, dummy);
+  o_z  = platform.malloc<dfloat>(Ntotal, dummy);
+  o_r  = platform.malloc<dfloat>(Ntotal, dummy);
 }
 
 int pgmres::Solve(operator_t& linearOperator, operator_t& precon,
@@ -100,32 +103,47 @@ int pgmres::Solve(operator_t& linearOperator, operator_t& precon,
     s[0] = nr;
 
     // V(:,0) = r/nr
-    linAlg.axpy(N, (1./nr), o_r, 0., o_V[0]);
+    linAlg.axpy(N, (1./nr), o_r, 0., o_V);
 
-    //Construct orthonormal basis via Gram-Schmidt
+    //Construct orthonormal basis via classical Gram-Schmidt with
+    // reorthogonalization (CGS2). Each step needs two global reductions,
+    // independent of i.
     for(int i=0;i<restart;++i){
+      deviceMemory<dfloat> o_Vi = o_V + i*Ntotal;
+      deviceMemory<dfloat> o_w  = o_V + (i+1)*Ntotal;
+
       // compute z = A*V(:,i)
-      linearOperator.Operator(o_V[i], o_z);
+      linearOperator.Operator(o_Vi, o_z);
 
-      // r = Precon^{-1} z
-      precon.Operator(o_z, o_r);
+      // w = Precon^{-1} z
+      precon.Operator(o_z, o_w);
 
-      for(int k=0; k<=i; ++k){
-        dfloat hki = linAlg.innerProd(N, o_r, o_V[k], comm);
+      // proj1 = V^T*w, w = w - V*proj1
+      linAlg.multiInnerProd(N, i+1, Ntotal, o_V, o_w, proj1, comm);
+
+      for(int k=0; k<=i; ++k) alpha[k] = -proj1[k];
+      linAlg.multiAxpy(N, i+1, Ntotal, alpha, o_V, 1.0, o_w);
 
-        // r = r - hki*V[k]
-        linAlg.axpy(N, -hki, o_V[k], 1.0, o_r);
+      // proj2 = V^T*w and w.w in the same reduction
+      linAlg.multiInnerProd(N, i+2, Ntotal, o_V, o_w, proj2, comm);
+
+      // ||w - V*proj2||^2 = w.w - proj2.proj2, as the columns of V are orthonormal
+      dfloat ww = proj2[i+1];
+      for(int k=0; k<=i; ++k){
+        ww -= proj2[k]*proj2[k];
 
         // H(k,i) = hki
-        H[k + i*(restart+1)] = hki;
+        H[k + i*(restart+1)] = proj1[k] + proj2[k];
       }
 
-      dfloat nw = linAlg.norm2(N, o_r, comm);
+      dfloat nw = sqrt(std::max(ww, static_cast<dfloat>(0.0)));
       H[i+1 + i*(restart+1)] = nw;
 
-      // V(:,i+1) = r/nw
-      if (i<restart-1)
-        linAlg.axpy(N, (1./nw), o_r, 0., o_V[i+1]);
+      // V(:,i+1) = (w - V*proj2)/nw
+      if (nw>0.0) {
+        for(int k=0; k<=i; ++k) alpha[k] = -proj2[k]/nw;
+        linAlg.multiAxpy(N, i+1, Ntotal, alpha, o_V, 1./nw, o_w);
+      }
 
       //apply Givens rotation
       for(int k=0; k<i; ++k){
@@ -200,10 +218,8 @@ void pgmres::UpdateGMRES(deviceMemory<dfloat>& o_x, const int I){
     y[k] /= H[k + k*(restart+1)];
   }
 
-  //TODO this is really a GEMM, should write it that way
-  for(int j=0; j<I; ++j){
-    platform.linAlg().axpy(N, y[j], o_V[j], 1.0, o_x);
-  }
+  // x += V*y
+  platform.linAlg().multiAxpy(N, I, Ntotal, y, o_V, 1.0, o_x);
 }
 
 } //namespace LinearSolver
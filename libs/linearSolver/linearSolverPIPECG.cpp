@@ -0,0 +1,198 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "linearSolver.hpp"
+
+namespace libp {
+
+namespace LinearSolver {
+
+#define PIPECG_BLOCKSIZE 512
+
+pipecg::pipecg(dlong _N, dlong _Nhalo,
+         platform_t& _platform, settings_t& _settings, comm_t _comm):
+  linearSolverBase_t(_N, _Nhalo, _platform, _settings, _comm) {
+
+  platform.linAlg().InitKernels({"axpy", "norm2"});
+
+  dlong Ntotal = N + Nhalo;
+
+  /*aux variables */
+  memory<dfloat> dummy(Ntotal, 0.0); //need this to avoid uninitialized memory warnings
+  o_u  = platform.malloc<dfloat>(dummy);
+  o_w  = platform.malloc<dfloat>(dummy);
+  o_m  = platform.malloc<dfloat>(dummy);
+  o_n  = platform.malloc<dfloat>(dummy);
+  o_z  = platform.malloc<dfloat>(dummy);
+  o_q  = platform.malloc<dfloat>(dummy);
+  o_s  = platform.malloc<dfloat>(dummy);
+  o_p  = platform.malloc<dfloat>(dummy);
+  o_Ax = platform.malloc<dfloat>(dummy);
+
+  //pinned tmp buffer for reductions
+  dots = platform.hostMalloc<dfloat>(3*PIPECG_BLOCKSIZE);
+  o_dots = platform.malloc<dfloat>(3*PIPECG_BLOCKSIZE);
+
+  /* build kernels */
+  properties_t kernelInfo = platform.props(); //copy base properties
+
+  //add defines
+  kernelInfo["defines/" "p_blockSize"] = (int)PIPECG_BLOCKSIZE;
+
+  // combined PIPECG update and dot products kernel
+  updatePIPECGKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdatePIPECG.okl",
+                                "updatePIPECG", kernelInfo);
+}
+
+int pipecg::Solve(operator_t& linearOperator, operator_t& precon,
+                  deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r,
+                  const dfloat tol, const int MAXIT, const int verbose) {
+
+  int rank = comm.rank();
+  linAlg_t &linAlg = platform.linAlg();
+
+  // register scalars
+  dfloat gamma0 = 0.0, gamma1 = 0.0;
+  dfloat delta = 0.0;
+  dfloat alpha = 0.0, beta = 0.0;
+  dfloat rdotr0 = 0.0;
+  dfloat TOL = 0.0;
+
+  const bool rhsNorm = settings.compareSetting("LINEAR SOLVER STOPPING CRITERION", "ABS/REL-RHS-2NORM");
+  int Nreductions = 0;
+
+  // Comput norm of RHS (for stopping tolerance).
+  if (rhsNorm) {
+    dfloat normb = linAlg.norm2(N, o_r, comm);
+    TOL = std::max(tol*tol*normb*normb, tol*tol);
+    Nreductions++;
+  }
+
+  // compute A*x
+  linearOperator.Operator(o_x, o_Ax);
+
+  // subtract r = r - A*x
+  linAlg.axpy(N, -1.f, o_Ax, 1.f, o_r);
+
+  // u = M*r, w = A*u
+  precon.Operator(o_r, o_u);
+  linearOperator.Operator(o_u, o_w);
+
+  // alpha = beta = 0 leaves x, r, u, and w untouched and
+  // starts the reduction of r.u, w.u, and r.r
+  UpdatePIPECG(alpha, beta, o_x, o_r);
+  Nreductions++;
+
+  int iter;
+  for(iter=0;iter<MAXIT;++iter){
+
+    // m = M*w, n = A*m, overlapped with the reduction
+    precon.Operator(o_w, o_m);
+    linearOperator.Operator(o_m, o_n);
+
+    // block for r.u, w.u, and r.r
+    comm.Wait(request);
+    gamma1 = gamma0;
+    gamma0 = dots[0];
+    delta  = dots[1];
+    rdotr0 = dots[2];
+
+    if (iter==0) {
+      if (!rhsNorm) {
+        TOL = std::max(tol*tol*rdotr0,tol*tol);
+      }
+
+      if (verbose&&(rank==0))
+        printf("PIPECG: initial res norm %12.12f \n", sqrt(rdotr0));
+    } else if (verbose&&(rank==0)) {
+      if(rdotr0<0)
+        printf("WARNING PIPECG: rdotr = %17.15lf\n", rdotr0);
+
+      printf("PIPECG: it %d, r norm %12.12le, alpha = %le \n", iter, sqrt(rdotr0), alpha);
+    }
+
+    // Exit if tolerance is reached, taking at least one step.
+    if (((iter == 0) && (rdotr0 == 0.0)) ||
+        ((iter > 0) && (rdotr0 <= TOL))) {
+      break;
+    }
+
+    if (iter==0) {
+      beta  = 0.0;
+      alpha = gamma0/delta;
+    } else {
+      beta  = gamma0/gamma1;
+      alpha = gamma0/(delta - beta*gamma0/alpha);
+    }
+
+    // z <= n + beta*z, q <= m + beta*q, s <= w + beta*s, p <= u + beta*p
+    // x <= x + alpha*p, r <= r - alpha*s, u <= u - alpha*q, w <= w - alpha*z
+    // r.u, w.u, r.r
+    UpdatePIPECG(alpha, beta, o_x, o_r);
+    Nreductions++;
+  }
+
+  // finish the last reduction if we ran out of iterations
+  if (iter==MAXIT) comm.Wait(request);
+
+  if (verbose&&(rank==0)) {
+    // PCG needs r.z, p.Ap, and r.r each iteration plus the initial r.r
+    const int NreductionsPCG = 3*iter + 1 + (rhsNorm ? 1 : 0);
+    printf("PIPECG: %d global reductions, %d fewer than PCG \n",
+           Nreductions, NreductionsPCG - Nreductions);
+  }
+
+  return iter;
+}
+
+void pipecg::UpdatePIPECG(const dfloat alpha, const dfloat beta,
+                          deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r){
+
+  int Nblocks = (N+PIPECG_BLOCKSIZE-1)/PIPECG_BLOCKSIZE;
+  Nblocks = std::min(Nblocks, PIPECG_BLOCKSIZE); //limit to PIPECG_BLOCKSIZE entries
+
+  updatePIPECGKernel(N, Nblocks, o_m, o_n, alpha, beta,
+                     o_z, o_q, o_s, o_p, o_x, o_r, o_u, o_w, o_dots);
+
+  if (Nblocks>0) {
+    dots.copyFrom(o_dots, 3*Nblocks);
+  } else {
+    dots[0] = 0.0;
+    dots[1] = 0.0;
+    dots[2] = 0.0;
+  }
+
+  for(int b=1;b<Nblocks;++b) {
+    dots[0] += dots[0+3*b];
+    dots[1] += dots[1+3*b];
+    dots[2] += dots[2+3*b];
+  }
+  comm.Iallreduce(dots, Comm::Sum, 3, request);
+}
+
+} //namespace LinearSolver
+
+} //namespace libp
@@ -0,0 +1,380 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "linearSolver.hpp"
+
+namespace libp {
+
+namespace LinearSolver {
+
+#define SSTEPCG_BLOCKSIZE 256
+#define SSTEPCG_MAXS 8
+
+// Cholesky factorization of the symmetrically scaled matrix D*W*D, with
+// D = diag(W)^{-1/2}. The factorization stops at the first column whose
+// pivot falls below tol, and the number of accepted columns is returned.
+static int CholeskyFactor(const int n, const int ld,
+                          const memory<dfloat> W,
+                          memory<dfloat> L, memory<dfloat> D,
+                          const dfloat tol) {
+  for (int j=0;j<n;++j) {
+    if (W[j+j*ld]<=0.0) return j;
+    D[j] = 1.0/sqrt(W[j+j*ld]);
+
+    for (int k=0;k<j;++k) {
+      dfloat Ljk = D[j]*W[k+j*ld]*D[k];
+      for (int m=0;m<k;++m) Ljk -= L[m+j*ld]*L[m+k*ld];
+      L[k+j*ld] = Ljk/L[k+k*ld];
+    }
+
+    dfloat d = 1.0;
+    for (int m=0;m<j;++m) d -= L[m+j*ld]*L[m+j*ld];
+    if (d<=tol) return j;
+    L[j+j*ld] = sqrt(d);
+  }
+  return n;
+}
+
+// Solve W x = b in place with the factors from CholeskyFactor
+static void CholeskySolve(const int n, const int ld,
+                          const memory<dfloat> L, const memory<dfloat> D,
+                          dfloat *b) {
+  for (int i=0;i<n;++i) b[i] *= D[i];
+
+  for (int i=0;i<n;++i) {
+    for (int m=0;m<i;++m) b[i] -= L[m+i*ld]*b[m];
+    b[i] /= L[i+i*ld];
+  }
+  for (int i=n-1;i>=0;--i) {
+    for (int m=i+1;m<n;++m) b[i] -= L[i+m*ld]*b[m];
+    b[i] /= L[i+i*ld];
+  }
+
+  for (int i=0;i<n;++i) b[i] *= D[i];
+}
+
+sstepcg::sstepcg(dlong _N, dlong _Nhalo,
+         platform_t& _platform, settings_t& _settings, comm_t _comm):
+  linearSolverBase_t(_N, _Nhalo, _platform, _settings, _comm) {
+
+  platform.linAlg().InitKernels({"axpy", "norm2"});
+
+  s = 4;
+  if (settings.hasSetting("LINEAR SOLVER S-STEP"))
+    settings.getSetting("LINEAR SOLVER S-STEP", s);
+
+  LIBP_ABORT("SSTEPCG requires 1 <= LINEAR SOLVER S-STEP <= " << SSTEPCG_MAXS,
+             s<1 || s>SSTEPCG_MAXS);
+
+  Nstride = N + Nhalo;
+
+  /*aux variables */
+  memory<dfloat> dummy(s*Nstride, 0.0); //need this to avoid uninitialized memory warnings
+  o_R  = platform.malloc<dfloat>(dummy);
+  o_AR = platform.malloc<dfloat>(dummy);
+  o_P  = platform.malloc<dfloat>(dummy);
+  o_AP = platform.malloc<dfloat>(dummy);
+  o_Ax = platform.malloc<dfloat>(Nstride, dummy);
+
+  //views of the basis vectors
+  o_Rv.malloc(s);
+  o_ARv.malloc(s);
+  for (int j=0;j<s;++j) {
+    o_Rv[j]  = o_R  + j*Nstride;
+    o_ARv[j] = o_AR + j*Nstride;
+  }
+
+  //pinned tmp buffers for reductions
+  const int Ndots = (2*s+1)*s*SSTEPCG_BLOCKSIZE;
+  h_dots  = platform.hostMalloc<dfloat>(Ndots);
+  o_dots  = platform.malloc<dfloat>(Ndots);
+  h_rdotr = platform.hostMalloc<dfloat>(SSTEPCG_BLOCKSIZE);
+  o_rdotr = platform.malloc<dfloat>(SSTEPCG_BLOCKSIZE);
+
+  //B and a coefficients
+  h_coefs = platform.hostMalloc<dfloat>(s*s+s);
+  o_coefs = platform.malloc<dfloat>(s*s+s);
+
+  G.malloc(s*s);
+  C.malloc(s*s);
+  g.malloc(s);
+  B.malloc(s*s);
+  a.malloc(s);
+  L.malloc(s*s);
+  D.malloc(s);
+  Lprev.malloc(s*s);
+  Dprev.malloc(s);
+
+  /* build kernels */
+  properties_t kernelInfo = platform.props(); //copy base properties
+
+  //add defines
+  kernelInfo["defines/" "p_blockSize"] = (int)SSTEPCG_BLOCKSIZE;
+  kernelInfo["defines/" "p_S"] = s;
+
+  multiDotKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdateSSTEPCG.okl",
+                                "multiDotSSTEPCG", kernelInfo);
+  updatePKernel  = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdateSSTEPCG.okl",
+                                "updatePSSTEPCG", kernelInfo);
+  updateXKernel  = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdateSSTEPCG.okl",
+                                "updateXSSTEPCG", kernelInfo);
+}
+
+int sstepcg::Solve(operator_t& linearOperator, operator_t& precon,
+                   deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r,
+                   const dfloat tol, const int MAXIT, const int verbose) {
+
+  int rank = comm.rank();
+  linAlg_t &linAlg = platform.linAlg();
+
+  // register scalars
+  dfloat rdotr0 = 0.0;
+  dfloat TOL = 0.0;
+
+  const bool rhsNorm = settings.compareSetting("LINEAR SOLVER STOPPING CRITERION", "ABS/REL-RHS-2NORM");
+  int Nreductions = 0;
+
+  // Comput norm of RHS (for stopping tolerance).
+  if (rhsNorm) {
+    dfloat normb = linAlg.norm2(N, o_r, comm);
+    TOL = std::max(tol*tol*normb*normb, tol*tol);
+    Nreductions++;
+  }
+
+  // compute A*x
+  linearOperator.Operator(o_x, o_Ax);
+
+  // subtract r = r - A*x
+  linAlg.axpy(N, -1.f, o_Ax, 1.f, o_r);
+
+  rdotr0 = linAlg.norm2(N, o_r, comm);
+  rdotr0 = rdotr0*rdotr0;
+  Nreductions++;
+
+  if (!rhsNorm) {
+    TOL = std::max(tol*tol*rdotr0,tol*tol);
+  }
+
+  if (verbose&&(rank==0))
+    printf("SSTEPCG: initial res norm %12.12f \n", sqrt(rdotr0));
+
+  //no search directions yet
+  NsPrev = 0;
+
+  bool pending = false;
+  int iter = 0;
+  while (iter<MAXIT) {
+
+    // R_0 = M*r, AR_0 = A*R_0, overlapped with the r.r reduction
+    precon.Operator(o_r, o_Rv[0]);
+    linearOperator.Operator(o_Rv[0], o_ARv[0]);
+
+    if (pending) {
+      comm.Wait(request);
+      pending = false;
+      rdotr0 = h_rdotr[0];
+
+      if (verbose&&(rank==0)) {
+        if(rdotr0<0)
+          printf("WARNING SSTEPCG: rdotr = %17.15lf\n", rdotr0);
+
+        printf("SSTEPCG: it %d, r norm %12.12le, block size %d \n", iter, sqrt(rdotr0), NsPrev);
+      }
+    }
+
+    // Exit if tolerance is reached, taking at least one step.
+    if (((iter == 0) && (rdotr0 == 0.0)) ||
+        ((iter > 0) && (rdotr0 <= TOL))) {
+      break;
+    }
+
+    // R_j = M*AR_{j-1}, AR_j = A*R_j
+    for (int j=1;j<s;++j) {
+      precon.Operator(o_ARv[j-1], o_Rv[j]);
+      linearOperator.Operator(o_Rv[j], o_ARv[j]);
+    }
+
+    // R^T*A*R, (A*P_prev)^T*R, and R^T*r in a single reduction
+    GramMatrices(o_r);
+    Nreductions++;
+
+    // B = -W_prev^{-1}*C, W = P^T*A*P, and a = W^{-1}*R^T*r
+    // (never step past MAXIT)
+    const int Ns = SolveBlock(std::min(s, MAXIT-iter));
+
+    // basis has collapsed, stop
+    if (Ns==0) break;
+
+    for (int i=0;i<Ns;++i) {
+      for (int j=0;j<NsPrev;++j) {
+        h_coefs[j+i*NsPrev] = B[j+i*s];
+      }
+      h_coefs[s*s+i] = a[i];
+    }
+    o_coefs.copyFrom(h_coefs);
+
+    // P <= R + P_prev*B
+    // AP <= AR + AP_prev*B
+    updatePKernel(N, Nstride, Ns, NsPrev, o_coefs, o_R, o_P);
+    updatePKernel(N, Nstride, Ns, NsPrev, o_coefs, o_AR, o_AP);
+
+    // x <= x + P*a
+    // r <= r - AP*a
+    // dot(r,r)
+    UpdateX(Ns, o_x, o_r);
+    pending = true;
+    Nreductions++;
+
+    // keep the factors of W for the next block
+    NsPrev = Ns;
+    Lprev.copyFrom(L);
+    Dprev.copyFrom(D);
+
+    iter += Ns;
+  }
+
+  // finish the last reduction if we ran out of iterations
+  if (pending) comm.Wait(request);
+
+  if (verbose&&(rank==0)) {
+    // PCG needs r.z, p.Ap, and r.r each iteration plus the initial r.r
+    const int NreductionsPCG = 3*iter + 1 + (rhsNorm ? 1 : 0);
+    printf("SSTEPCG: %d global reductions, %d fewer than PCG \n",
+           Nreductions, NreductionsPCG - Nreductions);
+  }
+
+  return iter;
+}
+
+void sstepcg::GramMatrices(deviceMemory<dfloat>& o_r){
+
+  int Nblocks = (N+SSTEPCG_BLOCKSIZE-1)/SSTEPCG_BLOCKSIZE;
+  Nblocks = std::min(Nblocks, SSTEPCG_BLOCKSIZE); //limit to SSTEPCG_BLOCKSIZE entries
+
+  // G_ij = R_i.AR_j, i<=j
+  // C_ij = AP_i.R_j
+  // g_i  = R_i.r
+  const int NG = (s*(s+1))/2;
+  const int NC = NsPrev*s;
+  const int Nsums = NG + NC + s;
+
+  if (Nblocks>0) {
+    dlong offset=0;
+    for (int j=0;j<s;++j) {
+      multiDotKernel(N, Nstride, j+1, Nblocks, o_R, o_ARv[j], o_dots+offset);
+      offset += (j+1)*Nblocks;
+    }
+    if (NsPrev>0) {
+      for (int j=0;j<s;++j) {
+        multiDotKernel(N, Nstride, NsPrev, Nblocks, o_AP, o_Rv[j], o_dots+offset);
+        offset += NsPrev*Nblocks;
+      }
+    }
+    multiDotKernel(N, Nstride, s, Nblocks, o_R, o_r, o_dots+offset);
+
+    h_dots.copyFrom(o_dots, Nsums*Nblocks);
+  }
+
+  memory<dfloat> sums(Nsums, 0.0);
+  for (int n=0;n<Nsums;++n) {
+    for (int b=0;b<Nblocks;++b) {
+      sums[n] += h_dots[b+n*Nblocks];
+    }
+  }
+
+  comm.Allreduce(sums, Comm::Sum, Nsums);
+
+  int cnt=0;
+  for (int j=0;j<s;++j) {
+    for (int i=0;i<=j;++i) {
+      G[i+j*s] = sums[cnt];
+      G[j+i*s] = sums[cnt];
+      cnt++;
+    }
+  }
+  for (int j=0;j<s;++j) {
+    for (int i=0;i<NsPrev;++i) {
+      C[i+j*s] = sums[cnt++];
+    }
+  }
+  for (int i=0;i<s;++i) {
+    g[i] = sums[cnt++];
+  }
+}
+
+int sstepcg::SolveBlock(const int maxNs) {
+
+  // B = -W_prev^{-1}*C
+  for (int j=0;j<s;++j) {
+    for (int i=0;i<NsPrev;++i) B[i+j*s] = -C[i+j*s];
+    if (NsPrev>0) CholeskySolve(NsPrev, s, Lprev, Dprev, B.ptr()+j*s);
+  }
+
+  // W = G + C^T*B
+  memory<dfloat> W(s*s);
+  for (int j=0;j<s;++j) {
+    for (int i=0;i<s;++i) {
+      dfloat Wij = G[i+j*s];
+      for (int l=0;l<NsPrev;++l) Wij += C[l+i*s]*B[l+j*s];
+      W[i+j*s] = Wij;
+    }
+  }
+
+  // keep only the columns of the monomial basis that are numerically
+  // independent in the A-norm. Accepting columns with a smaller relative
+  // pivot than this lets the directions lose A-orthogonality for s > 4.
+  const dfloat tolerance = std::max(static_cast<dfloat>(1.0e-4),
+                                    sqrt(std::numeric_limits<dfloat>::epsilon()));
+  const int Ns = CholeskyFactor(maxNs, s, W, L, D, tolerance);
+
+  // a = W^{-1}*g
+  for (int i=0;i<Ns;++i) a[i] = g[i];
+  CholeskySolve(Ns, s, L, D, a.ptr());
+
+  return Ns;
+}
+
+void sstepcg::UpdateX(const int Ns, deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r){
+
+  int Nblocks = (N+SSTEPCG_BLOCKSIZE-1)/SSTEPCG_BLOCKSIZE;
+  Nblocks = std::min(Nblocks, SSTEPCG_BLOCKSIZE); //limit to SSTEPCG_BLOCKSIZE entries
+
+  if (Nblocks>0) {
+    updateXKernel(N, Nstride, Ns, Nblocks, o_coefs+s*s, o_P, o_AP, o_x, o_r, o_rdotr);
+    h_rdotr.copyFrom(o_rdotr, Nblocks);
+  } else {
+    h_rdotr[0] = 0.0;
+  }
+
+  for(int b=1;b<Nblocks;++b)
+    h_rdotr[0] += h_rdotr[b];
+
+  comm.Iallreduce(h_rdotr, Comm::Sum, 1, request);
+}
+
+} //namespace LinearSolver
+
+} //namespace libp
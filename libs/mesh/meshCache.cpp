@@ -0,0 +1,310 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+#include "timer.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace libp {
+
+/*
+  Mesh cache file layout. One file per rank holding the partitioned and
+  connected mesh. A fixed size header is followed by a table of sections,
+  each aligned to cacheAlignment bytes so the file can be memory mapped and
+  the arrays used in place.
+*/
+namespace {
+
+constexpr char cacheMagic[8] = {'L','I','B','P','M','S','H','\0'};
+constexpr int cacheVersion = 2;
+constexpr size_t cacheAlignment = 64;
+
+enum cacheSection {
+  EToVSection=0,
+  EXSection,
+  EYSection,
+  EZSection,
+  elementInfoSection,
+  EToESection,
+  EToFSection,
+  EToPSection,
+  EToBSection,
+  globalIdsSection,
+  mapBSection,
+  NcacheSections
+};
+
+struct cacheHeader_t {
+  char magic[8];
+  int32_t version;
+  int32_t rank, size;
+  int32_t dim, elementType, N;
+  int32_t sizeofDlong, sizeofHlong, sizeofDfloat;
+  int64_t Nelements, NelementsGlobal, Nnodes, NboundaryFaces, totalHaloPairs;
+  int64_t meshFileSize, meshFileTime;
+  uint64_t settingsKey;
+  int64_t offset[NcacheSections];
+  int64_t bytes[NcacheSections];
+};
+
+std::string CacheFileName(const std::string name, const int rank) {
+  char fileName[BUFSIZ];
+  sprintf(fileName, "%s_%04d.bin", name.c_str(), rank);
+  return std::string(fileName);
+}
+
+void MeshFileStamp(const std::string meshFile, int64_t& fileSize, int64_t& fileTime) {
+  struct stat st;
+  if (stat(meshFile.c_str(), &st)==0) {
+    fileSize = static_cast<int64_t>(st.st_size);
+    fileTime = static_cast<int64_t>(st.st_mtime);
+  } else {
+    fileSize = -1;
+    fileTime = -1;
+  }
+}
+
+template<typename T>
+void LoadSection(memory<T>& m, const char* data, const int64_t bytes) {
+  const size_t Nentries = static_cast<size_t>(bytes)/sizeof(T);
+  m.malloc(Nentries);
+  m.copyFrom(reinterpret_cast<const T*>(data), Nentries);
+}
+
+} //namespace
+
+/* Hash of the settings that determine the partitioned mesh. Computed before
+   the mesh is built, since SetupBox fills in the BOX GLOBAL sizes */
+uint64_t mesh_t::CacheKey() {
+  const std::string names[] = {"MESH FILE",
+                               "BOX DIMX", "BOX DIMY", "BOX DIMZ",
+                               "BOX NX", "BOX NY", "BOX NZ",
+                               "BOX GLOBAL NX", "BOX GLOBAL NY", "BOX GLOBAL NZ",
+                               "BOX BOUNDARY FLAG",
+                               "PARADOGS PARTITIONING",
+                               "PARADOGS NODE AWARE",
+                               "PARADOGS ELEMENT WEIGHTS",
+                               "PARADOGS PML WEIGHT"};
+
+  //FNV-1a
+  uint64_t key = 14695981039346656037ULL;
+  for (const std::string& name : names) {
+    const std::string entry = name + "=" + settings.getSetting(name) + ";";
+    for (const char c : entry) {
+      key = (key ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+  }
+  return key;
+}
+
+/* Load partitioned and connected mesh data from the cache. Returns false
+   on all ranks if any rank's cache is missing or stale */
+bool mesh_t::ReadCache(const std::string cacheName, const std::string meshFile,
+                       const uint64_t cacheKey) {
+
+  timePoint_t start = GlobalTime(comm);
+
+  const std::string fileName = CacheFileName(cacheName, rank);
+
+  int64_t meshFileSize, meshFileTime;
+  MeshFileStamp(meshFile, meshFileSize, meshFileTime);
+
+  int valid = 1;
+  void* map = MAP_FAILED;
+  size_t mapBytes = 0;
+
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd<0) {
+    valid = 0;
+  } else {
+    struct stat st;
+    fstat(fd, &st);
+    mapBytes = static_cast<size_t>(st.st_size);
+    if (mapBytes>=sizeof(cacheHeader_t)) {
+      map = mmap(nullptr, mapBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (map==MAP_FAILED) valid = 0;
+  }
+
+  const cacheHeader_t* header = static_cast<const cacheHeader_t*>(map);
+  if (valid) {
+    valid = std::equal(cacheMagic, cacheMagic+8, header->magic)
+            && header->version==cacheVersion
+            && header->rank==rank
+            && header->size==size
+            && header->dim==dim
+            && header->elementType==static_cast<int>(elementType)
+            && header->N==N
+            && header->sizeofDlong==static_cast<int>(sizeof(dlong))
+            && header->sizeofHlong==static_cast<int>(sizeof(hlong))
+            && header->sizeofDfloat==static_cast<int>(sizeof(dfloat))
+            && header->meshFileSize==meshFileSize
+            && header->meshFileTime==meshFileTime
+            && header->settingsKey==cacheKey;
+  }
+  if (valid) {
+    for (int sec=0;sec<NcacheSections;++sec) {
+      if (header->offset[sec]+header->bytes[sec] > static_cast<int64_t>(mapBytes)) valid = 0;
+    }
+  }
+
+  comm.Allreduce(valid, Comm::Min);
+
+  if (!valid) {
+    if (map!=MAP_FAILED) munmap(map, mapBytes);
+    if (rank==0) {
+      printf("Mesh cache %s not found or out of date, rebuilding\n", cacheName.c_str());
+    }
+    return false;
+  }
+
+  const char* data = static_cast<const char*>(map);
+  auto Load = [&](auto& m, const int section) {
+    LoadSection(m, data + header->offset[section], header->bytes[section]);
+  };
+
+  Nelements       = static_cast<dlong>(header->Nelements);
+  NelementsGlobal = static_cast<hlong>(header->NelementsGlobal);
+  Nnodes          = static_cast<hlong>(header->Nnodes);
+  NboundaryFaces  = static_cast<hlong>(header->NboundaryFaces);
+  totalHaloPairs  = static_cast<dlong>(header->totalHaloPairs);
+
+  Load(EToV, EToVSection);
+  Load(EX, EXSection);
+  Load(EY, EYSection);
+  if (dim==3) Load(EZ, EZSection);
+  Load(elementInfo, elementInfoSection);
+  Load(EToE, EToESection);
+  Load(EToF, EToFSection);
+  Load(EToP, EToPSection);
+  Load(EToB, EToBSection);
+  Load(globalIds, globalIdsSection);
+  Load(mapB, mapBSection);
+
+  munmap(map, mapBytes);
+
+  o_EToB = platform.malloc<int>(EToB);
+  o_mapB = platform.malloc<int>(mapB);
+
+  timePoint_t end = GlobalTime(comm);
+  if (rank==0) {
+    printf("Loaded mesh cache %s in %5.2f seconds\n",
+           cacheName.c_str(), ElapsedTime(start, end));
+  }
+  return true;
+}
+
+/* Write partitioned and connected mesh data to the cache. connectedEToE is
+   the element-to-element map before HaloSetup replaces remote neighbors
+   with halo indices */
+void mesh_t::WriteCache(const std::string cacheName, const std::string meshFile,
+                        const uint64_t cacheKey, const memory<hlong> connectedEToE) {
+
+  cacheHeader_t header;
+  std::memset(&header, 0, sizeof(cacheHeader_t));
+  std::copy(cacheMagic, cacheMagic+8, header.magic);
+  header.version = cacheVersion;
+  header.rank = rank;
+  header.size = size;
+  header.dim = dim;
+  header.elementType = static_cast<int>(elementType);
+  header.N = N;
+  header.sizeofDlong = sizeof(dlong);
+  header.sizeofHlong = sizeof(hlong);
+  header.sizeofDfloat = sizeof(dfloat);
+  header.Nelements = Nelements;
+  header.NelementsGlobal = NelementsGlobal;
+  header.Nnodes = Nnodes;
+  header.NboundaryFaces = NboundaryFaces;
+  header.totalHaloPairs = totalHaloPairs;
+  MeshFileStamp(meshFile, header.meshFileSize, header.meshFileTime);
+  header.settingsKey = cacheKey;
+
+  const size_t NE = static_cast<size_t>(Nelements);
+  const size_t NEhalo = static_cast<size_t>(Nelements+totalHaloPairs);
+
+  //only the local part of EToV is stored, ConnectFaceVertices rebuilds the halo region
+  const char* ptrs[NcacheSections] = {
+    reinterpret_cast<const char*>(EToV.ptr()),
+    reinterpret_cast<const char*>(EX.ptr()),
+    reinterpret_cast<const char*>(EY.ptr()),
+    reinterpret_cast<const char*>(EZ.ptr()),
+    reinterpret_cast<const char*>(elementInfo.ptr()),
+    reinterpret_cast<const char*>(connectedEToE.ptr()),
+    reinterpret_cast<const char*>(EToF.ptr()),
+    reinterpret_cast<const char*>(EToP.ptr()),
+    reinterpret_cast<const char*>(EToB.ptr()),
+    reinterpret_cast<const char*>(globalIds.ptr()),
+    reinterpret_cast<const char*>(mapB.ptr())
+  };
+  header.bytes[EToVSection]        = NE*Nverts*sizeof(hlong);
+  header.bytes[EXSection]          = NE*Nverts*sizeof(dfloat);
+  header.bytes[EYSection]          = NE*Nverts*sizeof(dfloat);
+  header.bytes[EZSection]          = (dim==3) ? NE*Nverts*sizeof(dfloat) : 0;
+  header.bytes[elementInfoSection] = NE*sizeof(hlong);
+  header.bytes[EToESection]        = NE*Nfaces*sizeof(hlong);
+  header.bytes[EToFSection]        = NE*Nfaces*sizeof(int);
+  header.bytes[EToPSection]        = NE*Nfaces*sizeof(int);
+  header.bytes[EToBSection]        = NE*Nfaces*sizeof(int);
+  header.bytes[globalIdsSection]   = NEhalo*Np*sizeof(hlong);
+  header.bytes[mapBSection]        = NEhalo*Np*sizeof(int);
+
+  auto Align = [](const int64_t offset) {
+    return static_cast<int64_t>(((offset+cacheAlignment-1)/cacheAlignment)*cacheAlignment);
+  };
+
+  int64_t offset = Align(sizeof(cacheHeader_t));
+  for (int sec=0;sec<NcacheSections;++sec) {
+    header.offset[sec] = offset;
+    offset = Align(offset + header.bytes[sec]);
+  }
+
+  const std::string fileName = CacheFileName(cacheName, rank);
+  FILE *fp = fopen(fileName.c_str(), "wb");
+  LIBP_ABORT("Cannot open mesh cache file: " << fileName,
+             fp==nullptr);
+
+  const char zeros[cacheAlignment] = {0};
+  fwrite(&header, sizeof(cacheHeader_t), 1, fp);
+  int64_t pos = sizeof(cacheHeader_t);
+  for (int sec=0;sec<NcacheSections;++sec) {
+    fwrite(zeros, 1, header.offset[sec]-pos, fp);
+    fwrite(ptrs[sec], 1, header.bytes[sec], fp);
+    pos = header.offset[sec] + header.bytes[sec];
+  }
+  fclose(fp);
+
+  comm.Barrier();
+  if (rank==0) {
+    printf("Wrote mesh cache %s\n", cacheName.c_str());
+  }
+}
+
+} //namespace libp
@@ -29,8 +29,92 @@ SOFTWARE.
 
 namespace libp {
 
+/* Estimate the relative cost of each element for the partitioner.
+   Multirate levels are predicted from the shortest vertex-to-vertex
+   distance of each element, following the doubling of time step size per
+   level used in MultiRateSetup. Elements on level l are stepped
+   2^(Nlevels-1-l) times per coarsest step. PML elements are scaled by
+   PARADOGS PML WEIGHT. */
+static void PartitionWeights(mesh_t& mesh,
+                             memory<dfloat>& weights,
+                             int& Nconstraints) {
+
+  constexpr int maxLevels = 8;
+
+  dfloat pmlWeight=1.0;
+  mesh.settings.getSetting("PARADOGS PML WEIGHT", pmlWeight);
+
+  const bool multirate = !mesh.settings.compareSetting("PARADOGS ELEMENT WEIGHTS", "NONE");
+  const bool multiconstraint = mesh.settings.compareSetting("PARADOGS ELEMENT WEIGHTS", "MULTICONSTRAINT");
+
+  if (!multirate && pmlWeight==1.0) {
+    Nconstraints = 0;
+    return;
+  }
+
+  memory<int> level(mesh.Nelements, 0);
+  int Nlevels = 1;
+
+  if (multirate) {
+    memory<dfloat> h(mesh.Nelements);
+
+    #pragma omp parallel for
+    for (dlong e=0;e<mesh.Nelements;++e) {
+      dfloat hmin = std::numeric_limits<dfloat>::max();
+      for (int v=0;v<mesh.Nverts;++v) {
+        for (int u=v+1;u<mesh.Nverts;++u) {
+          const dfloat dx = mesh.EX[u+e*mesh.Nverts]-mesh.EX[v+e*mesh.Nverts];
+          const dfloat dy = mesh.EY[u+e*mesh.Nverts]-mesh.EY[v+e*mesh.Nverts];
+          const dfloat dz = (mesh.dim==3) ? mesh.EZ[u+e*mesh.Nverts]-mesh.EZ[v+e*mesh.Nverts] : 0.0;
+          hmin = std::min(hmin, std::sqrt(dx*dx+dy*dy+dz*dz));
+        }
+      }
+      h[e] = hmin;
+    }
+
+    dfloat hmin = std::numeric_limits<dfloat>::max();
+    dfloat hmax = 0.0;
+    for (dlong e=0;e<mesh.Nelements;++e) {
+      hmin = std::min(hmin, h[e]);
+      hmax = std::max(hmax, h[e]);
+    }
+    mesh.comm.Allreduce(hmin, Comm::Min);
+    mesh.comm.Allreduce(hmax, Comm::Max);
+
+    Nlevels = std::min(static_cast<int>(std::floor(std::log2(hmax/hmin)))+1,
+                       maxLevels);
+
+    #pragma omp parallel for
+    for (dlong e=0;e<mesh.Nelements;++e) {
+      const int lev = static_cast<int>(std::floor(std::log2(h[e]/hmin)));
+      level[e] = std::max(0, std::min(lev, Nlevels-1));
+    }
+  }
+
+  Nconstraints = multiconstraint ? Nlevels : 1;
+  weights.malloc(mesh.Nelements*Nconstraints, 0.0);
+
+  #pragma omp parallel for
+  for (dlong e=0;e<mesh.Nelements;++e) {
+    const hlong type = mesh.elementInfo[e];
+    const bool pml = (type==100)||(type==200)||(type==300)||
+                     (type==400)||(type==500)||(type==600)||
+                     (type==700);
+
+    dfloat w = static_cast<dfloat>(1 << (Nlevels-1-level[e]));
+    if (pml) w *= pmlWeight;
+
+    const int c = multiconstraint ? level[e] : 0;
+    weights[c+e*Nconstraints] = w;
+  }
+}
+
 void mesh_t::Partition(){
 
+  memory<dfloat> weights;
+  int Nconstraints=0;
+  PartitionWeights(*this, weights, Nconstraints);
+
   paradogs::MeshPartition(platform,
                           settings,
                           Nelements,
@@ -45,6 +129,9 @@ void mesh_t::Partition(){
                           EX,
                           EY,
                           EZ,
+                          elementInfo,
+                          weights,
+                          Nconstraints,
                           comm);
 }
 
@@ -0,0 +1,390 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+#include "timer.hpp"
+
+namespace libp {
+
+/*Fast tokenizing of whitespace separated fields in a line of text.
+  Integers are parsed by hand, reals are handed to strtod.*/
+static inline void SkipSpace(const char* &c) {
+  while (*c==' ' || *c=='\t' || *c=='\r') ++c;
+}
+
+static inline hlong ParseInt(const char* &c) {
+  SkipSpace(c);
+  const bool neg = (*c=='-');
+  if (*c=='-' || *c=='+') ++c;
+  hlong val = 0;
+  while (*c>='0' && *c<='9') {
+    val = 10*val + (*c-'0');
+    ++c;
+  }
+  return neg ? -val : val;
+}
+
+static inline dfloat ParseReal(const char* &c) {
+  SkipSpace(c);
+  char *end;
+  const dfloat val = static_cast<dfloat>(strtod(c, &end));
+  c = end;
+  return val;
+}
+
+/*gmsh element type codes*/
+static int GmshElementCode(const Mesh::ElementType elementType) {
+  switch (elementType) {
+    case Mesh::TRIANGLES:      return 2;
+    case Mesh::QUADRILATERALS: return 3;
+    case Mesh::TETRAHEDRA:     return 4;
+    case Mesh::HEXAHEDRA:      return 5;
+  }
+  return -1;
+}
+
+static int GmshFaceCode(const Mesh::ElementType elementType) {
+  switch (elementType) {
+    case Mesh::TRIANGLES:      return 1; // line
+    case Mesh::QUADRILATERALS: return 1; // line
+    case Mesh::TETRAHEDRA:     return 2; // triangle
+    case Mesh::HEXAHEDRA:      return 3; // quadrilateral
+  }
+  return -1;
+}
+
+/*
+   purpose: read gmsh mesh collectively. Each rank reads a disjoint byte
+   range of the file with MPI-IO, parses the nodes and elements that start
+   in its range, and the element chunks and vertex coordinates are then
+   redistributed so that each rank holds the same contiguous chunk of
+   elements as the serial readers would produce.
+*/
+void mesh_t::ReadGmshParallel(const std::string fileName){
+
+  timePoint_t timeStart = GlobalTime(comm);
+
+  MPI_File fh;
+  int err = MPI_File_open(comm.comm(), fileName.c_str(),
+                          MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+  LIBP_ABORT("Cannot open file: " << fileName,
+             err!=MPI_SUCCESS);
+
+  MPI_Offset fileSize;
+  MPI_File_get_size(fh, &fileSize);
+
+  /*Each rank owns the lines which start in [lo, hi). Read one byte before
+    the range to detect line starts, and a margin after it to complete the
+    last line*/
+  constexpr MPI_Offset margin = 4096;
+  const MPI_Offset lo = (fileSize*rank)/size;
+  const MPI_Offset hi = (fileSize*(rank+1))/size;
+  const MPI_Offset readLo = std::max(lo-1, MPI_Offset(0));
+  const MPI_Offset readHi = std::min(hi+margin, fileSize);
+
+  const size_t Nbytes = static_cast<size_t>(readHi-readLo);
+  memory<char> buf(Nbytes+1);
+  buf[Nbytes] = '\0';
+
+  /*Read in blocks to keep MPI counts in range. All ranks must make the
+    same number of collective calls*/
+  constexpr size_t blockSize = size_t(1)<<30;
+  hlong Nblocks = static_cast<hlong>((Nbytes+blockSize-1)/blockSize);
+  comm.Allreduce(Nblocks, Comm::Max);
+  for (hlong b=0;b<Nblocks;++b) {
+    const size_t offset = std::min(static_cast<size_t>(b)*blockSize, Nbytes);
+    const int count = static_cast<int>(std::min(blockSize, Nbytes-offset));
+    MPI_File_read_at_all(fh, readLo+offset, buf.ptr()+offset,
+                         count, MPI_CHAR, MPI_STATUS_IGNORE);
+  }
+  MPI_File_close(&fh);
+
+  timePoint_t timeRead = GlobalTime(comm);
+
+  /*Find the start of each line owned by this rank*/
+  const size_t first = static_cast<size_t>(lo-readLo);
+  const size_t last  = static_cast<size_t>(hi-readLo);
+
+  std::vector<size_t> lines;
+  for (size_t n=first;n<last;++n) {
+    if (n+readLo==0 || buf[n-1]=='\n') lines.push_back(n);
+  }
+  LIBP_ABORT("Error reading mesh file: " << fileName << ", line longer than " << margin << " bytes",
+             hi<fileSize && lines.size()>0
+             && std::find(buf.ptr()+lines.back(), buf.ptr()+Nbytes, '\n')==buf.ptr()+Nbytes);
+
+  /*Find section markers. Record the offset of the line following each marker*/
+  hlong nodeCountOffset=fileSize, nodesEnd=fileSize;
+  hlong elementCountOffset=fileSize, elementsEnd=fileSize;
+  for (const size_t l: lines) {
+    const char* c = buf.ptr()+l;
+    if (*c!='$') continue;
+
+    const char* next = strchr(c, '\n');
+    const hlong nextOffset = (next==nullptr) ? fileSize : readLo + (next-buf.ptr()) + 1;
+
+    if (!strncmp(c, "$Nodes", 6))       nodeCountOffset    = nextOffset;
+    if (!strncmp(c, "$EndNodes", 9))    nodesEnd           = readLo + l;
+    if (!strncmp(c, "$Elements", 9))    elementCountOffset = nextOffset;
+    if (!strncmp(c, "$EndElements", 12)) elementsEnd       = readLo + l;
+  }
+  comm.Allreduce(nodeCountOffset, Comm::Min);
+  comm.Allreduce(nodesEnd, Comm::Min);
+  comm.Allreduce(elementCountOffset, Comm::Min);
+  comm.Allreduce(elementsEnd, Comm::Min);
+
+  LIBP_ABORT("Error reading mesh file: " << fileName << ", cannot find $Nodes section",
+             nodeCountOffset>=fileSize || nodesEnd>=fileSize);
+  LIBP_ABORT("Error reading mesh file: " << fileName << ", cannot find $Elements section",
+             elementCountOffset>=fileSize || elementsEnd>=fileSize);
+
+  /*Parse node and element lines*/
+  Nnodes = 0;
+  hlong gNelements = 0;
+
+  std::vector<dfloat> localV;    //coordinates of nodes read on this rank
+  std::vector<hlong>  localE;    //(tag, vertices) of elements read on this rank
+  std::vector<hlong>  localB;    //(tag, vertices) of boundary faces read on this rank
+
+  const int elementCode = GmshElementCode(elementType);
+  const int faceCode = GmshFaceCode(elementType);
+
+  for (const size_t l: lines) {
+    const hlong offset = readLo + l;
+    const char* c = buf.ptr()+l;
+
+    if (offset==nodeCountOffset) {
+      Nnodes = ParseInt(c);
+    } else if (offset==elementCountOffset) {
+      gNelements = ParseInt(c);
+    } else if (offset>nodeCountOffset && offset<nodesEnd) {
+      ParseInt(c); //node id
+      const dfloat xn = ParseReal(c);
+      const dfloat yn = ParseReal(c);
+      const dfloat zn = ParseReal(c);
+      localV.push_back(xn);
+      localV.push_back(yn);
+      if (dim==3) localV.push_back(zn);
+    } else if (offset>elementCountOffset && offset<elementsEnd) {
+      ParseInt(c); //element id
+      const int type = static_cast<int>(ParseInt(c));
+      const int Ntags = static_cast<int>(ParseInt(c));
+
+      if (type!=elementCode && type!=faceCode) continue;
+
+      const hlong tag = (Ntags>0) ? ParseInt(c) : 0;
+      for (int n=1;n<Ntags;++n) ParseInt(c);
+
+      std::vector<hlong>& list = (type==elementCode) ? localE : localB;
+      const int Nv = (type==elementCode) ? Nverts : NfaceVertices;
+      list.push_back(tag);
+      for (int v=0;v<Nv;++v) list.push_back(ParseInt(c)-1);
+    }
+  }
+  buf.free();
+
+  comm.Allreduce(Nnodes, Comm::Max);
+  comm.Allreduce(gNelements, Comm::Max);
+
+  timePoint_t timeParse = GlobalTime(comm);
+
+  /*Global offsets of the nodes read by each rank*/
+  const int Ncoords = dim;
+  const hlong NlocalNodes = static_cast<hlong>(localV.size()/Ncoords);
+  memory<hlong> nodeStarts(size+1);
+  nodeStarts[0] = 0;
+  comm.Allgather(NlocalNodes, nodeStarts+1);
+  for (int rr=0;rr<size;++rr) nodeStarts[rr+1] += nodeStarts[rr];
+
+  LIBP_ABORT("Error reading mesh file: " << fileName << ", expected " << Nnodes
+             << " nodes but found " << nodeStarts[size],
+             nodeStarts[size]!=Nnodes);
+
+  /*Redistribute elements so each rank holds an even, contiguous chunk*/
+  const int NeEntries = Nverts+1;
+  const hlong NlocalE = static_cast<hlong>(localE.size()/NeEntries);
+  memory<hlong> elementStarts(size+1);
+  elementStarts[0] = 0;
+  comm.Allgather(NlocalE, elementStarts+1);
+  for (int rr=0;rr<size;++rr) elementStarts[rr+1] += elementStarts[rr];
+
+  const hlong NelementsTotal = elementStarts[size];
+  const hlong chunk = NelementsTotal/size;
+  const int remainder = static_cast<int>(NelementsTotal - chunk*size);
+
+  auto chunkStart = [&](const int rr) {
+    return rr*chunk + std::min(rr, remainder);
+  };
+
+  memory<int> sendCounts(size, 0), recvCounts(size, 0);
+  memory<int> sendOffsets(size+1, 0), recvOffsets(size+1, 0);
+
+  const hlong myStart = elementStarts[rank];
+  const hlong myEnd   = elementStarts[rank+1];
+  for (int rr=0;rr<size;++rr) {
+    const hlong start = std::max(myStart, chunkStart(rr));
+    const hlong end = std::min(myEnd, chunkStart(rr+1));
+    if (end>start) sendCounts[rr] = static_cast<int>((end-start)*NeEntries);
+  }
+  comm.Alltoall(sendCounts, recvCounts);
+  for (int rr=0;rr<size;++rr) {
+    sendOffsets[rr+1] = sendOffsets[rr] + sendCounts[rr];
+    recvOffsets[rr+1] = recvOffsets[rr] + recvCounts[rr];
+  }
+
+  Nelements = static_cast<dlong>(chunkStart(rank+1) - chunkStart(rank));
+  memory<hlong> recvE(Nelements*NeEntries);
+  memory<hlong> sendE(localE.size());
+  sendE.copyFrom(localE.data());
+  localE.clear(); localE.shrink_to_fit();
+
+  comm.Alltoallv(sendE, sendCounts, sendOffsets,
+                 recvE, recvCounts, recvOffsets);
+  sendE.free();
+
+  EToV.malloc(Nelements*Nverts);
+  elementInfo.malloc(Nelements);
+  for (dlong e=0;e<Nelements;++e) {
+    elementInfo[e] = recvE[e*NeEntries];
+    for (int v=0;v<Nverts;++v) {
+      EToV[e*Nverts+v] = recvE[e*NeEntries+1+v];
+    }
+  }
+  recvE.free();
+
+  /*Gather boundary faces on all ranks, as the serial readers do*/
+  const int NbEntries = NfaceVertices+1;
+  const int NlocalB = static_cast<int>(localB.size());
+  memory<int> bCounts(size), bOffsets(size+1);
+  comm.Allgather(NlocalB, bCounts);
+  bOffsets[0] = 0;
+  for (int rr=0;rr<size;++rr) bOffsets[rr+1] = bOffsets[rr] + bCounts[rr];
+
+  NboundaryFaces = bOffsets[size]/NbEntries;
+  boundaryInfo.malloc(NboundaryFaces*NbEntries);
+  memory<hlong> sendB(NlocalB);
+  sendB.copyFrom(localB.data());
+  comm.Allgatherv(sendB, NlocalB, boundaryInfo, bCounts, bOffsets);
+  localB.clear(); localB.shrink_to_fit();
+
+  /*Request coordinates of the vertices of local elements from the ranks which read them*/
+  memory<hlong> vids(Nelements*Nverts);
+  vids.copyFrom(EToV);
+  std::sort(vids.ptr(), vids.ptr()+vids.length());
+  const dlong Nvids = static_cast<dlong>(std::unique(vids.ptr(), vids.ptr()+vids.length()) - vids.ptr());
+
+  for (int rr=0;rr<size;++rr) sendCounts[rr] = 0;
+  for (dlong n=0;n<Nvids;++n) {
+    const int rr = static_cast<int>(std::upper_bound(nodeStarts.ptr(), nodeStarts.ptr()+size+1, vids[n])
+                                   - nodeStarts.ptr()) - 1;
+    sendCounts[rr]++;
+  }
+  comm.Alltoall(sendCounts, recvCounts);
+  for (int rr=0;rr<size;++rr) {
+    sendOffsets[rr+1] = sendOffsets[rr] + sendCounts[rr];
+    recvOffsets[rr+1] = recvOffsets[rr] + recvCounts[rr];
+  }
+
+  const int Nrequests = recvOffsets[size];
+  memory<hlong> requests(Nrequests);
+  comm.Alltoallv(vids, sendCounts, sendOffsets,
+                 requests, recvCounts, recvOffsets);
+
+  /*Reply with coordinates*/
+  memory<dfloat> replies(Nrequests*Ncoords);
+  #pragma omp parallel for
+  for (int n=0;n<Nrequests;++n) {
+    const hlong id = requests[n] - nodeStarts[rank];
+    for (int d=0;d<Ncoords;++d) {
+      replies[n*Ncoords+d] = localV[id*Ncoords+d];
+    }
+  }
+  localV.clear(); localV.shrink_to_fit();
+
+  for (int rr=0;rr<size;++rr) {
+    sendCounts[rr] *= Ncoords; sendOffsets[rr] *= Ncoords;
+    recvCounts[rr] *= Ncoords; recvOffsets[rr] *= Ncoords;
+  }
+  memory<dfloat> coords(Nvids*Ncoords);
+  comm.Alltoallv(replies, recvCounts, recvOffsets,
+                 coords, sendCounts, sendOffsets);
+
+  /*Collect vertices for each element*/
+  EX.malloc(Nverts*Nelements);
+  EY.malloc(Nverts*Nelements);
+  if (dim==3) EZ.malloc(Nverts*Nelements);
+
+  #pragma omp parallel for
+  for (dlong e=0;e<Nelements;++e) {
+    for (int v=0;v<Nverts;++v) {
+      const dlong id = static_cast<dlong>(std::lower_bound(vids.ptr(), vids.ptr()+Nvids, EToV[e*Nverts+v])
+                                          - vids.ptr());
+      EX[e*Nverts+v] = coords[id*Ncoords+0];
+      EY[e*Nverts+v] = coords[id*Ncoords+1];
+      if (dim==3) EZ[e*Nverts+v] = coords[id*Ncoords+2];
+    }
+  }
+
+  /*Fix orientation of planar elements, as the serial readers do*/
+  if (dim==2) {
+    //vertex pair to swap for negatively oriented elements
+    const int va = 1;
+    const int vb = (elementType==Mesh::TRIANGLES) ? 2 : 3;
+
+    #pragma omp parallel for
+    for (dlong e=0;e<Nelements;++e) {
+      const dfloat xe1 = EX[e*Nverts+0], xea = EX[e*Nverts+va], xeb = EX[e*Nverts+vb];
+      const dfloat ye1 = EY[e*Nverts+0], yea = EY[e*Nverts+va], yeb = EY[e*Nverts+vb];
+      const dfloat J = 0.25*((xea-xe1)*(yeb-ye1) - (xeb-xe1)*(yea-ye1));
+      if (J<0) {
+        std::swap(EToV[e*Nverts+va], EToV[e*Nverts+vb]);
+        std::swap(EX[e*Nverts+va], EX[e*Nverts+vb]);
+        std::swap(EY[e*Nverts+va], EY[e*Nverts+vb]);
+      }
+    }
+  }
+
+  timePoint_t timeEnd = GlobalTime(comm);
+
+  if (rank==0) {
+    printf("-----------------------------------------------------------------------------------------------\n");
+    printf("   Mesh read:   %12lld elements, %12lld nodes, %12lld boundary faces              |\n",
+           static_cast<long long int>(NelementsTotal),
+           static_cast<long long int>(Nnodes),
+           static_cast<long long int>(NboundaryFaces));
+    printf("   Mesh read time:     %5.2f seconds (file %5.2f, parse %5.2f, redistribute %5.2f)              |\n",
+           ElapsedTime(timeStart, timeEnd),
+           ElapsedTime(timeStart, timeRead),
+           ElapsedTime(timeRead, timeParse),
+           ElapsedTime(timeParse, timeEnd));
+  }
+
+  LIBP_ABORT("Error reading mesh file: " << fileName << ", found "
+             << NelementsTotal << " elements out of " << gNelements << " entries",
+             NelementsTotal==0 || NelementsTotal>gNelements);
+}
+
+} //namespace libp
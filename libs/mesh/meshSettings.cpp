@@ -45,8 +45,15 @@ meshSettings_t::meshSettings_t(comm_t _comm):
              {"3","4","6","12"});
   newSetting("ELEMENT MAP",
              "ISOPARAMETRIC",
-             "Type mapping used to transform each element",
-             {"ISOPARAMETRIC","AFFINE"});
+             "Type mapping used to transform each element (TRILINEAR: hexes compute geometric factors from their vertices)",
+             {"ISOPARAMETRIC","AFFINE","TRILINEAR"});
+  newSetting("MESH FILE READER",
+             "SERIAL",
+             "Gmsh reader. MPIIO reads disjoint parts of the mesh file collectively on all ranks",
+             {"SERIAL","MPIIO"});
+  newSetting("MESH CACHE FILE",
+             "NONE",
+             "Prefix of per-rank binary files caching the partitioned and connected mesh. Rebuilt when the mesh file, BOX or PARADOGS settings change");
 
   newSetting("BOX DIMX",
              "10",
@@ -87,6 +94,15 @@ meshSettings_t::meshSettings_t(comm_t _comm):
              "Degree of polynomial finite element space",
              {"1","2","3","4","5","6","7","8","9","10","11","12","13","14","15"});
 
+  newSetting("OUTPUT FILE FORMAT",
+             "APPENDED",
+             "Encoding of VTU field output files",
+             {"ASCII","BINARY","APPENDED"});
+  newSetting("OUTPUT ASYNC",
+             "FALSE",
+             "Write VTU field output files on a host thread while the solver continues",
+             {"TRUE","FALSE"});
+
   paradogs::AddSettings(*this);
 }
 
@@ -94,8 +110,11 @@ void meshSettings_t::report() {
 
   if (comm.rank()==0) {
     std::cout << "Mesh Settings:\n\n";
-    if (!compareSetting("MESH FILE","BOX"))
+    if (!compareSetting("MESH FILE","BOX")) {
       reportSetting("MESH FILE");
+      reportSetting("MESH FILE READER");
+      reportSetting("MESH CACHE FILE");
+    }
 
     reportSetting("MESH DIMENSION");
     reportSetting("ELEMENT TYPE");
@@ -129,6 +148,8 @@ void meshSettings_t::report() {
     }
 
     reportSetting("POLYNOMIAL DEGREE");
+    reportSetting("OUTPUT FILE FORMAT");
+    reportSetting("OUTPUT ASYNC");
 
     if (!compareSetting("MESH FILE","BOX")) {
       paradogs::ReportSettings(*this);
@@ -52,29 +52,54 @@ void mesh_t::Setup(platform_t& _platform, meshSettings_t& _settings,
   std::string fileName;
   settings.getSetting("MESH FILE", fileName);
 
+  settings.getSetting("POLYNOMIAL DEGREE", N);
+
+  //reuse a partitioned and connected mesh from a previous run
+  std::string cacheName;
+  settings.getSetting("MESH CACHE FILE", cacheName);
+  const bool useCache = !settings.compareSetting("MESH CACHE FILE","NONE")
+                        && !settings.compareSetting("MESH FILE","PMLBOX");
+  const uint64_t cacheKey = useCache ? CacheKey() : 0;
+  bool cacheLoaded = false;
+
   if (settings.compareSetting("MESH FILE","PMLBOX")) {
     //build a box mesh with a pml layer
     SetupPmlBox();
-  } else if (settings.compareSetting("MESH FILE","BOX")) {
-    //build a box mesh
-    SetupBox();
   } else {
-    // read chunk of elements from file
-    ReadGmsh(fileName);
-
-    // partition elements using parAdogs
-    Partition();
+    if (useCache) cacheLoaded = ReadCache(cacheName, fileName, cacheKey);
+
+    if (!cacheLoaded) {
+      if (settings.compareSetting("MESH FILE","BOX")) {
+        //build a box mesh
+        SetupBox();
+      } else {
+        // read chunk of elements from file
+        if (settings.compareSetting("MESH FILE READER","MPIIO")) {
+          ReadGmshParallel(fileName);
+        } else {
+          ReadGmsh(fileName);
+        }
+
+        // partition elements using parAdogs
+        Partition();
+      }
+    }
   }
 
   // load reference (r,s) element nodes
-  settings.getSetting("POLYNOMIAL DEGREE", N);
   ReferenceNodes();
 
-  // connect elements
-  Connect();
+  memory<hlong> connectedEToE;
+  if (!cacheLoaded) {
+    // connect elements
+    Connect();
 
-  // connect elements to boundary faces
-  ConnectBoundary();
+    // connect elements to boundary faces
+    ConnectBoundary();
+
+    // HaloSetup overwrites EToE, keep a copy for the cache
+    if (useCache) connectedEToE = EToE.clone();
+  }
 
   // set up halo exchange info for MPI (do before connect face nodes)
   HaloSetup();
@@ -85,8 +110,12 @@ void mesh_t::Setup(platform_t& _platform, meshSettings_t& _settings,
   // connect face nodes
   ConnectFaceNodes();
 
-  // make global indexing
-  ConnectNodes();
+  if (!cacheLoaded) {
+    // make global indexing
+    ConnectNodes();
+
+    if (useCache) WriteCache(cacheName, fileName, cacheKey, connectedEToE);
+  }
 
   // compute physical (x,y) locations of the element nodes
   PhysicalNodes();
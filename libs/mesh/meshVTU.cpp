@@ -0,0 +1,421 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+#include "mesh/meshVTU.hpp"
+
+namespace libp {
+
+static const char* ByteOrder() {
+  const int one = 1;
+  return (*reinterpret_cast<const char*>(&one)==1) ? "LittleEndian" : "BigEndian";
+}
+
+static const char* FormatString(const Mesh::VTUFormat format) {
+  switch (format) {
+    case Mesh::ASCII:    return "ascii";
+    case Mesh::BINARY:   return "binary";
+    case Mesh::APPENDED: return "appended";
+  }
+  return "ascii";
+}
+
+/*base64 encode a stream of bytes, carrying partial triplets between calls*/
+class base64Stream_t {
+ private:
+  FILE* fp;
+  unsigned char buf[3];
+  int Nbuf=0;
+
+  static constexpr const char table[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  void Encode(const unsigned char* in, const int n, char* out) {
+    out[0] = table[in[0] >> 2];
+    out[1] = table[((in[0] & 0x03) << 4) | ((n>1 ? in[1] : 0) >> 4)];
+    out[2] = (n>1) ? table[((in[1] & 0x0f) << 2) | ((n>2 ? in[2] : 0) >> 6)] : '=';
+    out[3] = (n>2) ? table[in[2] & 0x3f] : '=';
+  }
+
+ public:
+  base64Stream_t(FILE* _fp): fp(_fp) {}
+
+  void Write(const void* data, const size_t bytes) {
+    const unsigned char* in = static_cast<const unsigned char*>(data);
+    size_t n=0;
+
+    //finish a partial triplet
+    while (Nbuf>0 && Nbuf<3 && n<bytes) buf[Nbuf++] = in[n++];
+    if (Nbuf==3) {
+      char out[4];
+      Encode(buf, 3, out);
+      fwrite(out, 1, 4, fp);
+      Nbuf=0;
+    }
+
+    //encode full triplets in chunks
+    constexpr size_t chunk = 3*4096;
+    char out[4*chunk/3];
+    while (bytes-n >= 3) {
+      const size_t Nin = std::min(chunk, ((bytes-n)/3)*3);
+      for (size_t i=0;i<Nin/3;++i) {
+        Encode(in+n+3*i, 3, out+4*i);
+      }
+      fwrite(out, 1, 4*Nin/3, fp);
+      n += Nin;
+    }
+
+    //save remainder
+    while (n<bytes) buf[Nbuf++] = in[n++];
+  }
+
+  void Flush() {
+    if (Nbuf>0) {
+      char out[4];
+      Encode(buf, Nbuf, out);
+      fwrite(out, 1, 4, fp);
+      Nbuf=0;
+    }
+  }
+};
+
+constexpr const char base64Stream_t::table[];
+
+void vtuWriter_t::Setup(mesh_t& _mesh) {
+
+  mesh = _mesh;
+
+  if (mesh.settings.compareSetting("OUTPUT FILE FORMAT", "ASCII")) {
+    format = Mesh::ASCII;
+  } else if (mesh.settings.compareSetting("OUTPUT FILE FORMAT", "BINARY")) {
+    format = Mesh::BINARY;
+  } else {
+    format = Mesh::APPENDED;
+  }
+
+  async = mesh.settings.compareSetting("OUTPUT ASYNC", "TRUE");
+
+  const dlong Nelements = mesh.Nelements;
+  const int plotNp = mesh.plotNp;
+  const int plotNverts = mesh.plotNverts;
+  const int plotNelements = mesh.plotNelements;
+
+  //interpolate node coordinates to the plot nodes
+  points.malloc(3*Nelements*plotNp);
+
+  #pragma omp parallel
+  {
+    const int Nscratch = std::max(mesh.Np, plotNp);
+    memory<dfloat> scratch(2*Nscratch);
+    memory<dfloat> Ix(plotNp), Iy(plotNp), Iz(plotNp, 0.0);
+
+    #pragma omp for
+    for (dlong e=0;e<Nelements;++e) {
+      mesh.PlotInterp(mesh.x + e*mesh.Np, Ix, scratch);
+      mesh.PlotInterp(mesh.y + e*mesh.Np, Iy, scratch);
+      if (mesh.dim==3)
+        mesh.PlotInterp(mesh.z + e*mesh.Np, Iz, scratch);
+
+      for (int n=0;n<plotNp;++n) {
+        const size_t id = 3*(static_cast<size_t>(e)*plotNp + n);
+        points[id+0] = static_cast<float>(Ix[n]);
+        points[id+1] = static_cast<float>(Iy[n]);
+        points[id+2] = static_cast<float>(Iz[n]);
+      }
+    }
+  }
+
+  //plot element connectivity
+  connectivity.malloc(Nelements*plotNelements*plotNverts);
+  offsets.malloc(Nelements*plotNelements);
+  types.malloc(Nelements*plotNelements);
+
+  const unsigned char cellType = (mesh.dim==2) ? 5 : 10; //VTK_TRIANGLE or VTK_TETRA
+
+  #pragma omp parallel for
+  for (dlong e=0;e<Nelements;++e) {
+    for (int n=0;n<plotNelements;++n) {
+      const dlong id = e*plotNelements + n;
+      for (int m=0;m<plotNverts;++m) {
+        connectivity[id*plotNverts+m] = e*plotNp + mesh.plotEToV[n*plotNverts+m];
+      }
+      offsets[id] = (id+1)*plotNverts;
+      types[id] = cellType;
+    }
+  }
+
+  setup = true;
+}
+
+void vtuWriter_t::AddPointData(const std::string name,
+                               const memory<dfloat> q,
+                               const int Ncomponents,
+                               const int Nfields,
+                               const int fieldOffset) {
+
+  LIBP_ABORT("vtuWriter_t not initialized", !setup);
+
+  const dlong Nelements = mesh.Nelements;
+  const int Np = mesh.Np;
+  const int plotNp = mesh.plotNp;
+
+  field_t field;
+  field.name = name;
+  field.Ncomponents = Ncomponents;
+  field.data.malloc(static_cast<size_t>(Nelements)*plotNp*Ncomponents);
+
+  #pragma omp parallel
+  {
+    const int Nscratch = std::max(Np, plotNp);
+    memory<dfloat> scratch(2*Nscratch);
+    memory<dfloat> Iq(plotNp);
+
+    #pragma omp for
+    for (dlong e=0;e<Nelements;++e) {
+      for (int c=0;c<Ncomponents;++c) {
+        const size_t offset = (static_cast<size_t>(e)*Nfields + fieldOffset + c)*Np;
+        mesh.PlotInterp(q + offset, Iq, scratch);
+
+        for (int n=0;n<plotNp;++n) {
+          const size_t id = (static_cast<size_t>(e)*plotNp + n)*Ncomponents + c;
+          field.data[id] = static_cast<float>(Iq[n]);
+        }
+      }
+    }
+  }
+
+  fields.push_back(field);
+}
+
+void vtuWriter_t::Write(const std::string name, const int frame) {
+
+  LIBP_ABORT("vtuWriter_t not initialized", !setup);
+
+  //wait for the previous frame to land before starting a new one
+  Finish();
+
+  char pieceName[BUFSIZ];
+  char indexName[BUFSIZ];
+  if (frame<0) {
+    sprintf(pieceName, "%s_%04d.vtu", name.c_str(), mesh.rank);
+    sprintf(indexName, "%s.pvtu", name.c_str());
+  } else {
+    sprintf(pieceName, "%s_%04d_%04d.vtu", name.c_str(), mesh.rank, frame);
+    sprintf(indexName, "%s_%04d.pvtu", name.c_str(), frame);
+  }
+
+  //hand the staged fields to the writer
+  std::vector<field_t> frameFields;
+  frameFields.swap(fields);
+
+  const int rank = mesh.rank;
+  const int size = mesh.size;
+  const std::string piece(pieceName);
+  const std::string index(indexName);
+  const std::string pieceBase(name);
+  const Mesh::VTUFormat fmt = format;
+  const memory<float> _points = points;
+  const memory<int> _connectivity = connectivity;
+  const memory<int> _offsets = offsets;
+  const memory<unsigned char> _types = types;
+
+  auto write = [=]() {
+    WritePiece(piece, fmt, _points, _connectivity, _offsets, _types, frameFields);
+    if (rank==0) WriteIndex(index, pieceBase, size, frame, frameFields);
+  };
+
+  if (async) {
+    writeThread = std::shared_ptr<std::thread>(new std::thread(write),
+                                               [](std::thread* t) {
+                                                 t->join();
+                                                 delete t;
+                                               });
+  } else {
+    write();
+  }
+}
+
+void vtuWriter_t::Finish() {
+  writeThread = nullptr;
+}
+
+template<typename T>
+static void WriteAsciiArray(FILE* fp, const memory<T> data, const int Ncomponents) {
+  const size_t N = data.length()/Ncomponents;
+  for (size_t n=0;n<N;++n) {
+    fprintf(fp, "       ");
+    for (int c=0;c<Ncomponents;++c) {
+      fprintf(fp, " %g", static_cast<double>(data[n*Ncomponents+c]));
+    }
+    fprintf(fp, "\n");
+  }
+}
+
+void vtuWriter_t::WritePiece(const std::string fileName,
+                             const Mesh::VTUFormat format,
+                             const memory<float> points,
+                             const memory<int> connectivity,
+                             const memory<int> offsets,
+                             const memory<unsigned char> types,
+                             const std::vector<field_t> fields) {
+
+  FILE *fp = fopen(fileName.c_str(), "w");
+  LIBP_ABORT("Failed to open file " << fileName << " for writing", fp==nullptr);
+
+  const size_t Npoints = points.length()/3;
+  const size_t Ncells = types.length();
+
+  //all arrays in the order they appear in the file
+  struct array_t {
+    std::string header;
+    const void* ptr;
+    uint64_t bytes;
+  };
+  std::vector<array_t> arrays;
+
+  for (const field_t& field: fields) {
+    std::stringstream ss;
+    ss << "type=\"Float32\" Name=\"" << field.name
+       << "\" NumberOfComponents=\"" << field.Ncomponents << "\"";
+    arrays.push_back({ss.str(), field.data.ptr(), field.data.size()});
+  }
+  arrays.push_back({"type=\"Float32\" NumberOfComponents=\"3\"", points.ptr(), points.size()});
+  arrays.push_back({"type=\"Int32\" Name=\"connectivity\"", connectivity.ptr(), connectivity.size()});
+  arrays.push_back({"type=\"Int32\" Name=\"offsets\"", offsets.ptr(), offsets.size()});
+  arrays.push_back({"type=\"UInt8\" Name=\"types\"", types.ptr(), types.size()});
+
+  const size_t Nfields = fields.size();
+
+  uint64_t appendOffset = 0;
+  auto writeArray = [&](const size_t a) {
+    fprintf(fp, "        <DataArray %s format=\"%s\"", arrays[a].header.c_str(), FormatString(format));
+
+    if (format==Mesh::APPENDED) {
+      fprintf(fp, " offset=\"%llu\"/>\n", static_cast<unsigned long long>(appendOffset));
+      appendOffset += sizeof(uint64_t) + arrays[a].bytes;
+      return;
+    }
+
+    fprintf(fp, ">\n");
+    if (format==Mesh::BINARY) {
+      base64Stream_t stream(fp);
+      stream.Write(&(arrays[a].bytes), sizeof(uint64_t));
+      stream.Write(arrays[a].ptr, arrays[a].bytes);
+      stream.Flush();
+      fprintf(fp, "\n");
+    } else {
+      if (a<Nfields) {
+        WriteAsciiArray(fp, fields[a].data, fields[a].Ncomponents);
+      } else if (a==Nfields) {
+        WriteAsciiArray(fp, points, 3);
+      } else if (a==Nfields+1) {
+        WriteAsciiArray(fp, connectivity, connectivity.length()/std::max(Ncells, size_t(1)));
+      } else if (a==Nfields+2) {
+        WriteAsciiArray(fp, offsets, 1);
+      } else {
+        WriteAsciiArray(fp, types, 1);
+      }
+    }
+    fprintf(fp, "        </DataArray>\n");
+  };
+
+  fprintf(fp, "<?xml version=\"1.0\"?>\n");
+  fprintf(fp, "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\">\n", ByteOrder());
+  fprintf(fp, "  <UnstructuredGrid>\n");
+  fprintf(fp, "    <Piece NumberOfPoints=\"%zu\" NumberOfCells=\"%zu\">\n", Npoints, Ncells);
+
+  fprintf(fp, "      <PointData>\n");
+  for (size_t a=0;a<Nfields;++a) writeArray(a);
+  fprintf(fp, "      </PointData>\n");
+
+  fprintf(fp, "      <Points>\n");
+  writeArray(Nfields);
+  fprintf(fp, "      </Points>\n");
+
+  fprintf(fp, "      <Cells>\n");
+  writeArray(Nfields+1);
+  writeArray(Nfields+2);
+  writeArray(Nfields+3);
+  fprintf(fp, "      </Cells>\n");
+
+  fprintf(fp, "    </Piece>\n");
+  fprintf(fp, "  </UnstructuredGrid>\n");
+
+  if (format==Mesh::APPENDED) {
+    fprintf(fp, "  <AppendedData encoding=\"raw\">\n_");
+    for (const array_t& array: arrays) {
+      fwrite(&(array.bytes), sizeof(uint64_t), 1, fp);
+      fwrite(array.ptr, 1, array.bytes, fp);
+    }
+    fprintf(fp, "\n  </AppendedData>\n");
+  }
+
+  fprintf(fp, "</VTKFile>\n");
+  fclose(fp);
+}
+
+void vtuWriter_t::WriteIndex(const std::string fileName,
+                             const std::string pieceBase,
+                             const int size,
+                             const int frame,
+                             const std::vector<field_t> fields) {
+
+  FILE *fp = fopen(fileName.c_str(), "w");
+  LIBP_ABORT("Failed to open file " << fileName << " for writing", fp==nullptr);
+
+  //pieces are referenced relative to the index file
+  const size_t slash = pieceBase.find_last_of('/');
+  const std::string base = (slash==std::string::npos) ? pieceBase
+                                                      : pieceBase.substr(slash+1);
+
+  fprintf(fp, "<?xml version=\"1.0\"?>\n");
+  fprintf(fp, "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\">\n", ByteOrder());
+  fprintf(fp, "  <PUnstructuredGrid GhostLevel=\"0\">\n");
+
+  fprintf(fp, "    <PPointData>\n");
+  for (const field_t& field: fields) {
+    fprintf(fp, "      <PDataArray type=\"Float32\" Name=\"%s\" NumberOfComponents=\"%d\"/>\n",
+            field.name.c_str(), field.Ncomponents);
+  }
+  fprintf(fp, "    </PPointData>\n");
+
+  fprintf(fp, "    <PPoints>\n");
+  fprintf(fp, "      <PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n");
+  fprintf(fp, "    </PPoints>\n");
+
+  for (int r=0;r<size;++r) {
+    if (frame<0)
+      fprintf(fp, "    <Piece Source=\"%s_%04d.vtu\"/>\n", base.c_str(), r);
+    else
+      fprintf(fp, "    <Piece Source=\"%s_%04d_%04d.vtu\"/>\n", base.c_str(), r, frame);
+  }
+
+  fprintf(fp, "  </PUnstructuredGrid>\n");
+  fprintf(fp, "</VTKFile>\n");
+  fclose(fp);
+}
+
+} //namespace libp
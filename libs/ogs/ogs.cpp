@@ -88,7 +88,8 @@ void ogs_t::GatherScatterFinish(deviceMemory<T> o_v,
                                 const Transpose trans){
 
   //queue local gs operation
-  gatherLocal->GatherScatter(o_v, k, op, trans);
+  if (!fused)
+    gatherLocal->GatherScatter(o_v, k, op, trans);
 
   deviceMemory<T> o_haloBuf = exchange->o_workspace;
 
@@ -119,7 +120,10 @@ void ogs_t::GatherScatterFinish(deviceMemory<T> o_v,
   }
 
   //write exchanged halo buffer back to vector
-  gatherHalo->Scatter(o_v, o_haloBuf, k, trans);
+  if (fused)
+    gatherFused->GatherScatter(o_v, o_haloBuf, k, op, trans);
+  else
+    gatherHalo->Scatter(o_v, o_haloBuf, k, trans);
 }
 
 template
@@ -34,7 +34,9 @@ namespace libp {
 
 namespace ogs {
 
-static void DeviceExchangeTest(ogsExchange_t* exchange, double time[3]) {
+/* Time exchanges of k interleaved fields through the device buffer */
+static void DeviceExchangeTest(ogsExchange_t* exchange, double time[3],
+                               const int k=1) {
   const int Ncold = 10;
   const int Nhot  = 10;
   double localTime, sumTime, minTime, maxTime;
@@ -51,20 +53,20 @@ static void DeviceExchangeTest(ogsExchange_t* exchange, double time[3]) {
   for (int n=0;n<Ncold;++n) {
     if (exchange->gpu_aware) {
       /*GPU-aware exchange*/
-      exchange->Start (o_buf, 1, Add, Sym);
-      exchange->Finish(o_buf, 1, Add, Sym);
+      exchange->Start (o_buf, k, Add, Sym);
+      exchange->Finish(o_buf, k, Add, Sym);
     } else {
       //if not using gpu-aware mpi move the halo buffer to the host
-      o_buf.copyTo(buf, exchange->Nhalo,
+      o_buf.copyTo(buf, exchange->Nhalo*k,
                    0, properties_t("async", true));
       device.finish();
 
       /*MPI exchange of host buffer*/
-      exchange->Start (buf, 1, Add, Sym);
-      exchange->Finish(buf, 1, Add, Sym);
+      exchange->Start (buf, k, Add, Sym);
+      exchange->Finish(buf, k, Add, Sym);
 
       // copy recv back to device
-      o_buf.copyFrom(buf, exchange->Nhalo,
+      o_buf.copyFrom(buf, exchange->Nhalo*k,
                      0, properties_t("async", true));
       device.finish(); //wait for transfer to finish
     }
@@ -75,20 +77,20 @@ static void DeviceExchangeTest(ogsExchange_t* exchange, double time[3]) {
   for (int n=0;n<Nhot;++n) {
     if (exchange->gpu_aware) {
       /*GPU-aware exchange*/
-      exchange->Start (o_buf, 1, Add, Sym);
-      exchange->Finish(o_buf, 1, Add, Sym);
+      exchange->Start (o_buf, k, Add, Sym);
+      exchange->Finish(o_buf, k, Add, Sym);
     } else {
       //if not using gpu-aware mpi move the halo buffer to the host
-      o_buf.copyTo(buf, exchange->Nhalo,
+      o_buf.copyTo(buf, exchange->Nhalo*k,
                    0, properties_t("async", true));
       device.finish();
 
       /*MPI exchange of host buffer*/
-      exchange->Start (buf, 1, Add, Sym);
-      exchange->Finish(buf, 1, Add, Sym);
+      exchange->Start (buf, k, Add, Sym);
+      exchange->Finish(buf, k, Add, Sym);
 
       // copy recv back to device
-      o_buf.copyFrom(buf, exchange->Nhalo,
+      o_buf.copyFrom(buf, exchange->Nhalo*k,
                      0, properties_t("async", true));
       device.finish(); //wait for transfer to finish
     }
@@ -325,6 +327,103 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
             crystalHostTime[0], crystalHostTime[1], crystalHostTime[2]);
 #endif
 
+  /********************************
+   * Neighborhood collective
+   ********************************/
+  ogsExchange_t* neighbor = new ogsNeighborhood_t(Nshared, sharedNodes,
+                                                  _gatherHalo, dataStream,
+                                                  comm, platform);
+  //standard copy to host - exchange - copy back to device
+  neighbor->gpu_aware=false;
+
+  double neighborTime[3];
+  DeviceExchangeTest(neighbor, neighborTime);
+  double neighborAvg = neighborTime[0];
+
+#ifdef GPU_AWARE_MPI
+  //test GPU-aware exchange
+  neighbor->gpu_aware=true;
+
+  double neighborGATime[3];
+  DeviceExchangeTest(neighbor, neighborGATime);
+
+  if (neighborGATime[0] < neighborAvg)
+    neighborAvg = neighborGATime[0];
+  else
+    neighbor->gpu_aware=false;
+
+#endif
+
+  //test exchange from host memory (just for reporting)
+  double neighborHostTime[3];
+  HostExchangeTest(neighbor, neighborHostTime);
+
+  if (neighborAvg < bestTime) {
+    delete bestExchange;
+    bestExchange = neighbor;
+    method = Neighborhood;
+    bestTime = neighborAvg;
+  } else {
+    delete neighbor;
+  }
+
+#ifdef GPU_AWARE_MPI
+  if (rank==0 && verbose)
+    printf("   Neighborhood   %5.3e %5.3e %5.3e    %5.3e %5.3e %5.3e    %5.3e %5.3e %5.3e \n",
+            neighborTime[0],     neighborTime[1],     neighborTime[2],
+            neighborGATime[0],   neighborGATime[1],   neighborGATime[2],
+            neighborHostTime[0], neighborHostTime[1], neighborHostTime[2]);
+#else
+  if (rank==0 && verbose)
+    printf("   Neighborhood   %5.3e %5.3e %5.3e    %5.3e %5.3e %5.3e \n",
+            neighborTime[0],     neighborTime[1],     neighborTime[2],
+            neighborHostTime[0], neighborHostTime[1], neighborHostTime[2]);
+#endif
+
+  /********************************
+   * Node-aware hierarchical
+   ********************************/
+  //only worth trying when some node holds more than one rank
+  int maxNodeSize = comm.SplitShared(rank).size();
+  comm.Allreduce(maxNodeSize, Comm::Max);
+
+  if (maxNodeSize>1) {
+    ogsExchange_t* hierarchical = new ogsHierarchical_t(Nshared, sharedNodes,
+                                                        _gatherHalo, dataStream,
+                                                        comm, platform);
+
+    //always staged through the host node window
+    double hierarchicalTime[3];
+    DeviceExchangeTest(hierarchical, hierarchicalTime);
+    double hierarchicalAvg = hierarchicalTime[0];
+
+    //test exchange from host memory (just for reporting)
+    double hierarchicalHostTime[3];
+    HostExchangeTest(hierarchical, hierarchicalHostTime);
+
+    if (hierarchicalAvg < bestTime) {
+      delete bestExchange;
+      bestExchange = hierarchical;
+      method = Hierarchical;
+      bestTime = hierarchicalAvg;
+    } else {
+      delete hierarchical;
+    }
+
+#ifdef GPU_AWARE_MPI
+    if (rank==0 && verbose)
+      printf("   Hierarchical   %5.3e %5.3e %5.3e    %-29s    %5.3e %5.3e %5.3e \n",
+              hierarchicalTime[0],     hierarchicalTime[1],     hierarchicalTime[2],
+              "n/a",
+              hierarchicalHostTime[0], hierarchicalHostTime[1], hierarchicalHostTime[2]);
+#else
+    if (rank==0 && verbose)
+      printf("   Hierarchical   %5.3e %5.3e %5.3e    %5.3e %5.3e %5.3e \n",
+              hierarchicalTime[0],     hierarchicalTime[1],     hierarchicalTime[2],
+              hierarchicalHostTime[0], hierarchicalHostTime[1], hierarchicalHostTime[2]);
+#endif
+  }
+
   if (rank==0 && verbose) {
     switch (method) {
       case AllToAll:
@@ -333,6 +432,10 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
         printf("   Exchange method selected: Pairwise"); break;
       case CrystalRouter:
         printf("   Exchange method selected: CrystalRouter"); break;
+      case Neighborhood:
+        printf("   Exchange method selected: Neighborhood"); break;
+      case Hierarchical:
+        printf("   Exchange method selected: Hierarchical"); break;
       default:
         break;
     }
@@ -340,10 +443,55 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
     printf("\n");
   }
 
+  if (verbose) {
+    //compare one batched exchange of several fields against one exchange per field
+    const int Nbatch = 3;
+    bestExchange->AllocBuffer(Nbatch*sizeof(dfloat));
+
+    double singleTime[3], batchTime[3];
+    DeviceExchangeTest(bestExchange, singleTime);
+    DeviceExchangeTest(bestExchange, batchTime, Nbatch);
+
+    if (rank==0)
+      printf("   Batched exchange of %d fields: %5.3e (%d separate exchanges: %5.3e) \n",
+             Nbatch, batchTime[0], Nbatch, Nbatch*singleTime[0]);
+  }
+
   return bestExchange;
 }
 
 
+/* Time the device GatherScatter with the local gather-scatter overlapping
+   the halo exchange against the fused single sweep after the exchange,
+   and keep the faster */
+void ogs_t::FusedAutoSetup(const bool verbose) {
+
+  fused = false;
+
+  //nothing to fuse without a halo
+  hlong NhaloGlobal = NhaloT;
+  comm.Allreduce(NhaloGlobal);
+  if (NhaloGlobal==0) return;
+
+  memory<dfloat> v(N, 0.0);
+  deviceMemory<dfloat> o_v = platform.malloc<dfloat>(v);
+
+  //Trigger JIT kernel builds
+  InitializeKernels(platform, ogs::Dfloat, ogs::Add);
+
+  const double splitTime = GatherScatterTime(o_v, 1);
+
+  fused = true;
+  const double fusedTime = GatherScatterTime(o_v, 1);
+
+  fused = (fusedTime < splitTime);
+
+  if (comm.rank()==0 && verbose) {
+    printf("   GatherScatter  split %5.3e  fused %5.3e \n", splitTime, fusedTime);
+    printf("   GatherScatter method selected: %s\n", fused ? "Fused" : "Split");
+  }
+}
+
 } //namespace ogs
 
 } //namespace libp
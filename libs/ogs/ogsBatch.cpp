@@ -0,0 +1,344 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "ogs.hpp"
+#include "ogs/ogsUtils.hpp"
+#include "ogs/ogsOperator.hpp"
+#include "ogs/ogsExchange.hpp"
+
+namespace libp {
+
+namespace ogs {
+
+/********************************
+ * Batched MPI exchange
+ ********************************/
+template<typename T>
+void ogsBase_t::ExchangeBatch(deviceMemory<T> o_haloBuf,
+                              const dlong Nsend,
+                              const dlong Nrecv,
+                              const dlong recvOffset,
+                              const int Nf,
+                              const Op op,
+                              const Transpose trans){
+  if (exchange->gpu_aware) {
+    exchange->Start (o_haloBuf, Nf, op, trans);
+    exchange->Finish(o_haloBuf, Nf, op, trans);
+  } else {
+    //get current stream
+    device_t &device = platform.device;
+    stream_t currentStream = device.getStream();
+
+    pinnedMemory<T> haloBuf = exchange->h_workspace;
+
+    //wait for o_haloBuf to be ready
+    device.finish();
+
+    //move the halo buffer to the host
+    device.setStream(dataStream);
+    haloBuf.copyFrom(o_haloBuf, Nsend*Nf,
+                     0, properties_t("async", true));
+    device.finish();
+
+    /*MPI exchange of host buffer*/
+    exchange->Start (haloBuf, Nf, op, trans);
+    exchange->Finish(haloBuf, Nf, op, trans);
+
+    // copy recv back to device
+    haloBuf.copyTo(o_haloBuf + recvOffset*Nf, Nrecv*Nf,
+                   recvOffset*Nf, properties_t("async", true));
+    device.finish(); //wait for transfer to finish
+    device.setStream(currentStream);
+  }
+}
+
+/********************************
+ * Batched Device GatherScatter
+ ********************************/
+template<typename T>
+void ogs_t::GatherScatter(std::vector<deviceMemory<T>>& o_vs,
+                          const Op op,
+                          const Transpose trans){
+  const int Nf = static_cast<int>(o_vs.size());
+  if (Nf==0) return;
+
+  exchange->AllocBuffer(Nf*sizeof(T));
+
+  deviceMemory<T> o_haloBuf = exchange->o_workspace;
+
+  //collect the halo values of every vector into one buffer
+  for (int f=0;f<Nf;++f) {
+    gatherHalo->GatherBatch(o_haloBuf, o_vs[f], Nf, f, op, trans);
+  }
+
+  //queue local gs operations
+  for (int f=0;f<Nf;++f) {
+    gatherLocal->GatherScatter(o_vs[f], 1, op, trans);
+  }
+
+  //one message per neighbor for the whole batch
+  const dlong Nsend = (trans == NoTrans) ? NhaloP : NhaloT;
+  const dlong Nrecv = (trans == Trans)   ? NhaloP : NhaloT;
+  ExchangeBatch(o_haloBuf, Nsend, Nrecv, 0, Nf, op, trans);
+
+  //write exchanged halo buffer back to the vectors
+  for (int f=0;f<Nf;++f) {
+    gatherHalo->ScatterBatch(o_vs[f], o_haloBuf, Nf, f, trans);
+  }
+}
+
+template
+void ogs_t::GatherScatter(std::vector<deviceMemory<float>>& o_vs,
+                          const Op op, const Transpose trans);
+template
+void ogs_t::GatherScatter(std::vector<deviceMemory<double>>& o_vs,
+                          const Op op, const Transpose trans);
+template
+void ogs_t::GatherScatter(std::vector<deviceMemory<int>>& o_vs,
+                          const Op op, const Transpose trans);
+template
+void ogs_t::GatherScatter(std::vector<deviceMemory<long long int>>& o_vs,
+                          const Op op, const Transpose trans);
+
+/********************************
+ * Batched Device Gather
+ ********************************/
+template<typename T>
+void ogs_t::Gather(std::vector<deviceMemory<T>>& o_gvs,
+                   std::vector<deviceMemory<T>>& o_vs,
+                   const Op op,
+                   const Transpose trans){
+  AssertGatherDefined();
+
+  LIBP_ABORT("Batched Gather called with " << o_gvs.size() << " output and "
+             << o_vs.size() << " input vectors",
+             o_gvs.size()!=o_vs.size());
+
+  const int Nf = static_cast<int>(o_vs.size());
+  if (Nf==0) return;
+
+  if (trans!=Trans) {
+    //if trans!=ogs::Trans theres no comms required
+    for (int f=0;f<Nf;++f) {
+      Gather(o_gvs[f], o_vs[f], 1, op, trans);
+    }
+    return;
+  }
+
+  constexpr Type type = ogsType<T>::get();
+  InitializeKernels(platform, type, op);
+
+  exchange->AllocBuffer(Nf*sizeof(T));
+
+  deviceMemory<T> o_haloBuf = exchange->o_workspace;
+
+  //collect the halo values of every vector into one buffer
+  for (int f=0;f<Nf;++f) {
+    gatherHalo->GatherBatch(o_haloBuf, o_vs[f], Nf, f, op, Trans);
+  }
+
+  //queue local g operations
+  for (int f=0;f<Nf;++f) {
+    gatherLocal->Gather(o_gvs[f], o_vs[f], 1, op, trans);
+  }
+
+  ExchangeBatch(o_haloBuf, NhaloT, NhaloP, 0, Nf, op, Trans);
+
+  //put the results at the end of each o_gv
+  if (NhaloP) {
+    for (int f=0;f<Nf;++f) {
+      ogsExchange_t::unpackBatchKernel[type](NhaloP, Nf, f,
+                                             o_haloBuf,
+                                             o_gvs[f] + NlocalT);
+    }
+  }
+}
+
+template
+void ogs_t::Gather(std::vector<deviceMemory<float>>& o_gvs,
+                   std::vector<deviceMemory<float>>& o_vs,
+                   const Op op, const Transpose trans);
+template
+void ogs_t::Gather(std::vector<deviceMemory<double>>& o_gvs,
+                   std::vector<deviceMemory<double>>& o_vs,
+                   const Op op, const Transpose trans);
+template
+void ogs_t::Gather(std::vector<deviceMemory<int>>& o_gvs,
+                   std::vector<deviceMemory<int>>& o_vs,
+                   const Op op, const Transpose trans);
+template
+void ogs_t::Gather(std::vector<deviceMemory<long long int>>& o_gvs,
+                   std::vector<deviceMemory<long long int>>& o_vs,
+                   const Op op, const Transpose trans);
+
+/********************************
+ * Batched Device Exchange
+ ********************************/
+template<typename T>
+void halo_t::Exchange(std::vector<deviceMemory<T>>& o_vs) {
+  const int Nf = static_cast<int>(o_vs.size());
+  if (Nf==0) return;
+
+  constexpr Type type = ogsType<T>::get();
+  InitializeKernels(platform, type, Add);
+
+  exchange->AllocBuffer(Nf*sizeof(T));
+
+  deviceMemory<T> o_haloBuf = exchange->o_workspace;
+
+  //collect the halo values of every vector into one buffer
+  for (int f=0;f<Nf;++f) {
+    if (gathered_halo) {
+      //if this halo was build from a gathered ogs the halo nodes are at the end
+      if (NhaloP)
+        ogsExchange_t::packBatchKernel[type](NhaloP, Nf, f,
+                                             o_vs[f] + NlocalT,
+                                             o_haloBuf);
+    } else {
+      gatherHalo->GatherBatch(o_haloBuf, o_vs[f], Nf, f, Add, NoTrans);
+    }
+  }
+
+  ExchangeBatch(o_haloBuf, NhaloP, Nhalo, NhaloP, Nf, Add, NoTrans);
+
+  //write exchanged halo buffer back to the vectors
+  for (int f=0;f<Nf;++f) {
+    if (gathered_halo) {
+      if (Nhalo)
+        ogsExchange_t::unpackBatchKernel[type](Nhalo, Nf, f,
+                                               o_haloBuf + Nf*NhaloP,
+                                               o_vs[f] + (NlocalT+NhaloP));
+    } else {
+      gatherHalo->ScatterBatch(o_vs[f], o_haloBuf, Nf, f, NoTrans);
+    }
+  }
+}
+
+template void halo_t::Exchange(std::vector<deviceMemory<float>>& o_vs);
+template void halo_t::Exchange(std::vector<deviceMemory<double>>& o_vs);
+template void halo_t::Exchange(std::vector<deviceMemory<int>>& o_vs);
+template void halo_t::Exchange(std::vector<deviceMemory<long long int>>& o_vs);
+
+/* Compare the batched device operations on several vectors against one
+   call per vector. The data is integer valued, so sums are exact in any
+   order and any difference is an error */
+void ogs_t::CheckBatch() {
+  const int Nf = 3;
+  const int rank = comm.rank();
+
+  std::vector<deviceMemory<dfloat>> o_vs(Nf);
+  std::vector<deviceMemory<dfloat>> o_ws(Nf);
+  memory<dfloat> v(N);
+  for (int f=0;f<Nf;++f) {
+    for (dlong n=0;n<N;++n) v[n] = static_cast<dfloat>((n+rank+f)%7 + 1);
+    o_vs[f] = platform.malloc<dfloat>(v);
+    o_ws[f] = platform.malloc<dfloat>(v);
+  }
+
+  dfloat maxDiff = 0.0;
+  auto Compare = [&](deviceMemory<dfloat>& o_a, deviceMemory<dfloat>& o_b,
+                     const dlong Nentries) {
+    memory<dfloat> a(Nentries), b(Nentries);
+    o_a.copyTo(a, Nentries);
+    o_b.copyTo(b, Nentries);
+    for (dlong n=0;n<Nentries;++n) maxDiff = std::max(maxDiff, std::abs(a[n]-b[n]));
+  };
+
+  GatherScatter(o_vs, Add, Sym);
+  for (int f=0;f<Nf;++f) GatherScatter(o_ws[f], 1, Add, Sym);
+  for (int f=0;f<Nf;++f) Compare(o_vs[f], o_ws[f], N);
+
+  if (gather_defined) {
+    const dlong Ng = NlocalT+NhaloT;
+    memory<dfloat> zeros(Ng, 0.0);
+
+    std::vector<deviceMemory<dfloat>> o_gvs(Nf);
+    std::vector<deviceMemory<dfloat>> o_gws(Nf);
+    for (int f=0;f<Nf;++f) {
+      o_gvs[f] = platform.malloc<dfloat>(zeros);
+      o_gws[f] = platform.malloc<dfloat>(zeros);
+    }
+
+    for (const Transpose trans : {NoTrans, Trans, Sym}) {
+      Gather(o_gvs, o_vs, Add, trans);
+      for (int f=0;f<Nf;++f) Gather(o_gws[f], o_vs[f], 1, Add, trans);
+      for (int f=0;f<Nf;++f) Compare(o_gvs[f], o_gws[f], NlocalT+NhaloP);
+    }
+
+    //the batched exchange of gathered vectors
+    halo_t gHalo;
+    gHalo.SetupFromGather(*this);
+    gHalo.CheckBatch();
+  }
+
+  comm.Allreduce(maxDiff, Comm::Max);
+
+  if (rank==0)
+    printf("   Batched gather-scatter check (%d fields): max difference %5.3e \n",
+           Nf, maxDiff);
+
+  LIBP_ABORT("Batched and separate gather-scatter results differ by " << maxDiff,
+             maxDiff>0.0);
+}
+
+/* Compare the batched device halo exchange against one exchange per vector */
+void halo_t::CheckBatch() {
+  const int Nf = 3;
+  const int rank = comm.rank();
+
+  std::vector<deviceMemory<dfloat>> o_vs(Nf);
+  std::vector<deviceMemory<dfloat>> o_ws(Nf);
+  memory<dfloat> v(N);
+  for (int f=0;f<Nf;++f) {
+    for (dlong n=0;n<N;++n) v[n] = static_cast<dfloat>((n+rank+f)%7 + 1);
+    o_vs[f] = platform.malloc<dfloat>(v);
+    o_ws[f] = platform.malloc<dfloat>(v);
+  }
+
+  Exchange(o_vs);
+  for (int f=0;f<Nf;++f) Exchange(o_ws[f], 1);
+
+  dfloat maxDiff = 0.0;
+  memory<dfloat> a(N), b(N);
+  for (int f=0;f<Nf;++f) {
+    o_vs[f].copyTo(a, N);
+    o_ws[f].copyTo(b, N);
+    for (dlong n=0;n<N;++n) maxDiff = std::max(maxDiff, std::abs(a[n]-b[n]));
+  }
+
+  comm.Allreduce(maxDiff, Comm::Max);
+
+  if (rank==0)
+    printf("   Batched halo exchange check (%d fields): max difference %5.3e \n",
+           Nf, maxDiff);
+
+  LIBP_ABORT("Batched and separate halo exchange results differ by " << maxDiff,
+             maxDiff>0.0);
+}
+
+} //namespace ogs
+
+} //namespace libp
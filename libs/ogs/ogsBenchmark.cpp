@@ -0,0 +1,168 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "ogs.hpp"
+#include "ogs/ogsOperator.hpp"
+#include "ogs/ogsExchange.hpp"
+#include "timer.hpp"
+
+namespace libp {
+
+namespace ogs {
+
+/* Average time of a device GatherScatter on k fields, max over ranks */
+double ogs_t::GatherScatterTime(deviceMemory<dfloat>& o_v, const int k) {
+  const int Ncold = 10;
+  const int Nhot  = 10;
+
+  for (int n=0;n<Ncold;++n) GatherScatter(o_v, k, Add, Sym);
+
+  timePoint_t start = GlobalPlatformTime(platform, comm);
+  for (int n=0;n<Nhot;++n) GatherScatter(o_v, k, Add, Sym);
+  timePoint_t end = GlobalPlatformTime(platform, comm);
+
+  double elapsed = ElapsedTime(start, end)/Nhot;
+  comm.Allreduce(elapsed, Comm::Max);
+  return elapsed;
+}
+
+/* Report effective bandwidth of the split and fused device GatherScatter
+   against a device copy of the same vector */
+void ogs_t::ReportThroughput(const int k) {
+
+  const int Nhot = 10;
+
+  const dlong Nk = N*k;
+  memory<dfloat> v(Nk, 1.0);
+  deviceMemory<dfloat> o_v = platform.malloc<dfloat>(v);
+  deviceMemory<dfloat> o_w = platform.malloc<dfloat>(v);
+
+  //STREAM-like bound: read and write every entry once
+  o_w.copyFrom(o_v, Nk);
+  timePoint_t start = GlobalPlatformTime(platform, comm);
+  for (int n=0;n<Nhot;++n) o_w.copyFrom(o_v, Nk);
+  timePoint_t end = GlobalPlatformTime(platform, comm);
+  double copyTime = ElapsedTime(start, end)/Nhot;
+  comm.Allreduce(copyTime, Comm::Max);
+
+  const bool fusedSelected = fused;
+
+  fused = false;
+  const double splitTime = GatherScatterTime(o_v, k);
+
+  fused = true;
+  const double fusedTime = GatherScatterTime(o_v, k);
+
+  fused = fusedSelected;
+
+  //each entry is read and written once, and every index is read once
+  // by the gather and once by the scatter
+  double bytes = 2.0*Nk*sizeof(dfloat)
+                + 2.0*(gatherLocal->nnzT + gatherHalo->nnzT)*sizeof(dlong)
+                + 2.0*(gatherLocal->NrowsT + gatherHalo->NrowsT)*sizeof(dlong);
+  double copyBytes = 2.0*Nk*sizeof(dfloat);
+  comm.Allreduce(bytes);
+  comm.Allreduce(copyBytes);
+
+  if (comm.rank()==0) {
+    printf("ogs GatherScatter (k=%d): split %5.3e s (%6.2f GB/s), fused %5.3e s (%6.2f GB/s), device copy %6.2f GB/s\n",
+           k,
+           splitTime, bytes/(1.0e9*splitTime),
+           fusedTime, bytes/(1.0e9*fusedTime),
+           copyBytes/(1.0e9*copyTime));
+  }
+}
+
+/* Report the rounding error and timing of the compressed device halo
+   exchange of o_v against the full precision exchange */
+void halo_t::ReportCompression(deviceMemory<dfloat>& o_v, const int k) {
+  const int Ncold = 10;
+  const int Nhot  = 10;
+
+  const dlong Nk = N*k;
+  deviceMemory<dfloat> o_full       = platform.malloc<dfloat>(Nk);
+  deviceMemory<dfloat> o_compressed = platform.malloc<dfloat>(Nk);
+  o_full.copyFrom(o_v, Nk);
+  o_compressed.copyFrom(o_v, Nk);
+
+  const bool compressedSelected = compressed;
+
+  compressed = false;
+  Exchange(o_full, k);
+  compressed = true;
+  Exchange(o_compressed, k);
+
+  //only the filled halo entries can differ
+  memory<dfloat> full(Nk);
+  memory<dfloat> rounded(Nk);
+  o_full.copyTo(full, Nk);
+  o_compressed.copyTo(rounded, Nk);
+
+  dfloat maxError = 0.0, maxValue = 0.0;
+  for (dlong n=0;n<Nk;++n) {
+    maxError = std::max(maxError, std::abs(full[n]-rounded[n]));
+    maxValue = std::max(maxValue, std::abs(full[n]));
+  }
+  comm.Allreduce(maxError, Comm::Max);
+  comm.Allreduce(maxValue, Comm::Max);
+
+  auto exchangeTime = [&](deviceMemory<dfloat>& o_q) {
+    for (int n=0;n<Ncold;++n) Exchange(o_q, k);
+
+    timePoint_t start = GlobalPlatformTime(platform, comm);
+    for (int n=0;n<Nhot;++n) Exchange(o_q, k);
+    timePoint_t end = GlobalPlatformTime(platform, comm);
+
+    double elapsed = ElapsedTime(start, end)/Nhot;
+    comm.Allreduce(elapsed, Comm::Max);
+    return elapsed;
+  };
+
+  compressed = false;
+  const double fullTime = exchangeTime(o_full);
+  compressed = true;
+  const double compressedTime = exchangeTime(o_compressed);
+
+  compressed = compressedSelected;
+
+  //payload sent per exchange, summed over ranks
+  hlong fullBytes = static_cast<hlong>(k)*NhaloP*sizeof(dfloat);
+  hlong compressedBytes = static_cast<hlong>(k)*NhaloP*sizeof(float);
+  comm.Allreduce(fullBytes);
+  comm.Allreduce(compressedBytes);
+
+  if (comm.rank()==0) {
+    printf("Halo compression (k=%d): max rounding error %5.3e (relative %5.3e)\n",
+           k, maxError, (maxValue>0.0) ? maxError/maxValue : 0.0);
+    printf("   full precision %5.3e s (%lld bytes), compressed %5.3e s (%lld bytes) per exchange\n",
+           fullTime, static_cast<long long int>(fullBytes),
+           compressedTime, static_cast<long long int>(compressedBytes));
+  }
+}
+
+} //namespace ogs
+
+} //namespace libp
@@ -44,6 +44,13 @@ void halo_t::Exchange(deviceMemory<T> o_v, const int k) {
 
 template<typename T>
 void halo_t::ExchangeStart(deviceMemory<T> o_v, const int k){
+  if constexpr (std::is_same_v<T, double>) {
+    if (compressed) {
+      CompressedExchangeStart(o_v, k);
+      return;
+    }
+  }
+
   exchange->AllocBuffer(k*sizeof(T));
 
   deviceMemory<T> o_haloBuf = exchange->o_workspace;
@@ -96,6 +103,12 @@ void halo_t::ExchangeStart(deviceMemory<T> o_v, const int k){
 
 template<typename T>
 void halo_t::ExchangeFinish(deviceMemory<T> o_v, const int k){
+  if constexpr (std::is_same_v<T, double>) {
+    if (compressed) {
+      CompressedExchangeFinish(o_v, k);
+      return;
+    }
+  }
 
   deviceMemory<T> o_haloBuf = exchange->o_workspace;
 
@@ -142,6 +155,103 @@ void halo_t::ExchangeFinish(deviceMemory<T> o_v, const int k){
   }
 }
 
+/********************************
+ * Compressed Device Exchange
+ ********************************/
+void halo_t::CompressedExchangeStart(deviceMemory<double> o_v, const int k){
+  InitializeKernels(platform, Double, Add);
+  //the exchange itself runs on float buffers, so a GPU-aware exchange
+  // needs the float extract kernel as well
+  InitializeKernels(platform, Float, Add);
+
+  //the workspace is sized for doubles, so it also holds the float buffer
+  exchange->AllocBuffer(k*sizeof(double));
+
+  deviceMemory<float> o_floatBuf = exchange->o_workspace;
+
+  if (gathered_halo) {
+    //if this halo was build from a gathered ogs the halo nodes are at the end
+    if (NhaloP)
+      ogsExchange_t::packFloatKernel(k*NhaloP, o_v + k*NlocalT, o_floatBuf);
+  } else {
+    //collect halo buffer at full precision
+    if (o_haloSpace.size() < k*NhaloT*sizeof(double))
+      o_haloSpace = platform.malloc<char>(k*NhaloT*sizeof(double));
+
+    deviceMemory<double> o_haloBuf = o_haloSpace;
+    gatherHalo->Gather(o_haloBuf, o_v, k, Add, NoTrans);
+
+    if (NhaloP)
+      ogsExchange_t::packFloatKernel(k*NhaloP, o_haloBuf, o_floatBuf);
+  }
+
+  if (exchange->gpu_aware) {
+    //prepare MPI exchange
+    exchange->Start(o_floatBuf, k, Add, NoTrans);
+  } else {
+    //get current stream
+    device_t &device = platform.device;
+    stream_t currentStream = device.getStream();
+
+    //if not using gpu-aware mpi move the halo buffer to the host
+    pinnedMemory<float> floatBuf = exchange->h_workspace;
+
+    //wait for o_floatBuf to be ready
+    device.finish();
+
+    //queue copy to host
+    device.setStream(dataStream);
+    floatBuf.copyFrom(o_floatBuf, NhaloP*k,
+                      0, properties_t("async", true));
+    device.setStream(currentStream);
+  }
+}
+
+void halo_t::CompressedExchangeFinish(deviceMemory<double> o_v, const int k){
+
+  deviceMemory<float> o_floatBuf = exchange->o_workspace;
+
+  if (exchange->gpu_aware) {
+    //finish MPI exchange
+    exchange->Finish(o_floatBuf, k, Add, NoTrans);
+  } else {
+    pinnedMemory<float> floatBuf = exchange->h_workspace;
+
+    //get current stream
+    device_t &device = platform.device;
+    stream_t currentStream = device.getStream();
+
+    //synchronize data stream to ensure the buffer is on the host
+    device.setStream(dataStream);
+    device.finish();
+
+    /*MPI exchange of host buffer*/
+    exchange->Start (floatBuf, k, Add, NoTrans);
+    exchange->Finish(floatBuf, k, Add, NoTrans);
+
+    // copy recv back to device
+    floatBuf.copyTo(o_floatBuf+k*NhaloP, k*Nhalo,
+                    k*NhaloP, properties_t("async", true));
+    device.finish(); //wait for transfer to finish
+    device.setStream(currentStream);
+  }
+
+  //widen the received halo values and write them back to the vector
+  if (gathered_halo) {
+    if (Nhalo)
+      ogsExchange_t::unpackFloatKernel(k*Nhalo, o_floatBuf + k*NhaloP,
+                                       o_v + k*(NlocalT+NhaloP));
+  } else {
+    //the owned entries of o_haloBuf still hold their full precision values
+    deviceMemory<double> o_haloBuf = o_haloSpace;
+    if (Nhalo)
+      ogsExchange_t::unpackFloatKernel(k*Nhalo, o_floatBuf + k*NhaloP,
+                                       o_haloBuf + k*NhaloP);
+
+    gatherHalo->Scatter(o_v, o_haloBuf, k, NoTrans);
+  }
+}
+
 template void halo_t::ExchangeStart(deviceMemory<float> o_v, const int k);
 template void halo_t::ExchangeStart(deviceMemory<double> o_v, const int k);
 template void halo_t::ExchangeStart(deviceMemory<int> o_v, const int k);
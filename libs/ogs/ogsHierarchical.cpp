@@ -0,0 +1,425 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "ogs.hpp"
+#include "ogs/ogsUtils.hpp"
+#include "ogs/ogsExchange.hpp"
+
+#ifdef GLIBCXX_PARALLEL
+#include <parallel/algorithm>
+using __gnu_parallel::sort;
+#else
+using std::sort;
+#endif
+
+namespace libp {
+
+namespace ogs {
+
+/**********************************
+* Host exchange
+***********************************/
+template<typename T>
+inline void ogsHierarchical_t::Start(pinnedMemory<T> &buf, const int k,
+                                     const Op op, const Transpose trans){
+
+  //write this rank's contribution to its segment of the node window
+  const dlong Nsend = (trans == NoTrans) ? NhaloP : Nhalo;
+  T* segment = reinterpret_cast<T*>(segments[nodeRank]);
+  std::copy(buf.ptr(), buf.ptr()+Nsend*k, segment);
+}
+
+template<typename T>
+inline void ogsHierarchical_t::Finish(pinnedMemory<T> &buf, const int k,
+                                      const Op op, const Transpose trans){
+
+  //wait for every rank on the node to fill its segment
+  MPI_Win_sync(window);
+  nodeComm.Barrier();
+  MPI_Win_sync(window);
+
+  if (leader) {
+    //collect the node's contributions
+    memory<T> nodeBuf = h_nodespace;
+    for (int r=0;r<nodeSize;r++) {
+      const dlong Nsend = (trans == NoTrans) ? segmentNhaloP[r] : segmentNhalo[r];
+      const T* segment = reinterpret_cast<const T*>(segments[r]);
+      std::copy(segment, segment+Nsend*k, nodeBuf.ptr()+segmentOffsets[r]*k);
+    }
+
+    //combine them within the node, then exchange the node totals between leaders
+    pinnedMemory<T> groupBuf = leaderExchange->h_workspace;
+    nodeGather.Gather(groupBuf, nodeBuf, k, op, trans);
+
+    leaderExchange->Start (groupBuf, k, op, Sym);
+    leaderExchange->Finish(groupBuf, k, op, Sym);
+
+    T* groupResults = reinterpret_cast<T*>(results);
+    std::copy(groupBuf.ptr(), groupBuf.ptr()+Ngroups*k, groupResults);
+  }
+
+  //wait for the leader to publish the combined groups
+  MPI_Win_sync(window);
+  nodeComm.Barrier();
+  MPI_Win_sync(window);
+
+  const T* groupResults = reinterpret_cast<const T*>(results);
+  T* buf_ptr = buf.ptr();
+  for (dlong n=0;n<Nhalo;n++) {
+    const dlong g = groupIds[n];
+    for (int j=0;j<k;j++) {
+      buf_ptr[j+n*k] = groupResults[j+g*k];
+    }
+  }
+}
+
+void ogsHierarchical_t::Start(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { Start<float>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(pinnedMemory<double> &buf, const int k, const Op op, const Transpose trans) { Start<double>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { Start<int>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Start<long long int>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { Finish<float>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(pinnedMemory<double> &buf, const int k, const Op op, const Transpose trans) { Finish<double>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { Finish<int>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Finish<long long int>(buf, k, op, trans); }
+
+/**********************************
+* Device exchange
+***********************************/
+// The node window lives in host memory, so device buffers are always
+// staged through the host, even when GPU-aware MPI is available
+template<typename T>
+void ogsHierarchical_t::Start(deviceMemory<T> &o_buf,
+                              const int k,
+                              const Op op,
+                              const Transpose trans){
+  pinnedMemory<T> buf = h_workspace;
+
+  const dlong Nsend = (trans == NoTrans) ? NhaloP : Nhalo;
+  if (Nsend) o_buf.copyTo(buf, Nsend*k);
+
+  Start(buf, k, op, trans);
+}
+
+template<typename T>
+void ogsHierarchical_t::Finish(deviceMemory<T> &o_buf,
+                               const int k,
+                               const Op op,
+                               const Transpose trans){
+  pinnedMemory<T> buf = h_workspace;
+
+  Finish(buf, k, op, trans);
+
+  if (Nhalo) o_buf.copyFrom(buf, Nhalo*k);
+}
+
+void ogsHierarchical_t::Start(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { Start<float>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(deviceMemory<double> &buf, const int k, const Op op, const Transpose trans) { Start<double>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { Start<int>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Start<long long int>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { Finish<float>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(deviceMemory<double> &buf, const int k, const Op op, const Transpose trans) { Finish<double>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { Finish<int>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Finish<long long int>(buf, k, op, trans); }
+
+ogsHierarchical_t::ogsHierarchical_t(dlong Nshared,
+                                     memory<parallelNode_t> &sharedNodes,
+                                     ogsOperator_t& gatherHalo,
+                                     stream_t _dataStream,
+                                     comm_t _comm,
+                                     platform_t &_platform):
+  ogsExchange_t(_platform,_comm,_dataStream) {
+
+  Nhalo  = gatherHalo.NrowsT;
+  NhaloP = gatherHalo.NrowsN;
+
+  //the window is in host memory, so this exchange is never GPU-aware
+  gpu_aware = false;
+
+  //group the ranks by node, and let the lowest rank on each node lead
+  nodeComm = comm.SplitShared(rank);
+  nodeRank = nodeComm.rank();
+  nodeSize = nodeComm.size();
+  leader = (nodeRank==0);
+
+  leaderComm = comm.Split((leader) ? 0 : 1, rank);
+
+  int nodeId = leaderComm.rank();
+  nodeComm.Bcast(nodeId, 0);
+
+  memory<int> rankNodes(size);
+  comm.Allgather(nodeId, rankNodes);
+
+  //label this rank's halo nodes, and list the other nodes sharing them
+  memory<parallelNode_t> haloNodes(Nhalo);
+  dlong Nremote=0;
+  for (dlong n=0;n<Nshared;n++) {
+    const dlong id = sharedNodes[n].newId;
+    haloNodes[id].baseId  = abs(sharedNodes[n].baseId);
+    haloNodes[id].localId = id;
+    haloNodes[id].sign    = (id<NhaloP) ? 2 : -2;
+    haloNodes[id].rank    = nodeRank;
+    if (rankNodes[sharedNodes[n].rank]!=nodeId) Nremote++;
+  }
+
+  memory<parallelNode_t> remoteNodes(Nremote);
+  Nremote=0;
+  for (dlong n=0;n<Nshared;n++) {
+    const int remoteNode = rankNodes[sharedNodes[n].rank];
+    if (remoteNode!=nodeId) {
+      remoteNodes[Nremote].baseId = abs(sharedNodes[n].baseId);
+      remoteNodes[Nremote].rank   = remoteNode;
+      Nremote++;
+    }
+  }
+  rankNodes.free();
+
+  //collect the node's halo nodes on the leader
+  segmentNhalo.malloc(nodeSize);
+  segmentNhaloP.malloc(nodeSize);
+  nodeComm.Gather(Nhalo,  segmentNhalo,  0);
+  nodeComm.Gather(NhaloP, segmentNhaloP, 0);
+
+  memory<int> remoteCount(nodeSize);
+  nodeComm.Gather(static_cast<int>(Nremote), remoteCount, 0);
+
+  memory<int> haloCounts(nodeSize);
+  memory<int> haloOffsets(nodeSize+1);
+  memory<int> remoteOffsets(nodeSize+1);
+  haloOffsets[0] = 0;
+  remoteOffsets[0] = 0;
+  if (leader) {
+    for (int r=0;r<nodeSize;r++) {
+      haloCounts[r] = static_cast<int>(segmentNhalo[r]);
+      haloOffsets[r+1] = haloOffsets[r] + haloCounts[r];
+      remoteOffsets[r+1] = remoteOffsets[r] + remoteCount[r];
+    }
+  }
+
+  NnodeHalo = haloOffsets[nodeSize];
+  memory<parallelNode_t> nodeHaloNodes(NnodeHalo);
+  memory<parallelNode_t> nodeRemoteNodes(remoteOffsets[nodeSize]);
+
+  nodeComm.Gatherv(haloNodes, static_cast<int>(Nhalo),
+                   nodeHaloNodes, haloCounts, haloOffsets, 0);
+  nodeComm.Gatherv(remoteNodes, static_cast<int>(Nremote),
+                   nodeRemoteNodes, remoteCount, remoteOffsets, 0);
+  remoteNodes.free();
+
+  memory<hlong> groupBaseIds;
+  if (leader) {
+    segmentOffsets.malloc(nodeSize+1);
+    for (int r=0;r<=nodeSize;r++) segmentOffsets[r] = haloOffsets[r];
+
+    //record where each node sits in the node's concatenated buffer
+    for (dlong n=0;n<NnodeHalo;n++) nodeHaloNodes[n].newId = n;
+
+    sort(nodeHaloNodes.ptr(), nodeHaloNodes.ptr()+NnodeHalo,
+         [](const parallelNode_t& a, const parallelNode_t& b) {
+           return a.baseId < b.baseId;
+         });
+
+    Ngroups=0;
+    for (dlong n=0;n<NnodeHalo;n++) {
+      if (n==0 || nodeHaloNodes[n].baseId!=nodeHaloNodes[n-1].baseId) Ngroups++;
+    }
+
+    //make op for gathering the node's contributions into groups
+    nodeGather.platform = platform;
+    nodeGather.kind = Signed;
+    nodeGather.Ncols  = NnodeHalo;
+    nodeGather.NrowsN = Ngroups;
+    nodeGather.NrowsT = Ngroups;
+    nodeGather.rowStartsN.calloc(Ngroups+1);
+    nodeGather.rowStartsT.calloc(Ngroups+1);
+
+    groupBaseIds.malloc(Ngroups);
+
+    dlong g=-1;
+    for (dlong n=0;n<NnodeHalo;n++) {
+      if (n==0 || nodeHaloNodes[n].baseId!=nodeHaloNodes[n-1].baseId) {
+        g++;
+        groupBaseIds[g] = nodeHaloNodes[n].baseId;
+      }
+      if (nodeHaloNodes[n].sign==2) nodeGather.rowStartsN[g+1]++;
+      nodeGather.rowStartsT[g+1]++;
+    }
+    for (dlong i=0;i<Ngroups;i++) {
+      nodeGather.rowStartsN[i+1] += nodeGather.rowStartsN[i];
+      nodeGather.rowStartsT[i+1] += nodeGather.rowStartsT[i];
+    }
+    nodeGather.nnzN = nodeGather.rowStartsN[Ngroups];
+    nodeGather.nnzT = nodeGather.rowStartsT[Ngroups];
+    nodeGather.colIdsN.calloc(nodeGather.nnzN);
+    nodeGather.colIdsT.calloc(nodeGather.nnzT);
+
+    //the groups are contiguous in the sorted list
+    dlong cntN=0;
+    for (dlong n=0;n<NnodeHalo;n++) {
+      if (nodeHaloNodes[n].sign==2) nodeGather.colIdsN[cntN++] = nodeHaloNodes[n].newId;
+      nodeGather.colIdsT[n] = nodeHaloNodes[n].newId;
+    }
+  }
+  nodeHaloNodes.free();
+
+  //share the group labels with the node
+  nodeComm.Bcast(Ngroups, 0);
+  if (!leader) groupBaseIds.malloc(Ngroups);
+  nodeComm.Bcast(groupBaseIds, 0);
+
+  auto findGroup = [&](const hlong baseId) {
+    const hlong* group = std::lower_bound(groupBaseIds.ptr(),
+                                          groupBaseIds.ptr()+Ngroups, baseId);
+    return static_cast<dlong>(group - groupBaseIds.ptr());
+  };
+
+  groupIds.malloc(Nhalo);
+  for (dlong n=0;n<Nhalo;n++) {
+    groupIds[n] = findGroup(haloNodes[n].baseId);
+  }
+  haloNodes.free();
+
+  leaderNhalo = Nhalo;
+  nodeComm.Bcast(leaderNhalo, 0);
+
+  if (leader) {
+    //the groups each other node shares with this one
+    const int Nnodes = leaderComm.size();
+    const dlong NnodeRemote = remoteOffsets[nodeSize];
+
+    sort(nodeRemoteNodes.ptr(), nodeRemoteNodes.ptr()+NnodeRemote,
+         [](const parallelNode_t& a, const parallelNode_t& b) {
+           if(a.rank < b.rank) return true; //group by node
+           if(a.rank > b.rank) return false;
+
+           return a.baseId < b.baseId;
+         });
+
+    memory<int> sendCounts(Nnodes,0);
+    memory<int> recvCounts(Nnodes);
+    memory<int> sendOffsets(Nnodes+1);
+    memory<int> recvOffsets(Nnodes+1);
+
+    dlong Nsend=0;
+    for (dlong n=0;n<NnodeRemote;n++) {
+      if (n>0 && nodeRemoteNodes[n].rank==nodeRemoteNodes[n-1].rank
+              && nodeRemoteNodes[n].baseId==nodeRemoteNodes[n-1].baseId) continue;
+
+      const int m = nodeRemoteNodes[n].rank;
+      nodeRemoteNodes[Nsend] = nodeRemoteNodes[n];
+      nodeRemoteNodes[Nsend].localId = findGroup(nodeRemoteNodes[n].baseId);
+      nodeRemoteNodes[Nsend].rank = nodeId;
+      sendCounts[m]++;
+      Nsend++;
+    }
+
+    leaderComm.Alltoall(sendCounts, recvCounts);
+
+    sendOffsets[0] = 0;
+    recvOffsets[0] = 0;
+    for (int m=0;m<Nnodes;m++) {
+      sendOffsets[m+1] = sendOffsets[m]+sendCounts[m];
+      recvOffsets[m+1] = recvOffsets[m]+recvCounts[m];
+    }
+
+    const dlong Nrecv = recvOffsets[Nnodes];
+    memory<parallelNode_t> leaderNodes(Nrecv);
+
+    leaderComm.Alltoallv(nodeRemoteNodes, sendCounts, sendOffsets,
+                         leaderNodes, recvCounts, recvOffsets);
+
+    //pair our group with the sending node's group
+    for (dlong n=0;n<Nrecv;n++) {
+      leaderNodes[n].newId = findGroup(leaderNodes[n].baseId);
+      leaderNodes[n].sign = 2;
+    }
+
+    //every group is in the halo of the leaders' exchange
+    ogsOperator_t groupHalo(platform);
+    groupHalo.NrowsN = Ngroups;
+    groupHalo.NrowsT = Ngroups;
+
+    leaderExchange = std::make_shared<ogsPairwise_t>(Nrecv, leaderNodes,
+                                                     groupHalo, dataStream,
+                                                     leaderComm, platform);
+  }
+  nodeRemoteNodes.free();
+
+  //make scratch space
+  AllocBuffer(sizeof(dfloat));
+}
+
+ogsHierarchical_t::~ogsHierarchical_t() {
+  if (window!=MPI_WIN_NULL) {
+    MPI_Win_unlock_all(window);
+    MPI_Win_free(&window);
+  }
+}
+
+void ogsHierarchical_t::AllocWindow(size_t Nbytes) {
+  if (window!=MPI_WIN_NULL) {
+    MPI_Win_unlock_all(window);
+    MPI_Win_free(&window);
+  }
+
+  //the leader's segment also holds the combined node groups
+  const MPI_Aint segmentBytes = (Nhalo + ((leader) ? Ngroups : 0))*Nbytes;
+
+  char* base;
+  MPI_Win_allocate_shared(segmentBytes, 1, MPI_INFO_NULL,
+                          nodeComm.comm(), &base, &window);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, window);
+
+  segments.malloc(nodeSize);
+  for (int r=0;r<nodeSize;r++) {
+    MPI_Aint bytes;
+    int dispUnit;
+    MPI_Win_shared_query(window, r, &bytes, &dispUnit, &segments[r]);
+  }
+  results = segments[0] + leaderNhalo*Nbytes;
+
+  windowNbytes = Nbytes;
+}
+
+void ogsHierarchical_t::AllocBuffer(size_t Nbytes) {
+  if (o_workspace.size() < Nhalo*Nbytes) {
+    h_workspace = platform.hostMalloc<char>(Nhalo*Nbytes);
+    o_workspace = platform.malloc<char>(Nhalo*Nbytes);
+  }
+
+  //every rank on the node asks for the same size, so this stays collective
+  if (windowNbytes < Nbytes) AllocWindow(Nbytes);
+
+  if (leader) {
+    if (h_nodespace.length() < NnodeHalo*Nbytes) {
+      h_nodespace.malloc(NnodeHalo*Nbytes);
+    }
+    leaderExchange->AllocBuffer(Nbytes);
+  }
+}
+
+} //namespace ogs
+
+} //namespace libp
@@ -333,6 +333,96 @@ template
 void ogsOperator_t::Scatter(deviceMemory<long long int> v, const deviceMemory<long long int> gv,
                             const int K, const Transpose trans);
 
+/********************************
+ * Batched Gather/Scatter Operations
+ ********************************/
+template<typename T>
+void ogsOperator_t::GatherBatch(deviceMemory<T> o_gv,
+                                deviceMemory<T> o_v,
+                                const int Nf,
+                                const int f,
+                                const Op op,
+                                const Transpose trans) {
+  constexpr Type type = ogsType<T>::get();
+  InitializeKernels(platform, type, op);
+
+  if (trans==NoTrans) {
+    if (NrowBlocksN)
+      gatherBatchKernel[type][op](NrowBlocksN,
+                                  Nf, f,
+                                  o_blockRowStartsN,
+                                  o_rowStartsN,
+                                  o_colIdsN,
+                                  o_v,
+                                  o_gv);
+  } else {
+    if (NrowBlocksT)
+      gatherBatchKernel[type][op](NrowBlocksT,
+                                  Nf, f,
+                                  o_blockRowStartsT,
+                                  o_rowStartsT,
+                                  o_colIdsT,
+                                  o_v,
+                                  o_gv);
+  }
+}
+
+template
+void ogsOperator_t::GatherBatch(deviceMemory<float> gv, const deviceMemory<float> v,
+                                const int Nf, const int f, const Op op, const Transpose trans);
+template
+void ogsOperator_t::GatherBatch(deviceMemory<double> gv, const deviceMemory<double> v,
+                                const int Nf, const int f, const Op op, const Transpose trans);
+template
+void ogsOperator_t::GatherBatch(deviceMemory<int> gv, const deviceMemory<int> v,
+                                const int Nf, const int f, const Op op, const Transpose trans);
+template
+void ogsOperator_t::GatherBatch(deviceMemory<long long int> gv, const deviceMemory<long long int> v,
+                                const int Nf, const int f, const Op op, const Transpose trans);
+
+template<typename T>
+void ogsOperator_t::ScatterBatch(deviceMemory<T> o_v,
+                                 deviceMemory<T> o_gv,
+                                 const int Nf,
+                                 const int f,
+                                 const Transpose trans) {
+  constexpr Type type = ogsType<T>::get();
+  InitializeKernels(platform, type, Add);
+
+  if (trans==Trans) {
+    if (NrowBlocksN)
+      scatterBatchKernel[type](NrowBlocksN,
+                               Nf, f,
+                               o_blockRowStartsN,
+                               o_rowStartsN,
+                               o_colIdsN,
+                               o_gv,
+                               o_v);
+  } else {
+    if (NrowBlocksT)
+      scatterBatchKernel[type](NrowBlocksT,
+                               Nf, f,
+                               o_blockRowStartsT,
+                               o_rowStartsT,
+                               o_colIdsT,
+                               o_gv,
+                               o_v);
+  }
+}
+
+template
+void ogsOperator_t::ScatterBatch(deviceMemory<float> v, const deviceMemory<float> gv,
+                                 const int Nf, const int f, const Transpose trans);
+template
+void ogsOperator_t::ScatterBatch(deviceMemory<double> v, const deviceMemory<double> gv,
+                                 const int Nf, const int f, const Transpose trans);
+template
+void ogsOperator_t::ScatterBatch(deviceMemory<int> v, const deviceMemory<int> gv,
+                                 const int Nf, const int f, const Transpose trans);
+template
+void ogsOperator_t::ScatterBatch(deviceMemory<long long int> v, const deviceMemory<long long int> gv,
+                                 const int Nf, const int f, const Transpose trans);
+
 /********************************
  * GatherScatter Operation
  ********************************/
@@ -444,38 +534,38 @@ void ogsOperator_t::GatherScatter(deviceMemory<T> o_v,
                                   const Op op,
                                   const Transpose trans) {
   constexpr Type type = ogsType<T>::get();
-  InitializeKernels(platform, type, Add);
+  InitializeKernels(platform, type, op);
 
   if (trans==Trans) {
     if (NrowBlocksT)
-      gatherScatterKernel[type][Add](NrowBlocksT,
-                                     k,
-                                     o_blockRowStartsT,
-                                     o_rowStartsT,
-                                     o_colIdsT,
-                                     o_rowStartsN,
-                                     o_colIdsN,
-                                     o_v);
+      gatherScatterKernel[type][op](NrowBlocksT,
+                                    k,
+                                    o_blockRowStartsT,
+                                    o_rowStartsT,
+                                    o_colIdsT,
+                                    o_rowStartsN,
+                                    o_colIdsN,
+                                    o_v);
   } else if (trans==Sym) {
     if (NrowBlocksT)
-      gatherScatterKernel[type][Add](NrowBlocksT,
-                                     k,
-                                     o_blockRowStartsT,
-                                     o_rowStartsT,
-                                     o_colIdsT,
-                                     o_rowStartsT,
-                                     o_colIdsT,
-                                     o_v);
+      gatherScatterKernel[type][op](NrowBlocksT,
+                                    k,
+                                    o_blockRowStartsT,
+                                    o_rowStartsT,
+                                    o_colIdsT,
+                                    o_rowStartsT,
+                                    o_colIdsT,
+                                    o_v);
   } else {
     if (NrowBlocksT)
-      gatherScatterKernel[type][Add](NrowBlocksT,
-                                     k,
-                                     o_blockRowStartsT,
-                                     o_rowStartsN,
-                                     o_colIdsN,
-                                     o_rowStartsT,
-                                     o_colIdsT,
-                                     o_v);
+      gatherScatterKernel[type][op](NrowBlocksT,
+                                    k,
+                                    o_blockRowStartsT,
+                                    o_rowStartsN,
+                                    o_colIdsN,
+                                    o_rowStartsT,
+                                    o_colIdsT,
+                                    o_v);
   }
 }
 
@@ -492,6 +582,62 @@ template
 void ogsOperator_t::GatherScatter(deviceMemory<long long int> v,const int k,
                                   const Op op, const Transpose trans);
 
+/********************************
+ * Fused GatherScatter Operation
+ ********************************/
+template<typename T>
+void ogsFusedOperator_t::GatherScatter(deviceMemory<T> o_v,
+                                       const deviceMemory<T> o_haloBuf,
+                                       const int k,
+                                       const Op op,
+                                       const Transpose trans) {
+  constexpr Type type = ogsType<T>::get();
+  InitializeKernels(platform, type, op);
+
+  ogsOperator_t& local = *gatherLocal;
+  ogsOperator_t& halo  = *gatherHalo;
+
+  //local rows are gathered and scattered as in ogsOperator_t::GatherScatter
+  deviceMemory<dlong> o_gatherStarts  = (trans==NoTrans) ? local.o_rowStartsN : local.o_rowStartsT;
+  deviceMemory<dlong> o_gatherIds     = (trans==NoTrans) ? local.o_colIdsN    : local.o_colIdsT;
+  deviceMemory<dlong> o_scatterStarts = (trans==Trans)   ? local.o_rowStartsN : local.o_rowStartsT;
+  deviceMemory<dlong> o_scatterIds    = (trans==Trans)   ? local.o_colIdsN    : local.o_colIdsT;
+
+  //halo rows are scattered as in ogsOperator_t::Scatter
+  const dlong NhaloBlocks = (trans==Trans) ? halo.NrowBlocksN : halo.NrowBlocksT;
+  deviceMemory<dlong> o_haloBlockStarts   = (trans==Trans) ? halo.o_blockRowStartsN : halo.o_blockRowStartsT;
+  deviceMemory<dlong> o_haloScatterStarts = (trans==Trans) ? halo.o_rowStartsN : halo.o_rowStartsT;
+  deviceMemory<dlong> o_haloScatterIds    = (trans==Trans) ? halo.o_colIdsN    : halo.o_colIdsT;
+
+  if (local.NrowBlocksT+NhaloBlocks)
+    fusedGatherScatterKernel[type][op](local.NrowBlocksT,
+                                       NhaloBlocks,
+                                       k,
+                                       local.o_blockRowStartsT,
+                                       o_gatherStarts,
+                                       o_gatherIds,
+                                       o_scatterStarts,
+                                       o_scatterIds,
+                                       o_haloBlockStarts,
+                                       o_haloScatterStarts,
+                                       o_haloScatterIds,
+                                       o_haloBuf,
+                                       o_v);
+}
+
+template
+void ogsFusedOperator_t::GatherScatter(deviceMemory<float> v, const deviceMemory<float> haloBuf,
+                                       const int k, const Op op, const Transpose trans);
+template
+void ogsFusedOperator_t::GatherScatter(deviceMemory<double> v, const deviceMemory<double> haloBuf,
+                                       const int k, const Op op, const Transpose trans);
+template
+void ogsFusedOperator_t::GatherScatter(deviceMemory<int> v, const deviceMemory<int> haloBuf,
+                                       const int k, const Op op, const Transpose trans);
+template
+void ogsFusedOperator_t::GatherScatter(deviceMemory<long long int> v, const deviceMemory<long long int> haloBuf,
+                                       const int k, const Op op, const Transpose trans);
+
 void ogsOperator_t::setupRowBlocks() {
 
   dlong blockSumN=0, blockSumT=0;
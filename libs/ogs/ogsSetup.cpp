@@ -50,6 +50,8 @@ void ogs_t::Setup(const dlong _N,
                   const bool verbose,
                   platform_t& _platform){
   ogsBase_t::Setup(_N, ids, _comm, _kind, method, _unique, verbose, _platform);
+
+  if (method==Auto) FusedAutoSetup(verbose);
 }
 
 void halo_t::Setup(const dlong _N,
@@ -151,6 +153,8 @@ void ogsBase_t::Setup(const dlong _N,
   else
     LocalHaloSetup(Nids, nodes);
 
+  gatherFused = std::make_shared<ogsFusedOperator_t>(platform, gatherLocal, gatherHalo);
+
   //with that, we're done with the local nodes list
   nodes.free();
 
@@ -174,6 +178,16 @@ void ogsBase_t::Setup(const dlong _N,
                   new ogsCrystalRouter_t(Nshared, sharedNodes,
                                          *gatherHalo, dataStream,
                                          comm, platform));
+  } else if (method == Neighborhood) {
+    exchange = std::shared_ptr<ogsExchange_t>(
+                  new ogsNeighborhood_t(Nshared, sharedNodes,
+                                        *gatherHalo, dataStream,
+                                        comm, platform));
+  } else if (method == Hierarchical) {
+    exchange = std::shared_ptr<ogsExchange_t>(
+                  new ogsHierarchical_t(Nshared, sharedNodes,
+                                        *gatherHalo, dataStream,
+                                        comm, platform));
   } else { //Auto
     exchange = std::shared_ptr<ogsExchange_t>(
                   AutoSetup(Nshared, sharedNodes,
@@ -850,7 +864,9 @@ void ogsBase_t::Free() {
   comm.Free();
   gatherLocal = nullptr;
   gatherHalo = nullptr;
+  gatherFused = nullptr;
   exchange = nullptr;
+  fused = false;
   N=0;
   NlocalT=0;
   NhaloT=0;
@@ -40,7 +40,16 @@ kernel_t ogsOperator_t::gatherScatterKernel[4][4];
 kernel_t ogsOperator_t::gatherKernel[4][4];
 kernel_t ogsOperator_t::scatterKernel[4];
 
+kernel_t ogsOperator_t::gatherBatchKernel[4][4];
+kernel_t ogsOperator_t::scatterBatchKernel[4];
+
+kernel_t ogsFusedOperator_t::fusedGatherScatterKernel[4][4];
+
 kernel_t ogsExchange_t::extractKernel[4];
+kernel_t ogsExchange_t::packBatchKernel[4];
+kernel_t ogsExchange_t::unpackBatchKernel[4];
+kernel_t ogsExchange_t::packFloatKernel;
+kernel_t ogsExchange_t::unpackFloatKernel;
 
 
 void InitializeKernels(platform_t& platform, const Type type, const Op op) {
@@ -111,13 +120,38 @@ void InitializeKernels(platform_t& platform, const Type type, const Op op) {
                                                 "gather",
                                                 kernelInfo);
 
+    ogsFusedOperator_t::fusedGatherScatterKernel[type][op] = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
+                                                         "fusedGatherScatter",
+                                                         kernelInfo);
+
+    ogsOperator_t::gatherBatchKernel[type][op] = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
+                                                     "gatherBatch",
+                                                     kernelInfo);
+
     if (!ogsOperator_t::scatterKernel[type].isInitialized()) {
       ogsOperator_t::scatterKernel[type] = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
                                                  "scatter",
                                                  kernelInfo);
 
       ogsExchange_t::extractKernel[type] = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
-                                                "extract", kernelInfo);\
+                                                "extract", kernelInfo);
+
+      ogsOperator_t::scatterBatchKernel[type] = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
+                                                    "scatterBatch",
+                                                    kernelInfo);
+
+      ogsExchange_t::packBatchKernel[type] = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
+                                                  "packBatch", kernelInfo);
+      ogsExchange_t::unpackBatchKernel[type] = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
+                                                    "unpackBatch", kernelInfo);
+
+      //precision conversions for compressed halo exchanges
+      if (type==Double) {
+        ogsExchange_t::packFloatKernel = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
+                                                  "packFloat", kernelInfo);
+        ogsExchange_t::unpackFloatKernel = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
+                                                    "unpackFloat", kernelInfo);
+      }
     }
   }
 }
@@ -0,0 +1,107 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "parAdogs.hpp"
+#include "parAdogs/parAdogsGraph.hpp"
+#include "parAdogs/parAdogsPartition.hpp"
+
+namespace libp {
+
+namespace paradogs {
+
+/****************************************/
+/* Bipartition a Distributed Vector     */
+/****************************************/
+/*
+  Split the graph vertices at a pivot of F. Unweighted graphs split the
+  vertex count by targetFraction. With one weight constraint the total
+  weight is split instead. With several constraints (e.g. one per multirate
+  level) each vertex is assigned to the constraint carrying most of its
+  weight, and each constraint class is split at its own pivot so that every
+  constraint is balanced between the two halves.
+*/
+void graph_t::Bisect(memory<dfloat>& F,
+                     const dfloat targetFraction[2],
+                     memory<int>& partition) {
+
+  if (Nconstraints==0) {
+    const hlong K = std::ceil(targetFraction[0]*NVertsGlobal);
+    const dfloat pivot = ParallelPivot(Nverts, F, K, comm);
+
+    for (dlong n=0;n<Nverts;++n) {
+      partition[n] = (F[n]<=pivot) ? 0 : 1;
+    }
+    return;
+  }
+
+  /*Dominant constraint of each vertex*/
+  memory<int> cls(Nverts);
+  for (dlong n=0;n<Nverts;++n) {
+    int cmax = 0;
+    for (int c=1;c<Nconstraints;++c) {
+      if (elements[n].W[c] > elements[n].W[cmax]) cmax = c;
+    }
+    cls[n] = cmax;
+  }
+
+  memory<dfloat> Fc(Nverts);
+  memory<dfloat> Wc(Nverts);
+
+  for (int c=0;c<Nconstraints;++c) {
+    /*Gather the vertices in this class*/
+    dlong Nc=0;
+    dfloat totalW=0.0;
+    for (dlong n=0;n<Nverts;++n) {
+      if (cls[n]==c) {
+        Fc[Nc] = F[n];
+        Wc[Nc] = elements[n].W[c];
+        totalW += Wc[Nc];
+        Nc++;
+      }
+    }
+    comm.Allreduce(totalW);
+    if (totalW==0.0) {
+      /*Nothing to balance, fall back to the unweighted split*/
+      hlong gNc = Nc;
+      comm.Allreduce(gNc);
+      if (gNc==0) continue;
+      for (dlong n=0;n<Nc;++n) Wc[n] = 1.0;
+      totalW = static_cast<dfloat>(gNc);
+    }
+
+    const dfloat pivot = ParallelWeightedPivot(Nc, Fc, Wc,
+                                               targetFraction[0]*totalW,
+                                               comm);
+
+    for (dlong n=0;n<Nverts;++n) {
+      if (cls[n]==c) partition[n] = (F[n]<=pivot) ? 0 : 1;
+    }
+  }
+}
+
+} //namespace paradogs
+
+} //namespace libp
@@ -43,6 +43,9 @@ graph_t::graph_t(platform_t &_platform,
                  const memory<dfloat>& EX,
                  const memory<dfloat>& EY,
                  const memory<dfloat>& EZ,
+                 const memory<hlong>& elementInfo,
+                 const memory<dfloat>& weights,
+                 const int _Nconstraints,
                  comm_t _comm):
   platform(_platform),
   Nverts(_Nelements),
@@ -50,7 +53,12 @@ graph_t::graph_t(platform_t &_platform,
   dim(_dim),
   Nfaces(_Nfaces),
   NelementVerts(_Nverts),
-  NfaceVerts(_NfaceVerts) {
+  NfaceVerts(_NfaceVerts),
+  Nconstraints(_Nconstraints) {
+
+  LIBP_ABORT("Paradogs: number of weight constraints " << Nconstraints
+             << " exceeds maximum " << MAX_NCONSTRAINTS,
+             Nconstraints>MAX_NCONSTRAINTS);
 
   gcomm = _comm.Dup();
   grank = gcomm.rank();
@@ -107,6 +115,30 @@ graph_t::graph_t(platform_t &_platform,
       }
     }
   }
+
+  /*Element tags and weights*/
+  for (dlong e=0;e<Nelements;++e) {
+    elements[e].info = (elementInfo.length()) ? elementInfo[e] : 0;
+    for (int c=0;c<Nconstraints;++c) {
+      elements[e].W[c] = weights[c+e*Nconstraints];
+    }
+  }
+}
+
+/*Total weight of each vertex, summed over constraints*/
+memory<dfloat> graph_t::VertexWeights() {
+  memory<dfloat> w(Nverts);
+
+  #pragma omp parallel for
+  for (dlong n=0;n<Nverts;++n) {
+    if (Nconstraints) {
+      w[n] = 0.0;
+      for (int c=0;c<Nconstraints;++c) w[n] += elements[n].W[c];
+    } else {
+      w[n] = 1.0;
+    }
+  }
+  return w;
 }
 
 /*Globally divide graph into two pieces according to a bipartition*/
@@ -141,7 +173,7 @@ void graph_t::Split(const memory<int>& partition) {
   }
 
   /*Determine number of ranks to hold left and right partitions*/
-  const int size0 = (size+1)/2;
+  const int size0 = BisectionSize();
   const int size1 = size-size0;
 
   const hlong chunk0 = globalNverts0/size0;
@@ -304,6 +336,10 @@ void graph_t::Split(const memory<int>& partition) {
   comm.Free();
   comm = newComm;
 
+  /*Split preserves rank order, so each comm holds a contiguous range of global ranks*/
+  if (rank>=size0) grankL += size0;
+  bisectionStarts.push_back(grankL);
+
   rank = comm.rank();
   size = comm.size();
 
@@ -342,6 +378,20 @@ void graph_t::Report() {
     }
   }
 
+  /* Min,Avg,Max Element weights*/
+  dfloat weight=0.0;
+  if (Nconstraints) {
+    memory<dfloat> w = VertexWeights();
+    for (dlong n=0;n<Nverts;++n) weight += w[n];
+  }
+  dfloat minWeight=weight;
+  dfloat maxWeight=weight;
+  dfloat avgWeight=weight;
+  gcomm.Allreduce(minWeight, Comm::Min);
+  gcomm.Allreduce(maxWeight, Comm::Max);
+  gcomm.Allreduce(avgWeight);
+  avgWeight /= gsize;
+
   hlong gCut = static_cast<hlong>(cut);
   gcomm.Allreduce(gCut);
   hlong avgCut = gCut/gsize;
@@ -370,6 +420,66 @@ void graph_t::Report() {
             static_cast<long long int>(maxNverts),
             static_cast<long long int>(maxCut));
     printf("-----------------------------------------------------------------------------------------------\n");
+    if (Nconstraints) {
+      printf("   Per Rank Weight (min,avg,max): %11.4g %11.4g %11.4g   Imbalance: %6.3f     |\n",
+             minWeight, avgWeight, maxWeight,
+             (avgWeight>0.0) ? maxWeight/avgWeight : 1.0);
+      printf("-----------------------------------------------------------------------------------------------\n");
+    }
+  }
+
+  /*Halo faces by the bisection level which separated the two ranks, and across nodes*/
+  int Nbisections = static_cast<int>(bisectionStarts.size());
+  gcomm.Allreduce(Nbisections, Comm::Max);
+  if (Nbisections==0 || nodeIds.length()==0) return;
+
+  memory<int> starts(gsize*Nbisections);
+  for (int l=0;l<Nbisections;++l) {
+    starts[l+grank*Nbisections] = (l<static_cast<int>(bisectionStarts.size()))
+                                   ? bisectionStarts[l] : grank;
+  }
+  gcomm.Allgather(starts, Nbisections);
+
+  memory<hlong> rankStarts(gsize+1);
+  rankStarts[0]=0;
+  gcomm.Allgather(gVoffsetU, rankStarts+1);
+
+  memory<hlong> levelCut(Nbisections);
+  memory<hlong> levelNodeCut(Nbisections);
+  for (int l=0;l<Nbisections;++l) {
+    levelCut[l]=0;
+    levelNodeCut[l]=0;
+  }
+
+  for (dlong n=0;n<Nverts;++n) {
+    for (int f=0;f<Nfaces;++f) {
+      const hlong eN = elements[n].E[f];
+      if (eN!=-1 && ((eN<gVoffsetL) || (eN>=gVoffsetU))) {
+        const int rN = static_cast<int>(std::upper_bound(rankStarts.ptr(),
+                                                         rankStarts.ptr()+gsize+1,
+                                                         eN) - rankStarts.ptr()) - 1;
+        int l=0;
+        while (l<Nbisections-1
+               && starts[l+grank*Nbisections]==starts[l+rN*Nbisections]) ++l;
+        levelCut[l]++;
+        if (nodeIds[grank]!=nodeIds[rN]) levelNodeCut[l]++;
+      }
+    }
+  }
+  gcomm.Allreduce(levelCut);
+  gcomm.Allreduce(levelNodeCut);
+
+  if(grank==0) {
+    printf("   Bisection Level   |   Halo Faces   |   Inter-node Halo Faces   |  Nodes: %5d %-12s|\n",
+           Nnodes, nodeAware ? "(node-aware)" : "");
+    printf("-----------------------------------------------------------------------------------------------\n");
+    for (int l=0;l<Nbisections;++l) {
+      printf("   %15d   | %12lld   | %23lld   |                           |\n",
+             l,
+             static_cast<long long int>(levelCut[l]),
+             static_cast<long long int>(levelNodeCut[l]));
+    }
+    printf("-----------------------------------------------------------------------------------------------\n");
   }
 }
 
@@ -379,7 +489,8 @@ void graph_t::ExtractMesh(dlong &Nelements_,
                           memory<int>& EToF,
                           memory<dfloat>& EX,
                           memory<dfloat>& EY,
-                          memory<dfloat>& EZ) {
+                          memory<dfloat>& EZ,
+                          memory<hlong>& elementInfo) {
 
   /*Destroy any exiting mesh data and create new data from current graph*/
   Nelements_ = Nelements;
@@ -393,6 +504,11 @@ void graph_t::ExtractMesh(dlong &Nelements_,
   if (dim==3)
     EZ.malloc(Nelements*NelementVerts);
 
+  elementInfo.malloc(Nelements);
+  for (dlong e=0;e<Nelements;++e) {
+    elementInfo[e] = elements[e].info;
+  }
+
   if (dim==2) {
     for (dlong e=0;e<Nelements;++e) {
       for (int v=0;v<NelementVerts;++v) {
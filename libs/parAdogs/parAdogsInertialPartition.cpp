@@ -40,7 +40,7 @@ void graph_t::InertialPartition() {
   if (size==1) return;
 
   /*Determine size of left and right partitions*/
-  const int size0 = (size+1)/2;
+  const int size0 = BisectionSize();
   // const int size1 = size-size0;
 
   /*Set target */
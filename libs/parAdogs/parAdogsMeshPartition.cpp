@@ -49,6 +49,9 @@ void MeshPartition(platform_t &platform,
                    memory<dfloat>& EX,
                    memory<dfloat>& EY,
                    memory<dfloat>& EZ,
+                   memory<hlong>& elementInfo,
+                   const memory<dfloat>& weights,
+                   const int Nconstraints,
                    comm_t comm) {
 
   /* Create RNG*/
@@ -66,10 +69,16 @@ void MeshPartition(platform_t &platform,
                 EX,
                 EY,
                 EZ,
+                elementInfo,
+                weights,
+                Nconstraints,
                 comm);
 
   timePoint_t timeStart = GlobalTime(comm);
 
+  /*Find ranks sharing a node, so early bisections cut between nodes*/
+  graph.NodeTopology(settings.compareSetting("PARADOGS NODE AWARE", "TRUE"));
+
   if (settings.compareSetting("PARADOGS PARTITIONING", "INERTIAL")) {
     /*Inertial partitioning*/
     graph.InertialPartition();
@@ -106,7 +115,8 @@ void MeshPartition(platform_t &platform,
                     EToF,
                     EX,
                     EY,
-                    EZ);
+                    EZ,
+                    elementInfo);
 }
 
 } //namespace paradogs
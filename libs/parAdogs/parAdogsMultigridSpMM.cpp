@@ -139,7 +139,8 @@ parCSR SpMM(const parCSR& A, const parCSR& B){
   //we now have all the needed nonlocal rows (should also be sorted by row then col)
 
   //make an array of row offsets so we know how large each row is
-  memory<dlong> BoffdRowOffsets(A.Ncols-A.NlocalCols+1, 0);
+  const dlong NhaloRows = A.Ncols-A.NlocalCols;
+  memory<dlong> BoffdRowOffsets(NhaloRows+1, 0);
 
   dlong id=0;
   for (dlong n=0;n<Boffdnnz;n++) {
@@ -151,137 +152,88 @@ parCSR SpMM(const parCSR& A, const parCSR& B){
   }
 
   //cumulative sum
-  for (dlong n=0;n<A.Ncols-A.NlocalCols;n++)
+  for (dlong n=0;n<NhaloRows;n++)
     BoffdRowOffsets[n+1] += BoffdRowOffsets[n];
 
-
-  // The next step to compute C = A*B is to multiply each entry A(i,j) by the
-  // row B(j,:), store the all the results, sort them by row+col, and compress
-  // the entries
-
-  // Find how big the intermediate form is
-  memory<dlong> rowStarts(A.Nrows+1, 0);
-  memory<dlong> rowCounts(A.Nrows, 0);
-
-  /*Count entries per row*/
-  #pragma omp parallel for
-  for (dlong i=0;i<A.Nrows;i++) {
-    //local entries
-    dlong start = A.diag.rowStarts[i];
-    dlong end   = A.diag.rowStarts[i+1];
-    for (dlong j=start;j<end;j++) {
-      const dlong col = A.diag.cols[j];
-      rowStarts[i+1] +=  B.diag.rowStarts[col+1]-B.diag.rowStarts[col]
-                        +B.offd.rowStarts[col+1]-B.offd.rowStarts[col];
-    }
-    //non-local entries
-    start = A.offd.rowStarts[i];
-    end   = A.offd.rowStarts[i+1];
-    for (dlong j=start;j<end;j++) {
-      const dlong col = A.offd.cols[j]-A.NlocalCols;
-      rowStarts[i+1] += BoffdRowOffsets[col+1] - BoffdRowOffsets[col];
-    }
+  // Gather every row of B that A touches into one CSR block with global
+  // column ids, indexed by the column ids of A: the local rows of B first,
+  // then the received halo rows
+  memory<dlong> BrowStarts(A.Ncols+1);
+  BrowStarts[0] = 0;
+  for (dlong i=0;i<A.NlocalCols;i++) {
+    BrowStarts[i+1] = BrowStarts[i]
+                     + B.diag.rowStarts[i+1]-B.diag.rowStarts[i]
+                     + B.offd.rowStarts[i+1]-B.offd.rowStarts[i];
   }
-
-  /*Cumulative sum*/
-  for(dlong i=1; i<A.Nrows+1; i++) {
-    rowStarts[i] += rowStarts[i-1];
+  for (dlong n=0;n<NhaloRows;n++) {
+    BrowStarts[A.NlocalCols+n+1] = BrowStarts[A.NlocalCols+n]
+                                  + BoffdRowOffsets[n+1]-BoffdRowOffsets[n];
   }
 
-  NNZ = rowStarts[A.Nrows];
-
-  memory<nonZero_t> Ctmp(NNZ);
-
-  //count total number of nonzeros;
-  dlong nnz =0;
+  memory<hlong>  Bcols(BrowStarts[A.Ncols]);
+  memory<pfloat> Bvals(BrowStarts[A.Ncols]);
 
-  // Fill the intermediate form of C
-  // #pragma omp parallel for
-  for (dlong i=0;i<A.Nrows;i++) {
-    const dlong cStart = rowStarts[i];
-    dlong& c = rowCounts[i];
-
-    //local A entries
-    dlong start = A.diag.rowStarts[i];
-    dlong end   = A.diag.rowStarts[i+1];
-    for (dlong j=start;j<end;j++) {
-      const dlong col = A.diag.cols[j];
-      const dfloat Aval = A.diag.vals[j];
-
-      //local B entries
-      dlong Bstart = B.diag.rowStarts[col];
-      dlong Bend   = B.diag.rowStarts[col+1];
-      for (dlong jj=Bstart;jj<Bend;jj++) {
-        Ctmp[cStart+c].row = i + A.rowOffsetL;
-        Ctmp[cStart+c].col = B.diag.cols[jj] + B.colOffsetL; //global id
-        Ctmp[cStart+c].val = Aval*B.diag.vals[jj];
-        c++;
-      }
-      //non-local B entries
-      Bstart = B.offd.rowStarts[col];
-      Bend   = B.offd.rowStarts[col+1];
-      for (dlong jj=Bstart;jj<Bend;jj++) {
-        Ctmp[cStart+c].row = i + A.rowOffsetL;
-        Ctmp[cStart+c].col = B.colMap[B.offd.cols[jj]]; //global id
-        Ctmp[cStart+c].val = Aval*B.offd.vals[jj];
-        c++;
-      }
+  #pragma omp parallel for
+  for (dlong i=0;i<A.NlocalCols;i++) {
+    dlong cnt = BrowStarts[i];
+    for (dlong jj=B.diag.rowStarts[i]; jj<B.diag.rowStarts[i+1];jj++){
+      Bcols[cnt] = B.diag.cols[jj] + B.colOffsetL; //global id
+      Bvals[cnt] = B.diag.vals[jj];
+      cnt++;
     }
-    //non-local A entries
-    start = A.offd.rowStarts[i];
-    end   = A.offd.rowStarts[i+1];
-    for (dlong j=start;j<end;j++) {
-      const dlong col = A.offd.cols[j]-A.NlocalCols;
-      const dfloat Aval = A.offd.vals[j];
-
-      // entries from recived rows of B
-      dlong Bstart = BoffdRowOffsets[col];
-      dlong Bend   = BoffdRowOffsets[col+1];
-      for (dlong jj=Bstart;jj<Bend;jj++) {
-        Ctmp[cStart+c].row = i + A.rowOffsetL;
-        Ctmp[cStart+c].col = BoffdRows[jj].col; //global id
-        Ctmp[cStart+c].val = Aval*BoffdRows[jj].val;
-        c++;
-      }
+    for (dlong jj=B.offd.rowStarts[i]; jj<B.offd.rowStarts[i+1];jj++){
+      Bcols[cnt] = B.colMap[B.offd.cols[jj]]; //global id
+      Bvals[cnt] = B.offd.vals[jj];
+      cnt++;
     }
+  }
 
-    //sort entries in this row by col id
-    std::sort(Ctmp.ptr()+cStart, Ctmp.ptr()+cStart+c,
-              [](const nonZero_t& a, const nonZero_t& b) {
-                return a.col < b.col;
-              });
-
-    /*Count how many actual nonzeros will be in this row*/
-    dlong nnzRow=0;
-    if (c>0) nnzRow++;
-    for (dlong j=1;j<c;j++) {
-      if ((Ctmp[cStart+j].col!=Ctmp[cStart+j-1].col)) nnzRow++;
+  #pragma omp parallel for
+  for (dlong n=0;n<NhaloRows;n++) {
+    dlong cnt = BrowStarts[A.NlocalCols+n];
+    for (dlong jj=BoffdRowOffsets[n];jj<BoffdRowOffsets[n+1];jj++) {
+      Bcols[cnt] = BoffdRows[jj].col; //global id
+      Bvals[cnt] = BoffdRows[jj].val;
+      cnt++;
     }
-
-    nnz+=nnzRow; //Add to total
   }
   BoffdRowOffsets.free();
   BoffdRows.free();
 
-  rowStarts.free();
-  rowCounts.free();
+  //symbolic pass to size the rows of C, then numeric pass to fill them
+  memory<dlong> CrowStarts(A.Nrows+1);
+  linAlg_t::SpGEMMSymbolic(A.Nrows,
+                           A.diag.rowStarts, A.diag.cols,
+                           A.offd.rowStarts, A.offd.cols,
+                           BrowStarts, Bcols,
+                           CrowStarts);
+
+  const dlong nnz = CrowStarts[A.Nrows];
+  memory<hlong>  Ccols(nnz);
+  memory<pfloat> Cvals(nnz);
+
+  linAlg_t::SpGEMMNumeric(A.Nrows,
+                          A.diag.rowStarts, A.diag.cols, A.diag.vals,
+                          A.offd.rowStarts, A.offd.cols, A.offd.vals,
+                          BrowStarts, Bcols, Bvals,
+                          CrowStarts, Ccols, Cvals);
+
+  //clean up
+  BrowStarts.free();
+  Bcols.free();
+  Bvals.free();
 
-  // cooC.nnz = nnz;
   memory<nonZero_t> entries(nnz);
 
-  //compress nonzeros
-  nnz = 0;
-  if (NNZ) entries[nnz++] = Ctmp[0];
-  for (dlong i=1;i<NNZ;i++) {
-    if ((Ctmp[i].row!=Ctmp[i-1].row)||
-        (Ctmp[i].col!=Ctmp[i-1].col)) {
-      entries[nnz++] = Ctmp[i];
-    } else {
-      entries[nnz-1].val += Ctmp[i].val;
+  //rows of C are already column sorted
+  #pragma omp parallel for
+  for (dlong i=0;i<A.Nrows;i++) {
+    for (dlong jj=CrowStarts[i];jj<CrowStarts[i+1];jj++) {
+      entries[jj].row = i + A.rowOffsetL;
+      entries[jj].col = Ccols[jj];
+      entries[jj].val = Cvals[jj];
     }
   }
-  //clean up
-  Ctmp.free();
 
   //build C from coo matrix
   return parCSR(A.Nrows, B.NlocalCols,
@@ -100,6 +100,80 @@ dfloat ParallelPivot(const dlong N, memory<dfloat>& F,
   return pivot;
 }
 
+struct weightedEntry_t {
+  dfloat f;
+  dfloat w;
+};
+
+static dfloat WeightedPivot(memory<weightedEntry_t>& A,
+                            const dlong left,
+                            const dlong right,
+                            const dfloat target,
+                            const dfloat tol,
+                            const dfloat min,
+                            const dfloat max,
+                            comm_t comm) {
+  /*Start with guessing a pivot halfway between min and max*/
+  const dfloat pivot = (min+max)/2.0;
+
+  /*Bail out if we're looking at a tiny window*/
+  constexpr dfloat TOL = (sizeof(dfloat)==8) ? 1.0e-13 : 1.0E-5;
+  if (max-min < TOL) return pivot;
+
+  weightedEntry_t* Am = partition(A.ptr()+left, A.ptr()+right,
+                                  [pivot](const weightedEntry_t& a){ return a.f <= pivot; });
+  const dlong mid = static_cast<dlong>(Am-A.ptr());
+
+  /*Get how much weight in this window is globally <= pivot*/
+  dfloat globalW = 0.0;
+  for (dlong n=left;n<mid;++n) globalW += A[n].w;
+  comm.Allreduce(globalW);
+
+  if (std::abs(globalW-target) <= tol) return pivot;
+
+  if (target<globalW) {
+    return WeightedPivot(A, left, mid, target, tol, min, pivot, comm);
+  } else {
+    return WeightedPivot(A, mid, right, target-globalW, tol, pivot, max, comm);
+  }
+}
+
+/* Given a distributed vector F with weights W in comm, find a pivot value,
+   such that the entries of F which are <= pivot have a total weight of
+   target, to within half the largest weight. */
+dfloat ParallelWeightedPivot(const dlong N, memory<dfloat>& F,
+                             memory<dfloat>& W,
+                             const dfloat target, comm_t comm) {
+
+  /*Make a copy of input vectors*/
+  memory<weightedEntry_t> A(N);
+
+  #pragma omp parallel for
+  for (dlong n=0;n<N;++n) {
+    A[n].f = F[n];
+    A[n].w = W[n];
+  }
+
+  /*Find global minimum/maximum*/
+  dfloat globalMin=std::numeric_limits<dfloat>::max();
+  dfloat globalMax=std::numeric_limits<dfloat>::lowest();
+  dfloat maxW=0.0;
+  for (dlong n=0;n<N;++n) {
+    globalMax = std::max(A[n].f, globalMax);
+    globalMin = std::min(A[n].f, globalMin);
+    maxW = std::max(A[n].w, maxW);
+  }
+  comm.Allreduce(globalMin, Comm::Min);
+  comm.Allreduce(globalMax, Comm::Max);
+  comm.Allreduce(maxW, Comm::Max);
+
+  /*Find pivot point via binary search*/
+  dfloat pivot = WeightedPivot(A, 0, N, target, 0.5*maxW,
+                               globalMin, globalMax, comm);
+
+  return pivot;
+}
+
 } //namespace paradogs
 
 } //namespace libp
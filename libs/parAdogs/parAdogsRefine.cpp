@@ -57,22 +57,48 @@ void graph_t::Refine(const int level) {
   memory<dfloat> scratch(3*Ncols);
   memory<dfloat> AF = scratch;
 
-  /*AF = A*F*/
-  A.SpMV(1.0, Fiedler, 0.0, AF);
-
-  /*theta = F^T * A * F */
-  dfloat theta = 0.0;
-  dfloat normAF = 0.0;
-  for (dlong n=0;n<N;++n) {
-    theta += Fiedler[n]*AF[n];
-    normAF += AF[n]*AF[n];
-  }
-  comm.Allreduce(theta);
-  comm.Allreduce(normAF);
+  /*On the fine level of a weighted graph, solve the generalized problem
+    A*F = theta*W*F, so the Fiedler vector is W-orthogonal to the null vector*/
+  const bool weighted = (level==0) && (Nconstraints>0);
+  memory<dfloat> W;
+  if (weighted) W = VertexWeights();
+
+  /*theta = F^T * A * F / F^T * W * F, and relative eigen-residual*/
+  auto Residual = [&](dfloat& theta_, dfloat& err_) {
+    /*AF = A*F*/
+    A.SpMV(1.0, Fiedler, 0.0, AF);
 
-  dfloat err = sqrt(std::abs(normAF - theta*theta))/theta;
+    dfloat normAF = 0.0;
+    theta_ = 0.0;
+    for (dlong n=0;n<N;++n) {
+      theta_ += Fiedler[n]*AF[n];
+      normAF += AF[n]*AF[n];
+    }
+    comm.Allreduce(theta_);
+    comm.Allreduce(normAF);
+
+    if (weighted) {
+      dfloat normWF = 0.0;
+      for (dlong n=0;n<N;++n) normWF += W[n]*Fiedler[n]*Fiedler[n];
+      comm.Allreduce(normWF);
+      theta_ /= normWF;
+
+      dfloat res = 0.0;
+      for (dlong n=0;n<N;++n) {
+        const dfloat rn = AF[n] - theta_*W[n]*Fiedler[n];
+        res += rn*rn;
+      }
+      comm.Allreduce(res);
+      err_ = sqrt(res/normWF)/theta_;
+    } else {
+      err_ = sqrt(std::abs(normAF - theta_*theta_))/theta_;
+    }
+  };
 
-  // if (rank==0) printf("Intial err = %f, theta = %f, ||AF|| = %f \n", err, theta, sqrt(normAF));
+  dfloat theta, err;
+  Residual(theta, err);
+
+  // if (rank==0) printf("Intial err = %f, theta = %f \n", err, theta);
 
   for (int it=0;it<maxIters;++it) {
 
@@ -83,9 +109,16 @@ void graph_t::Refine(const int level) {
       x[n] = Fiedler[n]/theta;
     }
 
-    #pragma omp parallel for
-    for (dlong n=0;n<N;++n) {
-      Fiedler[n] = Fiedler[n] - AF[n]/theta;
+    if (weighted) {
+      #pragma omp parallel for
+      for (dlong n=0;n<N;++n) {
+        Fiedler[n] = W[n]*Fiedler[n] - AF[n]/theta;
+      }
+    } else {
+      #pragma omp parallel for
+      for (dlong n=0;n<N;++n) {
+        Fiedler[n] = Fiedler[n] - AF[n]/theta;
+      }
     }
 
     /*Solve A_{l}*x = Fiedler*/
@@ -94,10 +127,21 @@ void graph_t::Refine(const int level) {
 
     /*Project out null vector*/
     dfloat dot=0.0;
-    for (int n=0;n<N;++n) {
-      dot += x[n]*null[n];
+    dfloat nullNorm=1.0;
+    if (weighted) {
+      nullNorm=0.0;
+      for (int n=0;n<N;++n) {
+        dot += W[n]*x[n]*null[n];
+        nullNorm += W[n]*null[n]*null[n];
+      }
+      comm.Allreduce(nullNorm);
+    } else {
+      for (int n=0;n<N;++n) {
+        dot += x[n]*null[n];
+      }
     }
     comm.Allreduce(dot);
+    dot /= nullNorm;
 
     #pragma omp parallel for
     for (int n=0;n<N;++n) {
@@ -105,8 +149,14 @@ void graph_t::Refine(const int level) {
     }
 
     dfloat normx = 0.0;
-    for (dlong n=0;n<N;++n) {
-      normx += x[n]*x[n];
+    if (weighted) {
+      for (dlong n=0;n<N;++n) {
+        normx += W[n]*x[n]*x[n];
+      }
+    } else {
+      for (dlong n=0;n<N;++n) {
+        normx += x[n]*x[n];
+      }
     }
     comm.Allreduce(normx);
     normx = sqrt(normx);
@@ -117,22 +167,9 @@ void graph_t::Refine(const int level) {
       Fiedler[n] = x[n]/normx;
     }
 
-    /*AF = A*F*/
-    A.SpMV(1.0, Fiedler, 0.0, AF);
-
-    /*theta = F^T * A * F */
-    theta = 0.0;
-    normAF = 0.0;
-    for (dlong n=0;n<N;++n) {
-      theta += Fiedler[n]*AF[n];
-      normAF += AF[n]*AF[n];
-    }
-    comm.Allreduce(theta);
-    comm.Allreduce(normAF);
-
-    err = sqrt(std::abs(normAF - theta*theta))/theta;
+    Residual(theta, err);
 
-    // if (rank==0)  printf("err = %f, theta = %f, ||AF|| = %f, cg_iter=%d\n", err, theta, sqrt(normAF), cg_iter);
+    // if (rank==0)  printf("err = %f, theta = %f, cg_iter=%d\n", err, theta, cg_iter);
   }
 }
 
@@ -36,11 +36,28 @@ void AddSettings(settings_t& settings) {
                       "INERTIAL",
                       "Type of Mesh partitioning",
                       {"NONE", "INERTIAL", "SPECTRAL"});
+
+  settings.newSetting("PARADOGS NODE AWARE",
+                      "TRUE",
+                      "Bisect between nodes before bisecting within a node",
+                      {"TRUE", "FALSE"});
+
+  settings.newSetting("PARADOGS ELEMENT WEIGHTS",
+                      "NONE",
+                      "Balance estimated multirate element costs as one weight, or as one constraint per multirate level",
+                      {"NONE", "MULTIRATE", "MULTICONSTRAINT"});
+
+  settings.newSetting("PARADOGS PML WEIGHT",
+                      "1",
+                      "Relative cost of PML elements when partitioning");
 }
 
 void ReportSettings(settings_t& settings) {
 
   settings.reportSetting("PARADOGS PARTITIONING");
+  settings.reportSetting("PARADOGS NODE AWARE");
+  settings.reportSetting("PARADOGS ELEMENT WEIGHTS");
+  settings.reportSetting("PARADOGS PML WEIGHT");
 }
 
 } //namespace paradogs
@@ -44,18 +44,8 @@ void graph_t::SpectralBipartition(const dfloat targetFraction[2]) {
   memory<dfloat>& Fiedler = FiedlerVector();
 
   /*Use Fiedler vector to bipartion graph*/
-  const hlong K = std::ceil(targetFraction[0]*NVertsGlobal);
-  const dfloat pivot = ParallelPivot(Nverts, Fiedler, K, comm);
-
   memory<int> partition(L[0].A.Ncols);
-
-  for (dlong n=0;n<Nverts;++n) {
-    if (Fiedler[n]<=pivot) {
-      partition[n] = 0;
-    } else {
-      partition[n] = 1;
-    }
-  }
+  Bisect(Fiedler, targetFraction, partition);
 
   /*Fill halo region of partition vector*/
   L[0].A.halo.Exchange(partition, 1);
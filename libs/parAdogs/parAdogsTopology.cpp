@@ -0,0 +1,94 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "parAdogs.hpp"
+#include "parAdogs/parAdogsGraph.hpp"
+
+namespace libp {
+
+namespace paradogs {
+
+/*Find which global ranks share a node*/
+void graph_t::NodeTopology(const bool _nodeAware) {
+
+  /*Ranks sharing memory, ordered by global rank, so the node leader is its lowest rank*/
+  comm_t nodeComm = gcomm.SplitShared(grank);
+  int leader = grank;
+  nodeComm.Bcast(leader, 0);
+
+  memory<int> leaders(gsize);
+  leaders[grank] = leader;
+  gcomm.Allgather(leaders, 1);
+
+  /*Number nodes in order of their first rank*/
+  nodeIds.malloc(gsize);
+  Nnodes=0;
+  for (int r=0;r<gsize;++r) {
+    nodeIds[r] = (leaders[r]==r) ? Nnodes++ : nodeIds[leaders[r]];
+  }
+
+  /*Bisecting along node boundaries needs each node's ranks to be contiguous*/
+  bool contiguous=true;
+  for (int r=1;r<gsize;++r) {
+    if (nodeIds[r]!=nodeIds[r-1] && nodeIds[r]!=nodeIds[r-1]+1) contiguous=false;
+  }
+
+  nodeAware = _nodeAware && contiguous && (Nnodes>1);
+
+  nodeStarts.malloc(Nnodes+1);
+  nodeStarts[0]=0;
+  for (int n=0, r=0;n<Nnodes;++n) {
+    while (r<gsize && nodeIds[r]==n) ++r;
+    nodeStarts[n+1]=r;
+  }
+
+  LIBP_WARNING("Paradogs: ranks are not grouped by node, node-aware bisection disabled",
+               grank==0 && _nodeAware && !contiguous);
+}
+
+/*Number of ranks to hold the left partition of the next bisection. While
+  the current ranks span several nodes, cut at the node boundary nearest to
+  the middle so that only the first bisection levels cut between nodes*/
+int graph_t::BisectionSize() {
+
+  int size0 = (size+1)/2;
+  if (!nodeAware) return size0;
+
+  const int mid = grankL + size0;
+  int split = -1;
+  for (int n=1;n<Nnodes;++n) {
+    const int start = nodeStarts[n];
+    if (start<=grankL || start>=grankL+size) continue;
+    if (split==-1 || std::abs(start-mid)<std::abs(split-mid)) split = start;
+  }
+  if (split!=-1) size0 = split-grankL;
+
+  return size0;
+}
+
+} //namespace paradogs
+
+} //namespace libp
@@ -82,6 +82,32 @@ void parAlmond_t::Report() {
 
   if(multigrid->comm.rank()==0)
     printf("--------------------------------------------------------------------------------------------\n");
+
+  //AMG setup time breakdown, slowest rank
+  if (amgBaseLevel>=0) {
+    amgTimings_t maxTimings = amgTimings;
+    multigrid->comm.Allreduce(maxTimings.coarsen, Comm::Max);
+    multigrid->comm.Allreduce(maxTimings.galerkin, Comm::Max);
+    multigrid->comm.Allreduce(maxTimings.smoother, Comm::Max);
+    multigrid->comm.Allreduce(maxTimings.coarse, Comm::Max);
+    multigrid->comm.Allreduce(maxTimings.total, Comm::Max);
+
+    if(multigrid->comm.rank()==0) {
+      printf("AMG %s time (s): total %8.2e | coarsening %8.2e | Galerkin %8.2e | smoother %8.2e | coarse solver %8.2e\n",
+             maxTimings.numeric ? "numeric update" : "setup",
+             maxTimings.total, maxTimings.coarsen, maxTimings.galerkin,
+             maxTimings.smoother, maxTimings.coarse);
+    }
+
+    for (size_t l=0;l<maxTimings.levels.size();l++) {
+      multigrid->comm.Allreduce(maxTimings.levels[l], Comm::Max);
+      if(multigrid->comm.rank()==0)
+        printf(" %3d  | AMG level setup time (s) %8.2e\n", static_cast<int>(amgBaseLevel+l), maxTimings.levels[l]);
+    }
+
+    if(multigrid->comm.rank()==0)
+      printf("--------------------------------------------------------------------------------------------\n");
+  }
 }
 
 int parAlmond_t::NumLevels() {
@@ -27,6 +27,7 @@ SOFTWARE.
 #include "parAlmond.hpp"
 #include "parAlmond/parAlmondAMGSetup.hpp"
 #include "parAlmond/parAlmondCoarseSolver.hpp"
+#include "timer.hpp"
 
 namespace libp {
 
@@ -42,6 +43,9 @@ void parAlmond_t::AMGSetup(parCOO& cooA,
 
   if(Comm::World().rank()==0) {printf("Setting up AMG...");fflush(stdout);}
 
+  amgTimings = amgTimings_t();
+  timePoint_t setupStart = Time();
+
   /*Get multigrid solver*/
   multigrid_t& mg = *multigrid;
 
@@ -50,7 +54,11 @@ void parAlmond_t::AMGSetup(parCOO& cooA,
 
   //make csr matrix from coo input
   parCSR A(cooA);
+
+  timePoint_t start = Time();
   A.diagSetup();
+  timePoint_t end = Time();
+  amgTimings.smoother += ElapsedTime(start, end);
 
   //copy fine nullvector
   memory<dfloat> null(A.Nrows);
@@ -69,13 +77,20 @@ void parAlmond_t::AMGSetup(parCOO& cooA,
   }
 
   amgLevel& Lbase = mg.AddLevel<amgLevel>(A, settings);
+  amgBaseLevel = mg.numLevels-1;
+  amgNullSpace = nullSpace;
+  amgNullSpacePenalty = nullSpacePenalty;
 
   //if the system if already small, dont create MG levels
   bool done = false;
   if(globalSize <= gCoarseSize){
     mg.AllocateLevelWorkSpace(mg.numLevels-1);
+    start = Time();
     coarse.setup(A, nullSpace, null, nullSpacePenalty);
     coarse.syncToDevice();
+    end = Time();
+    amgTimings.coarse += ElapsedTime(start, end);
+    amgTimings.levels.push_back(ElapsedTime(start, end));
     mg.baseLevel = mg.numLevels-1;
     Lbase.syncToDevice();
     done = true;
@@ -93,6 +108,8 @@ void parAlmond_t::AMGSetup(parCOO& cooA,
   }
 
   while(!done){
+    timePoint_t levelStart = Time();
+
     /*Get current coarsest level*/
     amgLevel& L = mg.GetLevel<amgLevel>(mg.numLevels-1);
 
@@ -105,11 +122,13 @@ void parAlmond_t::AMGSetup(parCOO& cooA,
     /* Coarsen level via AMG. Coarsen null vector */
     Lcoarse = coarsenAmgLevel(L, null,
                               mg.strtype, theta,
-                              mg.aggtype);
+                              mg.aggtype, amgTimings);
 
     mg.AllocateLevelWorkSpace(mg.numLevels-2);
     L.syncToDevice();
 
+    amgTimings.levels.push_back(ElapsedTime(levelStart, Time()));
+
     parCSR& Acoarse = Lcoarse.A;
 
     // Increase coarsening rate as we add levels.
@@ -132,14 +151,79 @@ void parAlmond_t::AMGSetup(parCOO& cooA,
 
       mg.AllocateLevelWorkSpace(mg.numLevels-1);
       Lcoarse.syncToDevice();
+      start = Time();
       coarse.setup(Acoarse, nullSpace, null, nullSpacePenalty);
       coarse.syncToDevice();
+      end = Time();
+      amgTimings.coarse += ElapsedTime(start, end);
+      amgTimings.levels.push_back(ElapsedTime(start, end));
       mg.baseLevel = mg.numLevels-1;
       break;
     }
     globalSize = globalCoarseSize;
   }
 
+  //null vector of the coarsest level
+  amgCoarseNull = null;
+
+  amgTimings.total = ElapsedTime(setupStart, Time());
+
+  if(Comm::World().rank()==0) printf("done.\n");
+}
+
+void parAlmond_t::AMGUpdate(parCOO& cooA){
+
+  LIBP_ABORT("parAlmond::AMGUpdate called before AMGSetup",
+             amgBaseLevel<0);
+
+  if(Comm::World().rank()==0) {printf("Updating AMG...");fflush(stdout);}
+
+  amgTimings = amgTimings_t();
+  amgTimings.numeric = true;
+  timePoint_t updateStart = Time();
+
+  /*Get multigrid solver*/
+  multigrid_t& mg = *multigrid;
+
+  /*Get coarse solver*/
+  coarseSolver_t& coarse = *(mg.coarseSolver);
+
+  //refill the finest AMG operator in place
+  amgLevel& Lbase = mg.GetLevel<amgLevel>(amgBaseLevel);
+  Lbase.A.updateValues(cooA);
+
+  timePoint_t start = Time();
+  Lbase.A.diagSetup();
+  timePoint_t end = Time();
+  amgTimings.smoother += ElapsedTime(start, end);
+
+  //walk down the existing hierarchy, recomputing only values
+  for (int lev=amgBaseLevel;lev<mg.baseLevel;lev++) {
+    timePoint_t levelStart = Time();
+
+    amgLevel& L = mg.GetLevel<amgLevel>(lev);
+    amgLevel& Lcoarse = mg.GetLevel<amgLevel>(lev+1);
+
+    L.setupSmoother();
+    updateCoarseAmgLevel(L, Lcoarse, mg.aggtype, amgTimings);
+
+    L.A.syncValuesToDevice();
+
+    amgTimings.levels.push_back(ElapsedTime(levelStart, Time()));
+  }
+
+  amgLevel& Lcoarsest = mg.GetLevel<amgLevel>(mg.baseLevel);
+  Lcoarsest.A.syncValuesToDevice();
+
+  start = Time();
+  coarse.setup(Lcoarsest.A, amgNullSpace, amgCoarseNull, amgNullSpacePenalty);
+  coarse.syncToDevice();
+  end = Time();
+  amgTimings.coarse += ElapsedTime(start, end);
+  amgTimings.levels.push_back(ElapsedTime(start, end));
+
+  amgTimings.total = ElapsedTime(updateStart, Time());
+
   if(Comm::World().rank()==0) printf("done.\n");
 }
 
@@ -26,6 +26,7 @@ SOFTWARE.
 
 #include "parAlmond.hpp"
 #include "parAlmond/parAlmondAMGSetup.hpp"
+#include "timer.hpp"
 
 namespace libp {
 
@@ -34,12 +35,14 @@ namespace parAlmond {
 //create coarsened problem
 amgLevel coarsenAmgLevel(amgLevel& level, memory<dfloat>& null,
                          StrengthType strtype, dfloat theta,
-                         AggType aggtype){
+                         AggType aggtype, amgTimings_t& timings){
 
   parCSR& A = level.A;
 
   int size = A.comm.size();
 
+  timePoint_t start = Time();
+
   strongGraph_t C = strongGraph(A, strtype, theta);
 
   memory<hlong> FineToCoarse(A.Ncols);
@@ -63,6 +66,10 @@ amgLevel coarsenAmgLevel(amgLevel& level, memory<dfloat>& null,
   level.P = P;
   level.R = R;
 
+  timePoint_t end = Time();
+  timings.coarsen += ElapsedTime(start, end);
+
+  start = Time();
   parCSR Acoarse;
   if (aggtype == SMOOTHED) {
     parCSR AP = SpMM(A, P);
@@ -70,8 +77,13 @@ amgLevel coarsenAmgLevel(amgLevel& level, memory<dfloat>& null,
   } else {
     Acoarse = galerkinProd(A, P); //specialize for unsmoothed aggregation
   }
+  end = Time();
+  timings.galerkin += ElapsedTime(start, end);
 
+  start = Time();
   Acoarse.diagSetup();
+  end = Time();
+  timings.smoother += ElapsedTime(start, end);
 
   amgLevel coarseLevel(Acoarse,level.settings);
 
@@ -82,6 +94,31 @@ amgLevel coarsenAmgLevel(amgLevel& level, memory<dfloat>& null,
   return coarseLevel;
 }
 
+//recompute the coarse operator of an existing level after the values of
+// the fine operator have changed. The prolongator and restriction are reused,
+// so the coarse operator keeps its sparsity pattern
+void updateCoarseAmgLevel(amgLevel& level, amgLevel& coarseLevel,
+                          AggType aggtype, amgTimings_t& timings){
+
+  parCSR& A = level.A;
+  parCSR& Acoarse = coarseLevel.A;
+
+  timePoint_t start = Time();
+  if (aggtype == SMOOTHED) {
+    parCSR AP = SpMM(A, level.P);
+    SpMM(level.R, AP, Acoarse);
+  } else {
+    galerkinProd(A, level.P, Acoarse); //specialize for unsmoothed aggregation
+  }
+  timePoint_t end = Time();
+  timings.galerkin += ElapsedTime(start, end);
+
+  start = Time();
+  Acoarse.diagSetup();
+  end = Time();
+  timings.smoother += ElapsedTime(start, end);
+}
+
 } //namespace parAlmond
 
 } //namespace libp
@@ -31,7 +31,8 @@ namespace libp {
 
 namespace parAlmond {
 
-parCSR galerkinProd(parCSR& A, parCSR& P){
+//form the nonzeros of P^T*A*P, sorted by row and col
+static parCOO galerkinProdEntries(parCSR& A, parCSR& P){
 
   // MPI info
   int rank = A.comm.rank();
@@ -185,10 +186,21 @@ parCSR galerkinProd(parCSR& A, parCSR& P){
     }
   }
 
+  return PTAP;
+}
+
+parCSR galerkinProd(parCSR& A, parCSR& P){
   //build Ac from coo matrix
+  parCOO PTAP = galerkinProdEntries(A, P);
   return parCSR(PTAP);
 }
 
+//numeric-only product. Ac must already hold the sparsity pattern of P^T*A*P
+void galerkinProd(parCSR& A, parCSR& P, parCSR& Ac){
+  parCOO PTAP = galerkinProdEntries(A, P);
+  Ac.updateValues(PTAP);
+}
+
 } //namespace parAlmond
 
 } //namespace libp
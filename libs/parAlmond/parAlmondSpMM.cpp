@@ -31,7 +31,8 @@ namespace libp {
 
 namespace parAlmond {
 
-parCSR SpMM(parCSR& A, parCSR& B){
+//form the nonzeros of C = A*B, sorted by row and col
+static parCOO SpMMEntries(parCSR& A, parCSR& B){
 
   // MPI info
   int rank = A.comm.rank();
@@ -125,7 +126,8 @@ parCSR SpMM(parCSR& A, parCSR& B){
   //we now have all the needed nonlocal rows (should also be sorted by row then col)
 
   //make an array of row offsets so we know how large each row is
-  memory<dlong> BoffdRowOffsets(A.Ncols-A.NlocalCols+1, 0);
+  const dlong NhaloRows = A.Ncols-A.NlocalCols;
+  memory<dlong> BoffdRowOffsets(NhaloRows+1, 0);
 
   dlong id=0;
   for (dlong n=0;n<Boffdnnz;n++) {
@@ -137,101 +139,69 @@ parCSR SpMM(parCSR& A, parCSR& B){
   }
 
   //cumulative sum
-  for (dlong n=0;n<A.Ncols-A.NlocalCols;n++)
+  for (dlong n=0;n<NhaloRows;n++)
     BoffdRowOffsets[n+1] += BoffdRowOffsets[n];
 
+  // Gather every row of B that A touches into one CSR block with global
+  // column ids, indexed by the column ids of A: the local rows of B first,
+  // then the received halo rows
+  memory<dlong> BrowStarts(A.Ncols+1);
+  BrowStarts[0] = 0;
+  for (dlong i=0;i<A.NlocalCols;i++) {
+    BrowStarts[i+1] = BrowStarts[i]
+                     + B.diag.rowStarts[i+1]-B.diag.rowStarts[i]
+                     + B.offd.rowStarts[i+1]-B.offd.rowStarts[i];
+  }
+  for (dlong n=0;n<NhaloRows;n++) {
+    BrowStarts[A.NlocalCols+n+1] = BrowStarts[A.NlocalCols+n]
+                                  + BoffdRowOffsets[n+1]-BoffdRowOffsets[n];
+  }
 
-  // The next step to compute C = A*B is to multiply each entry A(i,j) by the
-  // row B(j,:), store the all the results, sort them by row+col, and compress
-  // the entries
+  memory<hlong>  Bcols(BrowStarts[A.Ncols]);
+  memory<pfloat> Bvals(BrowStarts[A.Ncols]);
 
-  // Find how big the intermediate form is
-  nnzTotal = 0;
-  for (dlong i=0;i<A.Nrows;i++) {
-    //local entries
-    dlong start = A.diag.rowStarts[i];
-    dlong end   = A.diag.rowStarts[i+1];
-    for (dlong j=start;j<end;j++) {
-      const dlong col = A.diag.cols[j];
-      const int nnzBj =  B.diag.rowStarts[col+1]-B.diag.rowStarts[col]
-                        +B.offd.rowStarts[col+1]-B.offd.rowStarts[col];
-      nnzTotal += nnzBj;
+  #pragma omp parallel for
+  for (dlong i=0;i<A.NlocalCols;i++) {
+    dlong cnt = BrowStarts[i];
+    for (dlong jj=B.diag.rowStarts[i]; jj<B.diag.rowStarts[i+1];jj++){
+      Bcols[cnt] = B.diag.cols[jj] + B.globalColStarts[rank]; //global id
+      Bvals[cnt] = B.diag.vals[jj];
+      cnt++;
     }
-    //non-local entries
-    start = A.offd.rowStarts[i];
-    end   = A.offd.rowStarts[i+1];
-    for (dlong j=start;j<end;j++) {
-      const dlong col = A.offd.cols[j]-A.NlocalCols;
-      const int nnzBj = BoffdRowOffsets[col+1] - BoffdRowOffsets[col];
-      nnzTotal += nnzBj;
+    for (dlong jj=B.offd.rowStarts[i]; jj<B.offd.rowStarts[i+1];jj++){
+      Bcols[cnt] = B.colMap[B.offd.cols[jj]]; //global id
+      Bvals[cnt] = B.offd.vals[jj];
+      cnt++;
     }
   }
 
-  memory<parCOO::nonZero_t> Ctmp(nnzTotal);
-
-  // Fill the intermediate form of C
-  dlong cnt = 0;
-  for (dlong i=0;i<A.Nrows;i++) {
-    //local A entries
-    dlong start = A.diag.rowStarts[i];
-    dlong end   = A.diag.rowStarts[i+1];
-    for (dlong j=start;j<end;j++) {
-      const dlong col = A.diag.cols[j];
-      const dfloat Aval = A.diag.vals[j];
-
-      //local B entries
-      dlong Bstart = B.diag.rowStarts[col];
-      dlong Bend   = B.diag.rowStarts[col+1];
-      for (dlong jj=Bstart;jj<Bend;jj++) {
-        Ctmp[cnt].row = i + A.globalRowStarts[rank];
-        Ctmp[cnt].col = B.diag.cols[jj]+B.globalColStarts[rank]; //global id
-        Ctmp[cnt].val = Aval*B.diag.vals[jj];
-        cnt++;
-      }
-      //non-local B entries
-      Bstart = B.offd.rowStarts[col];
-      Bend   = B.offd.rowStarts[col+1];
-      for (dlong jj=Bstart;jj<Bend;jj++) {
-        Ctmp[cnt].row = i + A.globalRowStarts[rank];
-        Ctmp[cnt].col = B.colMap[B.offd.cols[jj]]; //global id
-        Ctmp[cnt].val = Aval*B.offd.vals[jj];
-        cnt++;
-      }
-    }
-    //non-local A entries
-    start = A.offd.rowStarts[i];
-    end   = A.offd.rowStarts[i+1];
-    for (dlong j=start;j<end;j++) {
-      const dlong col = A.offd.cols[j]-A.NlocalCols;
-      const dfloat Aval = A.offd.vals[j];
-
-      // entries from recived rows of B
-      dlong Bstart = BoffdRowOffsets[col];
-      dlong Bend   = BoffdRowOffsets[col+1];
-      for (dlong jj=Bstart;jj<Bend;jj++) {
-        Ctmp[cnt].row = i + A.globalRowStarts[rank];
-        Ctmp[cnt].col = BoffdRows[jj].col; //global id
-        Ctmp[cnt].val = Aval*BoffdRows[jj].val;
-        cnt++;
-      }
+  #pragma omp parallel for
+  for (dlong n=0;n<NhaloRows;n++) {
+    dlong cnt = BrowStarts[A.NlocalCols+n];
+    for (dlong jj=BoffdRowOffsets[n];jj<BoffdRowOffsets[n+1];jj++) {
+      Bcols[cnt] = BoffdRows[jj].col; //global id
+      Bvals[cnt] = BoffdRows[jj].val;
+      cnt++;
     }
   }
 
-  //sort entries by the row and col
-  std::sort(Ctmp.ptr(), Ctmp.ptr()+nnzTotal,
-            [](const parCOO::nonZero_t& a, const parCOO::nonZero_t& b) {
-              if (a.row < b.row) return true;
-              if (a.row > b.row) return false;
+  //symbolic pass to size the rows of C, then numeric pass to fill them
+  memory<dlong> CrowStarts(A.Nrows+1);
+  linAlg_t::SpGEMMSymbolic(A.Nrows,
+                           A.diag.rowStarts, A.diag.cols,
+                           A.offd.rowStarts, A.offd.cols,
+                           BrowStarts, Bcols,
+                           CrowStarts);
 
-              return a.col < b.col;
-            });
+  const dlong nnz = CrowStarts[A.Nrows];
+  memory<hlong>  Ccols(nnz);
+  memory<pfloat> Cvals(nnz);
 
-  //count total number of nonzeros;
-  dlong nnz =0;
-  if (nnzTotal) nnz++;
-  for (dlong i=1;i<nnzTotal;i++)
-    if ((Ctmp[i].row!=Ctmp[i-1].row)||
-        (Ctmp[i].col!=Ctmp[i-1].col)) nnz++;
+  linAlg_t::SpGEMMNumeric(A.Nrows,
+                          A.diag.rowStarts, A.diag.cols, A.diag.vals,
+                          A.offd.rowStarts, A.offd.cols, A.offd.vals,
+                          BrowStarts, Bcols, Bvals,
+                          CrowStarts, Ccols, Cvals);
 
   parCOO cooC(A.platform, A.comm);
 
@@ -242,22 +212,31 @@ parCSR SpMM(parCSR& A, parCSR& B){
   cooC.nnz = nnz;
   cooC.entries.malloc(nnz);
 
-  //compress nonzeros
-  nnz = 0;
-  if (nnzTotal) cooC.entries[nnz++] = Ctmp[0];
-  for (dlong i=1;i<nnzTotal;i++) {
-    if ((Ctmp[i].row!=Ctmp[i-1].row)||
-        (Ctmp[i].col!=Ctmp[i-1].col)) {
-      cooC.entries[nnz++] = Ctmp[i];
-    } else {
-      cooC.entries[nnz-1].val += Ctmp[i].val;
+  //rows of C are already column sorted
+  #pragma omp parallel for
+  for (dlong i=0;i<A.Nrows;i++) {
+    for (dlong jj=CrowStarts[i];jj<CrowStarts[i+1];jj++) {
+      cooC.entries[jj].row = i + A.globalRowStarts[rank];
+      cooC.entries[jj].col = Ccols[jj];
+      cooC.entries[jj].val = Cvals[jj];
     }
   }
 
+  return cooC;
+}
+
+parCSR SpMM(parCSR& A, parCSR& B){
   //build C from coo matrix
+  parCOO cooC = SpMMEntries(A, B);
   return parCSR(cooC);
 }
 
+//numeric-only product. C must already hold the sparsity pattern of A*B
+void SpMM(parCSR& A, parCSR& B, parCSR& C){
+  parCOO cooC = SpMMEntries(A, B);
+  C.updateValues(cooC);
+}
+
 } //namespace parAlmond
 
 } //namespace libp
@@ -233,6 +233,38 @@ parCSR::parCSR(parCOO& A):       // number of nonzeros on this rank
   }
 }
 
+//refill the matrix values from a distributed COO matrix. The COO matrix
+// must have the same nonzeros, in the same order, as the one this matrix
+// was built from.
+void parCSR::updateValues(parCOO& A) {
+
+  int rank = comm.rank();
+
+  const hlong globalColOffset = globalColStarts[rank];
+
+  LIBP_ABORT("parCSR::updateValues called with a matrix of different size",
+             A.nnz != diag.nnz+offd.nnz);
+
+  bool samePattern = true;
+  dlong diagCnt = 0;
+  dlong offdCnt = 0;
+  for (dlong n=0;n<A.nnz;n++) {
+    if ( (A.entries[n].col < globalColOffset)
+      || (A.entries[n].col > globalColOffset+NlocalCols-1)) {
+      samePattern = samePattern && (colMap[offd.cols[offdCnt]] == A.entries[n].col);
+      offd.vals[offdCnt] = A.entries[n].val;
+      offdCnt++;
+    } else {
+      samePattern = samePattern && (diag.cols[diagCnt] == static_cast<dlong>(A.entries[n].col - globalColOffset));
+      diag.vals[diagCnt] = A.entries[n].val;
+      diagCnt++;
+    }
+  }
+
+  LIBP_ABORT("parCSR::updateValues called with a different sparsity pattern",
+             !samePattern || diagCnt != diag.nnz || offdCnt != offd.nnz);
+}
+
 //------------------------------------------------------------------------
 //
 //  parCSR halo setup
@@ -556,6 +588,21 @@ void parCSR::syncToDevice() {
   }
 }
 
+//refresh the device copies of the values and diagonals, leaving the
+// sparsity pattern and row blocking in place
+void parCSR::syncValuesToDevice() {
+
+  if (Nrows) {
+    if (diag.nnz) diag.o_vals.copyFrom(diag.vals);
+    if (offd.nnz) offd.o_vals.copyFrom(offd.vals);
+
+    if (diagA.size()) {
+      o_diagA.copyFrom(diagA);
+      o_diagInv.copyFrom(diagInv);
+    }
+  }
+}
+
 } //namespace parAlmond
 
 } //namespace libp
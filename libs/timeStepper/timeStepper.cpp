@@ -33,7 +33,29 @@ void timeStepper_t::Run(solver_t& solver,
                         deviceMemory<dfloat>& o_q,
                         dfloat start, dfloat end) {
   assertInitialized();
+
+  if (adaptive) ts->SetupAdaptiveTimeStep(solver);
+  if (checkpointing) ts->SetupCheckpoint(solver, o_q);
+
+  platform_t& platform = ts->platform;
+  const bool memoryReport = platform.settings().compareSetting("MEMORY REPORT", "TRUE");
+  const memoryStats_t stats = platform.memoryStats();
+
   ts->Run(solver, o_q, start, end);
+
+  //write the last staged checkpoint
+  if (checkpointing) ts->FinishCheckpoint();
+
+  //the time step loop should not allocate
+  if (memoryReport) platform.MemoryReport("Time stepping", stats);
+}
+
+void timeStepper_t::EnableCheckpointing() {
+  checkpointing = true;
+}
+
+void timeStepper_t::EnableAdaptiveTimeStep() {
+  adaptive = true;
 }
 
 void timeStepper_t::SetTimeStep(dfloat dt_) {
@@ -56,4 +78,22 @@ void timeStepper_t::assertInitialized() {
              ts==nullptr);
 }
 
+namespace TimeStepper {
+
+void timeStepperBase_t::SetupAdaptiveTimeStep(solver_t& solver) {
+
+  settings_t& settings = solver.settings;
+
+  adaptInterval = 0;
+  if (settings.compareSetting("ADAPTIVE TIME STEP", "TRUE")) {
+    LIBP_ABORT("Requested TIME INTEGRATOR does not support ADAPTIVE TIME STEP",
+               !variableStep);
+    settings.getSetting("TIME STEP UPDATE INTERVAL", adaptInterval);
+    LIBP_ABORT("TIME STEP UPDATE INTERVAL must be positive",
+               adaptInterval<1);
+  }
+}
+
+} //namespace TimeStepper
+
 } //namespace libp
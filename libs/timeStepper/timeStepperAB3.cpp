@@ -66,33 +66,79 @@ ab3::ab3(dlong Nelements, dlong NhaloElements,
   ab_a.copyFrom(_ab_a);
 
   o_ab_a = platform.malloc<dfloat>(ab_a);
+
+  //variable step support
+  variableStep = true;
+  dtPrev.malloc(Nstages-1, 0.0);
+  ab_vs.malloc(Nstages, 0.0);
+  o_ab_vs = platform.malloc<dfloat>(ab_vs);
 }
 
 void ab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
+  int tstep=0;
+
+  //resume from a checkpoint
+  Restart(time, tstep);
 
-  solver.Report(time,0);
+  solver.Report(time,tstep);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
 
   dfloat outputTime = time + outputInterval;
 
-  int tstep=0;
-  int order=0;
+  int order=std::min(tstep, Nstages-1);
   while (time < end) {
+    AdaptTimeStep(solver, o_q, time, tstep);
+
     Step(solver, o_q, time, dt, order);
     time += dt;
     tstep++;
     if (order<Nstages-1) order++;
 
+    //shift step size history
+    for (int i=Nstages-2;i>0;--i) dtPrev[i] = dtPrev[i-1];
+    dtPrev[0] = dt;
+
     if (time>outputTime) {
       //report state
       solver.Report(time,tstep);
       outputTime += outputInterval;
     }
+
+    Checkpoint(time, tstep);
+  }
+}
+
+deviceMemory<dfloat> ab3::Coefficients(const dfloat _dt, const int order) {
+
+  //fixed step coefficients while the recent steps all had size _dt
+  bool uniform = true;
+  for (int i=0;i<order;++i) {
+    if (dtPrev[i]!=_dt) uniform = false;
   }
+  if (uniform) return o_ab_a + order*Nstages;
+
+  for (int i=0;i<Nstages;++i) ab_vs[i] = 0.0;
+  AdamsBashforthWeights(order, _dt, dtPrev, ab_vs);
+  o_ab_vs.copyFrom(ab_vs);
+  return o_ab_vs;
+}
+
+void ab3::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  o_fields.push_back(o_rhsq);
+}
+
+void ab3::PackState(std::vector<dfloat>& state) {
+  state.push_back(shiftIndex);
+  for (int i=0;i<Nstages-1;++i) state.push_back(dtPrev[i]);
+}
+
+void ab3::UnpackState(const memory<dfloat> state) {
+  shiftIndex = static_cast<int>(state[0]);
+  for (int i=0;i<Nstages-1;++i) dtPrev[i] = state[1+i];
 }
 
 void ab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt, int order) {
@@ -101,7 +147,7 @@ void ab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat
   deviceMemory<dfloat> o_rhsq0 = o_rhsq + shiftIndex*N;
 
   //A coefficients at current order
-  deviceMemory<dfloat> o_A = o_ab_a + order*Nstages;
+  deviceMemory<dfloat> o_A = Coefficients(_dt, order);
 
   //evaluate ODE rhs = f(q,t)
   solver.rhsf(o_q, o_rhsq0, time);
@@ -136,6 +182,12 @@ ab3_pml::ab3_pml(dlong Nelements, dlong NpmlElements, dlong NhaloElements,
   }
 }
 
+void ab3_pml::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  ab3::CheckpointFields(o_fields);
+  o_fields.push_back(o_pmlq);
+  o_fields.push_back(o_rhspmlq);
+}
+
 void ab3_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt, int order) {
 
   //rhs at current index
@@ -144,7 +196,7 @@ void ab3_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfl
   if (Npml)    o_rhspmlq0 = o_rhspmlq + shiftIndex*Npml;
 
   //A coefficients at current order
-  deviceMemory<dfloat> o_A = o_ab_a + order*Nstages;
+  deviceMemory<dfloat> o_A = Coefficients(_dt, order);
 
   //evaluate ODE rhs = f(q,t)
   solver.rhsf_pml(o_q, o_pmlq, o_rhsq0, o_rhspmlq0, time);
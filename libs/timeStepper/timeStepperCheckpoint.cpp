@@ -0,0 +1,360 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "core.hpp"
+#include "timeStepper.hpp"
+
+namespace libp {
+
+namespace TimeStepper {
+
+/*
+  Checkpoint file layout. One file shared by all ranks. A fixed size header
+  is followed by the table of per-rank field lengths, the host state, and
+  then each field stored contiguously in rank order.
+*/
+namespace {
+
+constexpr char checkpointMagic[8] = {'L','I','B','P','C','H','K','\0'};
+constexpr int checkpointVersion = 2;
+
+struct checkpointHeader_t {
+  char magic[8];
+  int32_t version;
+  int32_t size;
+  int32_t sizeofDfloat;
+  int32_t Nfields, Nstate;
+  int32_t tstep;
+};
+
+std::string CheckpointFileName(const std::string name, const int tstep) {
+  char fileName[BUFSIZ];
+  sprintf(fileName, "%s_%06d.chk", name.c_str(), tstep);
+  return std::string(fileName);
+}
+
+/*Collective read/write in blocks to keep MPI counts in range. All ranks
+  must make the same number of calls*/
+constexpr size_t blockSize = size_t(1)<<30;
+
+void WriteAll(MPI_File fh, MPI_Offset offset, const char* buf,
+              const size_t Nbytes, comm_t comm) {
+  hlong Nblocks = static_cast<hlong>((Nbytes+blockSize-1)/blockSize);
+  comm.Allreduce(Nblocks, Comm::Max);
+  for (hlong b=0;b<Nblocks;++b) {
+    const size_t start = std::min(static_cast<size_t>(b)*blockSize, Nbytes);
+    const int count = static_cast<int>(std::min(blockSize, Nbytes-start));
+    MPI_File_write_at_all(fh, offset+start, buf+start,
+                          count, MPI_CHAR, MPI_STATUS_IGNORE);
+  }
+}
+
+void ReadAll(MPI_File fh, MPI_Offset offset, char* buf,
+             const size_t Nbytes, comm_t comm) {
+  hlong Nblocks = static_cast<hlong>((Nbytes+blockSize-1)/blockSize);
+  comm.Allreduce(Nblocks, Comm::Max);
+  for (hlong b=0;b<Nblocks;++b) {
+    const size_t start = std::min(static_cast<size_t>(b)*blockSize, Nbytes);
+    const int count = static_cast<int>(std::min(blockSize, Nbytes-start));
+    MPI_File_read_at_all(fh, offset+start, buf+start,
+                         count, MPI_CHAR, MPI_STATUS_IGNORE);
+  }
+}
+
+} //namespace
+
+checkpoint_t::checkpoint_t(platform_t& _platform, comm_t _comm,
+                           const std::string _fileName,
+                           std::vector<deviceMemory<dfloat>> _o_fields):
+  platform(_platform),
+  comm(_comm),
+  fileName(_fileName),
+  o_fields(_o_fields) {
+
+  dataStream = platform.device.createStream();
+
+  const int size = comm.size();
+  const int Nfields = static_cast<int>(o_fields.size());
+
+  //gather the field lengths of all ranks
+  memory<hlong> Nlocal(Nfields);
+  hlong NlocalTotal = 0;
+  for (int f=0;f<Nfields;++f) {
+    Nlocal[f] = static_cast<hlong>(o_fields[f].length());
+    NlocalTotal += Nlocal[f];
+  }
+  Nentries.malloc(size*Nfields);
+  comm.Allgather(Nlocal, Nentries);
+
+  LIBP_ABORT("Checkpoint of " << NlocalTotal << " entries exceeds the dlong range",
+             NlocalTotal > static_cast<hlong>(std::numeric_limits<dlong>::max()));
+  Ntotal = static_cast<dlong>(NlocalTotal);
+
+  o_snapshot = platform.malloc<dfloat>(Ntotal);
+  h_snapshot = platform.hostMalloc<dfloat>(Ntotal);
+}
+
+void checkpoint_t::Stage(const int tstep, const memory<dfloat> _state) {
+
+  //write out any checkpoint still in flight
+  Flush();
+
+  //snapshot the fields on the compute stream so the next step may overwrite them
+  dlong offset = 0;
+  for (auto& o_field: o_fields) {
+    const dlong Nfield = static_cast<dlong>(o_field.length());
+    o_snapshot.copyFrom(o_field, Nfield, offset);
+    offset += Nfield;
+  }
+
+  device_t &device = platform.device;
+  stream_t currentStream = device.getStream();
+
+  //wait for the snapshot to be ready
+  device.finish();
+
+  //queue copy to host
+  device.setStream(dataStream);
+  h_snapshot.copyFrom(o_snapshot, Ntotal,
+                      0, properties_t("async", true));
+  device.setStream(currentStream);
+
+  state = _state.clone();
+  stagedStep = tstep;
+}
+
+void checkpoint_t::Flush() {
+
+  if (stagedStep<0) return;
+
+  //synchronize data stream to ensure the snapshot is on the host
+  device_t &device = platform.device;
+  stream_t currentStream = device.getStream();
+  device.setStream(dataStream);
+  device.finish();
+  device.setStream(currentStream);
+
+  const int rank = comm.rank();
+  const int size = comm.size();
+  const int Nfields = static_cast<int>(o_fields.size());
+  const int Nstate = static_cast<int>(state.length());
+
+  const std::string name = CheckpointFileName(fileName, stagedStep);
+
+  MPI_File fh;
+  int err = MPI_File_open(comm.comm(), name.c_str(),
+                          MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                          MPI_INFO_NULL, &fh);
+  LIBP_ABORT("Cannot open checkpoint file: " << name,
+             err!=MPI_SUCCESS);
+  MPI_File_set_size(fh, 0);
+
+  MPI_Offset offset = 0;
+  if (rank==0) {
+    checkpointHeader_t header;
+    std::memcpy(header.magic, checkpointMagic, sizeof(checkpointMagic));
+    header.version = checkpointVersion;
+    header.size = size;
+    header.sizeofDfloat = static_cast<int32_t>(sizeof(dfloat));
+    header.Nfields = Nfields;
+    header.Nstate = Nstate;
+    header.tstep = stagedStep;
+
+    MPI_File_write_at(fh, offset, &header, sizeof(checkpointHeader_t),
+                      MPI_CHAR, MPI_STATUS_IGNORE);
+    MPI_File_write_at(fh, offset+sizeof(checkpointHeader_t),
+                      Nentries.ptr(), size*Nfields*sizeof(hlong),
+                      MPI_CHAR, MPI_STATUS_IGNORE);
+    MPI_File_write_at(fh, offset+sizeof(checkpointHeader_t)+size*Nfields*sizeof(hlong),
+                      state.ptr(), Nstate*sizeof(dfloat),
+                      MPI_CHAR, MPI_STATUS_IGNORE);
+  }
+  offset += sizeof(checkpointHeader_t) + size*Nfields*sizeof(hlong) + Nstate*sizeof(dfloat);
+
+  //each field is stored contiguously in rank order
+  dlong localOffset = 0;
+  for (int f=0;f<Nfields;++f) {
+    hlong rankOffset = 0, Nglobal = 0;
+    for (int r=0;r<size;++r) {
+      if (r<rank) rankOffset += Nentries[r*Nfields+f];
+      Nglobal += Nentries[r*Nfields+f];
+    }
+    const size_t Nlocal = static_cast<size_t>(Nentries[rank*Nfields+f]);
+
+    WriteAll(fh, offset+rankOffset*sizeof(dfloat),
+             reinterpret_cast<const char*>(h_snapshot.ptr()+localOffset),
+             Nlocal*sizeof(dfloat), comm);
+
+    offset += Nglobal*sizeof(dfloat);
+    localOffset += static_cast<dlong>(Nlocal);
+  }
+  MPI_File_close(&fh);
+
+  if (rank==0) {
+    printf("Wrote checkpoint %s\n", name.c_str());
+  }
+  stagedStep = -1;
+}
+
+memory<dfloat> checkpoint_t::Read(const std::string restartFile, int& tstep) {
+
+  const int rank = comm.rank();
+  const int size = comm.size();
+  const int Nfields = static_cast<int>(o_fields.size());
+
+  MPI_File fh;
+  int err = MPI_File_open(comm.comm(), restartFile.c_str(),
+                          MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+  LIBP_ABORT("Cannot open restart file: " << restartFile,
+             err!=MPI_SUCCESS);
+
+  MPI_Offset offset = 0;
+  checkpointHeader_t header;
+  ReadAll(fh, offset, reinterpret_cast<char*>(&header),
+          sizeof(checkpointHeader_t), comm);
+  offset += sizeof(checkpointHeader_t);
+
+  LIBP_ABORT("File " << restartFile << " is not a libParanumal checkpoint",
+             std::memcmp(header.magic, checkpointMagic, sizeof(checkpointMagic))
+             || header.version!=checkpointVersion
+             || header.sizeofDfloat!=static_cast<int32_t>(sizeof(dfloat)));
+  LIBP_ABORT("Checkpoint " << restartFile << " was written by " << header.size
+             << " ranks, restarting requires the same number of ranks",
+             header.size!=size);
+  LIBP_ABORT("Checkpoint " << restartFile << " holds " << header.Nfields
+             << " fields, but this time stepper expects " << Nfields,
+             header.Nfields!=Nfields);
+
+  memory<hlong> fileNentries(size*Nfields);
+  ReadAll(fh, offset, reinterpret_cast<char*>(fileNentries.ptr()),
+          size*Nfields*sizeof(hlong), comm);
+  offset += size*Nfields*sizeof(hlong);
+
+  int mismatch = 0;
+  for (int n=0;n<size*Nfields;++n) {
+    if (fileNentries[n]!=Nentries[n]) mismatch = 1;
+  }
+  LIBP_ABORT("Checkpoint " << restartFile << " does not match the mesh partitioning of this run",
+             mismatch);
+
+  memory<dfloat> restartState(header.Nstate);
+  ReadAll(fh, offset, reinterpret_cast<char*>(restartState.ptr()),
+          header.Nstate*sizeof(dfloat), comm);
+  offset += header.Nstate*sizeof(dfloat);
+
+  dlong localOffset = 0;
+  for (int f=0;f<Nfields;++f) {
+    hlong rankOffset = 0, Nglobal = 0;
+    for (int r=0;r<size;++r) {
+      if (r<rank) rankOffset += Nentries[r*Nfields+f];
+      Nglobal += Nentries[r*Nfields+f];
+    }
+    const size_t Nlocal = static_cast<size_t>(Nentries[rank*Nfields+f]);
+
+    ReadAll(fh, offset+rankOffset*sizeof(dfloat),
+            reinterpret_cast<char*>(h_snapshot.ptr()+localOffset),
+            Nlocal*sizeof(dfloat), comm);
+
+    o_fields[f].copyFrom(h_snapshot+localOffset, Nlocal);
+
+    offset += Nglobal*sizeof(dfloat);
+    localOffset += static_cast<dlong>(Nlocal);
+  }
+  MPI_File_close(&fh);
+
+  if (rank==0) {
+    printf("Restarting from checkpoint %s at time step %d\n",
+           restartFile.c_str(), header.tstep);
+  }
+
+  tstep = header.tstep;
+  return restartState;
+}
+
+void timeStepperBase_t::SetupCheckpoint(solver_t& solver, deviceMemory<dfloat>& o_q) {
+
+  settings_t& settings = solver.settings;
+
+  settings.getSetting("CHECKPOINT INTERVAL", checkpointInterval);
+  settings.getSetting("RESTART FILE", restartFile);
+  if (restartFile=="NONE") restartFile.clear();
+
+  if (checkpointInterval==0 && restartFile.empty()) return;
+
+  std::string fileName;
+  settings.getSetting("CHECKPOINT FILE NAME", fileName);
+
+  //solution, stepper history, then any solver state
+  std::vector<deviceMemory<dfloat>> o_fields;
+  o_fields.push_back(o_q);
+  CheckpointFields(o_fields);
+  solver.CheckpointFields(o_fields);
+
+  checkpoint = checkpoint_t(platform, comm, fileName, o_fields);
+  checkpointStep = 0;
+}
+
+void timeStepperBase_t::FinishCheckpoint() {
+  checkpoint.Flush();
+}
+
+void timeStepperBase_t::StageCheckpoint(const dfloat time, const int tstep) {
+
+  //the step number is kept exactly in the file header
+  std::vector<dfloat> packed = {time, dt};
+  PackState(packed);
+
+  memory<dfloat> state(packed.size());
+  state.copyFrom(packed.data());
+
+  checkpoint.Stage(tstep, state);
+  checkpointStep = tstep;
+}
+
+bool timeStepperBase_t::Restart(dfloat& time, int& tstep) {
+
+  if (restartFile.empty()) return false;
+
+  memory<dfloat> state = checkpoint.Read(restartFile, tstep);
+
+  std::vector<dfloat> packed = {time, dt};
+  PackState(packed);
+  LIBP_ABORT("Checkpoint " << restartFile << " was written by a different time stepper",
+             state.length()!=packed.size());
+
+  time  = state[0];
+  dt    = state[1];
+  UnpackState(state+2);
+
+  //only resume once
+  restartFile.clear();
+  checkpointStep = tstep;
+  return true;
+}
+
+} //namespace TimeStepper
+
+} //namespace libp
@@ -121,15 +121,18 @@ void dopri5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dflo
   // int rank;
   // comm_rank_t(comm, &rank);
 
-  solver.Report(time,0);
+  int tstep=0, allStep=0;
+
+  //resume from a checkpoint
+  Restart(time, tstep);
+
+  solver.Report(time,tstep);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
 
   dfloat outputTime = time + outputInterval;
 
-  int tstep=0, allStep=0;
-
   while (time < end) {
 
     LIBP_ABORT("Time step became too small at time step = " << tstep,
@@ -213,6 +216,8 @@ void dopri5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dflo
     }
     dt = dtnew;
     allStep++;
+
+    Checkpoint(time, tstep);
   }
 
   // if (!rank)
@@ -231,6 +236,14 @@ void dopri5::AcceptStep(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_rq) {
   o_q.copyFrom(o_rq, N);
 }
 
+void dopri5::PackState(std::vector<dfloat>& state) {
+  state.push_back(facold);
+}
+
+void dopri5::UnpackState(const memory<dfloat> state) {
+  facold = state[0];
+}
+
 void dopri5::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt) {
 
   //RK step
@@ -347,6 +360,11 @@ void dopri5_pml::AcceptStep(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_r
     o_pmlq.copyFrom(o_rkpmlq, Npml);
 }
 
+void dopri5_pml::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  dopri5::CheckpointFields(o_fields);
+  o_fields.push_back(o_pmlq);
+}
+
 void dopri5_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt) {
 
   //RK step
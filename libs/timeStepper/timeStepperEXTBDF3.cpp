@@ -78,6 +78,14 @@ extbdf3::extbdf3(dlong Nelements, dlong NhaloElements,
 
   o_extbdf_a = platform.malloc<dfloat>(extbdf_a);
   o_extbdf_b = platform.malloc<dfloat>(extbdf_b);
+
+  //variable step support
+  variableStep = true;
+  dtPrev.malloc(Nstages-1, 0.0);
+  extbdf_vs_a.malloc(Nstages, 0.0);
+  extbdf_vs_b.malloc(Nstages+1, 0.0);
+  o_extbdf_vs_a = platform.malloc<dfloat>(extbdf_vs_a);
+  o_extbdf_vs_b = platform.malloc<dfloat>(extbdf_vs_b);
 }
 
 dfloat extbdf3::GetGamma() {
@@ -87,30 +95,56 @@ dfloat extbdf3::GetGamma() {
 void extbdf3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
+  int tstep=0;
 
-  solver.Report(time,0);
+  //resume from a checkpoint
+  Restart(time, tstep);
+
+  solver.Report(time,tstep);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
 
   dfloat outputTime = time + outputInterval;
 
-  int tstep=0;
-  int order=0;
+  int order=std::min(tstep, Nstages-1);
   while (time < end) {
+    AdaptTimeStep(solver, o_q, time, tstep);
+
     Step(solver, o_q, time, dt, order);
     time += dt;
     tstep++;
     if (order<Nstages-1) order++;
 
+    //shift step size history
+    for (int i=Nstages-2;i>0;--i) dtPrev[i] = dtPrev[i-1];
+    dtPrev[0] = dt;
+
     if (time>outputTime) {
       //report state
       solver.Report(time,tstep);
       outputTime += outputInterval;
     }
+
+    Checkpoint(time, tstep);
   }
 }
 
+void extbdf3::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  o_fields.push_back(o_qn);
+  o_fields.push_back(o_F);
+}
+
+void extbdf3::PackState(std::vector<dfloat>& state) {
+  state.push_back(shiftIndex);
+  for (int i=0;i<Nstages-1;++i) state.push_back(dtPrev[i]);
+}
+
+void extbdf3::UnpackState(const memory<dfloat> state) {
+  shiftIndex = static_cast<int>(state[0]);
+  for (int i=0;i<Nstages-1;++i) dtPrev[i] = state[1+i];
+}
+
 void extbdf3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt, int order) {
 
   //F(q) at current index
@@ -121,6 +155,24 @@ void extbdf3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfl
   deviceMemory<dfloat> o_B = o_extbdf_b + order*(Nstages+1);
   memory<dfloat> B = extbdf_b + order*(Nstages+1);
 
+  //variable step coefficients when the recent steps differ from _dt
+  bool uniform = true;
+  for (int i=0;i<order;++i) {
+    if (dtPrev[i]!=_dt) uniform = false;
+  }
+  if (!uniform) {
+    for (int i=0;i<Nstages;++i) extbdf_vs_a[i] = 0.0;
+    for (int i=0;i<Nstages+1;++i) extbdf_vs_b[i] = 0.0;
+    ExtrapolationWeights(order, _dt, dtPrev, extbdf_vs_a);
+    BackwardDifferenceWeights(order, _dt, dtPrev, extbdf_vs_b);
+    o_extbdf_vs_a.copyFrom(extbdf_vs_a);
+    o_extbdf_vs_b.copyFrom(extbdf_vs_b);
+
+    o_A = o_extbdf_vs_a;
+    o_B = o_extbdf_vs_b;
+    B = extbdf_vs_b;
+  }
+
   //evaluate explicit part of rhs: F(q,t)
   solver.rhs_imex_f(o_q, o_F0, time);
 
@@ -39,6 +39,9 @@ lserk4::lserk4(dlong Nelements, dlong NhaloElements,
 
   Nrk = 5;
 
+  //single step method, so dt may change freely
+  variableStep = true;
+
   o_resq = platform.malloc<dfloat>(N);
   o_rhsq = platform.malloc<dfloat>(N);
 
@@ -85,18 +88,23 @@ lserk4::lserk4(dlong Nelements, dlong NhaloElements,
 void lserk4::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
+  int tstep=0;
 
-  solver.Report(time,0);
+  //resume from a checkpoint
+  Restart(time, tstep);
+
+  solver.Report(time,tstep);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
 
   dfloat outputTime = time + outputInterval;
 
-  int tstep=0;
   dfloat stepdt;
   while (time < end) {
 
+    AdaptTimeStep(solver, o_q, time, tstep);
+
     if (time<outputTime && time+dt>=outputTime) {
 
       //save current state
@@ -126,6 +134,8 @@ void lserk4::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dflo
     Step(solver, o_q, time, stepdt);
     time += stepdt;
     tstep++;
+
+    Checkpoint(time, tstep);
   }
 }
 
@@ -165,6 +175,11 @@ lserk4_pml::lserk4_pml(dlong _Nelements, dlong _NpmlElements, dlong _NhaloElemen
   }
 }
 
+void lserk4_pml::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  lserk4::CheckpointFields(o_fields);
+  o_fields.push_back(o_pmlq);
+}
+
 void lserk4_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt) {
 
   // Low storage explicit Runge Kutta (5 stages, 4th order)
@@ -101,40 +101,48 @@ mrab3::mrab3(dlong Nelements, dlong NhaloElements,
 void mrab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
+  int tstep=0;
+
+  for (int lev=0;lev<Nlevels;lev++) {
+    h_shiftIndex[lev] = 0;
+  }
+
+  //resume from a checkpoint
+  const bool restarted = Restart(time, tstep);
 
   //set timesteps and shifting index
   for (int lev=0;lev<Nlevels;lev++) {
     mrdt[lev] = dt*(1 << lev);
-    h_shiftIndex[lev] = 0;
   }
   o_mrdt.copyFrom(mrdt);
   h_shiftIndex.copyTo(o_shiftIndex);
 
-  solver.Report(time,0);
+  solver.Report(time,tstep);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
 
   dfloat outputTime = time + outputInterval;
 
-  // Populate Trace Buffer
-  traceUpdateKernel(mesh.mrNelements[Nlevels-1],
-                    mesh.o_mrElements[Nlevels-1],
-                    mesh.o_mrLevel,
-                    mesh.o_vmapM,
-                    N,
-                    o_shiftIndex,
-                    o_mrdt,
-                    o_ab_b,
-                    o_rhsq0,
-                    o_rhsq,
-                    o_q,
-                    o_fQM);
+  // Populate Trace Buffer. A restart restores it with the history
+  if (!restarted) {
+    traceUpdateKernel(mesh.mrNelements[Nlevels-1],
+                      mesh.o_mrElements[Nlevels-1],
+                      mesh.o_mrLevel,
+                      mesh.o_vmapM,
+                      N,
+                      o_shiftIndex,
+                      o_mrdt,
+                      o_ab_b,
+                      o_rhsq0,
+                      o_rhsq,
+                      o_q,
+                      o_fQM);
+  }
 
   dfloat DT = dt*(1 << (Nlevels-1));
 
-  int tstep=0;
-  int order=0;
+  int order=std::min(tstep, Nstages-1);
   while (time < end) {
     Step(solver, o_q, time, dt, order);
     time += DT;
@@ -146,6 +154,26 @@ void mrab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
       solver.Report(outputTime,tstep);
       outputTime += outputInterval;
     }
+
+    Checkpoint(time, tstep);
+  }
+}
+
+void mrab3::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  o_fields.push_back(o_rhsq0);
+  o_fields.push_back(o_rhsq);
+  o_fields.push_back(o_fQM);
+}
+
+void mrab3::PackState(std::vector<dfloat>& state) {
+  for (int lev=0;lev<Nlevels;lev++) {
+    state.push_back(h_shiftIndex[lev]);
+  }
+}
+
+void mrab3::UnpackState(const memory<dfloat> state) {
+  for (int lev=0;lev<Nlevels;lev++) {
+    h_shiftIndex[lev] = static_cast<int>(state[lev]);
   }
 }
 
@@ -252,6 +280,13 @@ mrab3_pml::mrab3_pml(dlong Nelements, dlong NpmlElements, dlong NhaloElements,
   }
 }
 
+void mrab3_pml::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  mrab3::CheckpointFields(o_fields);
+  o_fields.push_back(o_pmlq);
+  o_fields.push_back(o_rhspmlq0);
+  o_fields.push_back(o_rhspmlq);
+}
+
 void mrab3_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt, int order) {
 
   deviceMemory<dfloat> o_A = o_ab_a+order*Nstages;
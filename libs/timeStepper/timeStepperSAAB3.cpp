@@ -77,8 +77,12 @@ saab3::saab3(dlong _Nelements, dlong _NhaloElements,
 void saab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
+  int tstep=0;
+
+  //resume from a checkpoint
+  Restart(time, tstep);
 
-  solver.Report(time,0);
+  solver.Report(time,tstep);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -88,8 +92,7 @@ void saab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
   //Compute SAAB coefficients
   UpdateCoefficients();
 
-  int tstep=0;
-  int order=0;
+  int order=std::min(tstep, Nstages-1);
   while (time < end) {
     Step(solver, o_q, time, dt, order);
     time += dt;
@@ -101,9 +104,23 @@ void saab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
       solver.Report(time,tstep);
       outputTime += outputInterval;
     }
+
+    Checkpoint(time, tstep);
   }
 }
 
+void saab3::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  o_fields.push_back(o_rhsq);
+}
+
+void saab3::PackState(std::vector<dfloat>& state) {
+  state.push_back(shiftIndex);
+}
+
+void saab3::UnpackState(const memory<dfloat> state) {
+  shiftIndex = static_cast<int>(state[0]);
+}
+
 void saab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt, int order) {
 
   //rhs at current index
@@ -252,6 +269,12 @@ saab3_pml::saab3_pml(dlong _Nelements, dlong _NpmlElements, dlong _NhaloElements
 }
 
 
+void saab3_pml::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  saab3::CheckpointFields(o_fields);
+  o_fields.push_back(o_pmlq);
+  o_fields.push_back(o_rhspmlq);
+}
+
 void saab3_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt, int order) {
 
   //rhs at current index
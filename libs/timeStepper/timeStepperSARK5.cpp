@@ -131,15 +131,18 @@ void sark5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
 
   int rank = comm.rank();
 
-  solver.Report(time,0);
+  int tstep=0, allStep=0;
+
+  //resume from a checkpoint
+  Restart(time, tstep);
+
+  solver.Report(time,tstep);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
 
   dfloat outputTime = time + outputInterval;
 
-  int tstep=0, allStep=0;
-
   //Compute Butcher Tableau
   UpdateCoefficients();
 
@@ -234,6 +237,8 @@ void sark5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
     UpdateCoefficients();
 
     allStep++;
+
+    Checkpoint(time, tstep);
   }
 
   if (!rank)
@@ -252,6 +257,14 @@ void sark5::AcceptStep(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_rq) {
   o_q.copyFrom(o_rq, N);
 }
 
+void sark5::PackState(std::vector<dfloat>& state) {
+  state.push_back(facold);
+}
+
+void sark5::UnpackState(const memory<dfloat> state) {
+  facold = state[0];
+}
+
 void sark5::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt) {
 
   //RK step
@@ -558,6 +571,11 @@ void sark5_pml::AcceptStep(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_rq
     o_pmlq.copyFrom(o_rkpmlq, Npml);
 }
 
+void sark5_pml::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  sark5::CheckpointFields(o_fields);
+  o_fields.push_back(o_pmlq);
+}
+
 void sark5_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt) {
 
   //RK step
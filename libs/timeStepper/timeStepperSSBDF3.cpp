@@ -76,16 +76,19 @@ dfloat ssbdf3::GetGamma() {
 void ssbdf3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
+  int tstep=0;
+
+  //resume from a checkpoint
+  Restart(time, tstep);
 
-  solver.Report(time,0);
+  solver.Report(time,tstep);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
 
   dfloat outputTime = time + outputInterval;
 
-  int tstep=0;
-  int order=0;
+  int order=std::min(tstep, Nstages-1);
   while (time < end) {
     Step(solver, o_q, time, dt, order);
     time += dt;
@@ -97,9 +100,23 @@ void ssbdf3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dflo
       solver.Report(time,tstep);
       outputTime += outputInterval;
     }
+
+    Checkpoint(time, tstep);
   }
 }
 
+void ssbdf3::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  o_fields.push_back(o_qn);
+}
+
+void ssbdf3::PackState(std::vector<dfloat>& state) {
+  state.push_back(shiftIndex);
+}
+
+void ssbdf3::UnpackState(const memory<dfloat> state) {
+  shiftIndex = static_cast<int>(state[0]);
+}
+
 void ssbdf3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt, int order) {
 
   //BDF coefficients at current order
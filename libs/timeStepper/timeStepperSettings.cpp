@@ -0,0 +1,58 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "timeStepper.hpp"
+
+namespace libp {
+
+namespace TimeStepper {
+
+void AddSettings(settings_t& settings) {
+
+  settings.newSetting("CHECKPOINT INTERVAL",
+                      "0",
+                      "Number of time steps between checkpoints (0 to disable)");
+
+  settings.newSetting("CHECKPOINT FILE NAME",
+                      "checkpoint",
+                      "Prefix for checkpoint files");
+
+  settings.newSetting("RESTART FILE",
+                      "NONE",
+                      "Checkpoint file to resume time stepping from");
+}
+
+void ReportSettings(settings_t& settings) {
+
+  settings.reportSetting("CHECKPOINT INTERVAL");
+  if (!settings.compareSetting("CHECKPOINT INTERVAL", "0"))
+    settings.reportSetting("CHECKPOINT FILE NAME");
+  settings.reportSetting("RESTART FILE");
+}
+
+} //namespace TimeStepper
+
+} //namespace libp
@@ -0,0 +1,143 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "core.hpp"
+#include "timeStepper.hpp"
+
+namespace libp {
+
+namespace TimeStepper {
+
+/*
+  Variable step multistep weights. All times are in units of the current
+  step dt, relative to the current time t. The history levels sit at
+  0, -dtPrev[0]/dt, -(dtPrev[0]+dtPrev[1])/dt, ...
+*/
+namespace {
+
+constexpr int maxNodes = 8;
+
+/*Monomial coefficients c[i*Nnodes+k] of the Lagrange basis polynomials
+  l_i(x) = sum_k c_ik x^k on the given nodes*/
+void LagrangeMonomials(const int Nnodes, const dfloat* x, dfloat* c) {
+  for (int i=0;i<Nnodes;++i) {
+    dfloat* ci = c + i*Nnodes;
+    for (int k=0;k<Nnodes;++k) ci[k] = 0.0;
+    ci[0] = 1.0;
+
+    int degree = 0;
+    for (int j=0;j<Nnodes;++j) {
+      if (j==i) continue;
+      const dfloat scale = 1.0/(x[i]-x[j]);
+      //multiply by (x - x_j)/(x_i - x_j)
+      for (int k=degree+1;k>0;--k) {
+        ci[k] = (ci[k-1] - x[j]*ci[k])*scale;
+      }
+      ci[0] = -x[j]*ci[0]*scale;
+      degree++;
+    }
+  }
+}
+
+void HistoryNodes(const int Nnodes, const dfloat dt,
+                  const memory<dfloat> dtPrev, dfloat* x) {
+  x[0] = 0.0;
+  for (int i=1;i<Nnodes;++i) {
+    x[i] = x[i-1] - dtPrev[i-1]/dt;
+  }
+}
+
+} //namespace
+
+/*Adams-Bashforth weights: q(t+dt) = q(t) + dt*sum_i a_i f_i*/
+void AdamsBashforthWeights(const int order, const dfloat dt,
+                           const memory<dfloat> dtPrev,
+                           memory<dfloat> a) {
+  const int Nnodes = order+1;
+  LIBP_ABORT("Multistep order too high", Nnodes>maxNodes);
+
+  dfloat x[maxNodes];
+  dfloat c[maxNodes*maxNodes];
+  HistoryNodes(Nnodes, dt, dtPrev, x);
+  LagrangeMonomials(Nnodes, x, c);
+
+  //a_i = int_0^1 l_i(x) dx
+  for (int i=0;i<Nnodes;++i) {
+    a[i] = 0.0;
+    for (int k=0;k<Nnodes;++k) {
+      a[i] += c[i*Nnodes+k]/(k+1);
+    }
+  }
+}
+
+/*Extrapolation weights: f(t+dt) ~ sum_i a_i f_i*/
+void ExtrapolationWeights(const int order, const dfloat dt,
+                          const memory<dfloat> dtPrev,
+                          memory<dfloat> a) {
+  const int Nnodes = order+1;
+  LIBP_ABORT("Multistep order too high", Nnodes>maxNodes);
+
+  dfloat x[maxNodes];
+  dfloat c[maxNodes*maxNodes];
+  HistoryNodes(Nnodes, dt, dtPrev, x);
+  LagrangeMonomials(Nnodes, x, c);
+
+  //a_i = l_i(1)
+  for (int i=0;i<Nnodes;++i) {
+    a[i] = 0.0;
+    for (int k=0;k<Nnodes;++k) {
+      a[i] += c[i*Nnodes+k];
+    }
+  }
+}
+
+/*Backward difference weights: dt*dq/dt(t+dt) ~ b_0 q(t+dt) - sum_i b_{i+1} q_i*/
+void BackwardDifferenceWeights(const int order, const dfloat dt,
+                               const memory<dfloat> dtPrev,
+                               memory<dfloat> b) {
+  const int Nnodes = order+2;
+  LIBP_ABORT("Multistep order too high", Nnodes>maxNodes);
+
+  //new level at 1, followed by the history levels
+  dfloat x[maxNodes];
+  dfloat c[maxNodes*maxNodes];
+  x[0] = 1.0;
+  HistoryNodes(Nnodes-1, dt, dtPrev, x+1);
+  LagrangeMonomials(Nnodes, x, c);
+
+  //b_i = -/+ l_i'(1)
+  for (int i=0;i<Nnodes;++i) {
+    dfloat dl = 0.0;
+    for (int k=1;k<Nnodes;++k) {
+      dl += k*c[i*Nnodes+k];
+    }
+    b[i] = (i==0) ? dl : -dl;
+  }
+}
+
+} //namespace TimeStepper
+
+} //namespace libp
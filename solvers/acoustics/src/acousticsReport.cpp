@@ -47,9 +47,6 @@ void acoustics_t::Report(dfloat time, int tstep){
     // output field files
     std::string name;
     settings.getSetting("OUTPUT FILE NAME", name);
-    char fname[BUFSIZ];
-    sprintf(fname, "%s_%04d_%04d.vtu", name.c_str(), mesh.rank, frame++);
-
-    PlotFields(q, std::string(fname));
+    PlotFields(q, name, frame++);
   }
 }
@@ -49,6 +49,10 @@ void acoustics_t::Run(){
   dfloat dt = cfl*hmin/(vmax*(mesh.N+1.)*(mesh.N+1.));
   timeStepper.SetTimeStep(dt);
 
+  //rounding error and timing of the single precision trace exchange
+  if (traceHalo.compressed)
+    traceHalo.ReportCompression(o_q, 1);
+
   timeStepper.Run(*this, o_q, startTime, finalTime);
 
   // output norm of final solution
@@ -62,6 +62,13 @@ acousticsSettings_t::acousticsSettings_t(comm_t _comm):
 
   newSetting("OUTPUT FILE NAME",
              "acoustics");
+
+  newSetting("HALO COMPRESSION",
+             "FALSE",
+             "Round trace halo data to single precision for MPI exchanges",
+             {"TRUE", "FALSE"});
+
+  TimeStepper::AddSettings(*this);
 }
 
 void acousticsSettings_t::report() {
@@ -75,6 +82,8 @@ void acousticsSettings_t::report() {
     reportSetting("OUTPUT INTERVAL");
     reportSetting("OUTPUT TO FILE");
     reportSetting("OUTPUT FILE NAME");
+    reportSetting("HALO COMPRESSION");
+    TimeStepper::ReportSettings(*this);
   }
 }
 
@@ -47,6 +47,7 @@ void acoustics_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   /*setup trace halo exchange */
   traceHalo = mesh.HaloTraceSetup(Nfields);
+  traceHalo.compressed = settings.compareSetting("HALO COMPRESSION", "TRUE");
 
   //setup timeStepper
   if (settings.compareSetting("TIME INTEGRATOR","AB3")){
@@ -62,6 +63,7 @@ void acoustics_t::Setup(platform_t& _platform, mesh_t& _mesh,
                                            mesh.totalHaloPairs,
                                            mesh.Np, Nfields, platform, comm);
   }
+  timeStepper.EnableCheckpointing();
 
   // set penalty parameter
   dfloat Lambda2 = 0.5;
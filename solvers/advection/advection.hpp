@@ -30,6 +30,7 @@ SOFTWARE.
 #include "core.hpp"
 #include "platform.hpp"
 #include "mesh.hpp"
+#include "mesh/meshVTU.hpp"
 #include "solver.hpp"
 #include "timeStepper.hpp"
 #include "linAlg.hpp"
@@ -50,6 +51,7 @@ public:
 class advection_t: public solver_t {
 public:
   mesh_t mesh;
+  vtuWriter_t vtu;
   timeStepper_t timeStepper;
 
   ogs::halo_t traceHalo;
@@ -79,11 +81,13 @@ public:
 
   void Report(dfloat time, int tstep);
 
-  void PlotFields(memory<dfloat> Q, const std::string fileName);
+  void PlotFields(memory<dfloat> Q, const std::string fileName, const int frame=-1);
 
   void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
 
   dfloat MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T);
+
+  dfloat MaxTimeStep(deviceMemory<dfloat>& o_Q, const dfloat T);
 };
 
 #endif
@@ -39,15 +39,14 @@ void advection_t::Run(){
                          mesh.o_z,
                          o_q);
 
-  dfloat cfl=1.0;
-  settings.getSetting("CFL NUMBER", cfl);
-
   // set time step
-  dfloat vmax = MaxWaveSpeed(o_q, startTime);
-
-  dfloat dt = cfl/(vmax*(mesh.N+1.)*(mesh.N+1.));
+  dfloat dt = MaxTimeStep(o_q, startTime);
   timeStepper.SetTimeStep(dt);
 
+  //rounding error and timing of the single precision trace exchange
+  if (traceHalo.compressed)
+    traceHalo.ReportCompression(o_q, 1);
+
   timeStepper.Run(*this, o_q, startTime, finalTime);
 
   // output norm of final solution
@@ -63,3 +62,13 @@ void advection_t::Run(){
   }
 
 }
+
+dfloat advection_t::MaxTimeStep(deviceMemory<dfloat>& o_Q, const dfloat T){
+
+  dfloat cfl=1.0;
+  settings.getSetting("CFL NUMBER", cfl);
+
+  dfloat vmax = MaxWaveSpeed(o_Q, T);
+
+  return cfl/(vmax*(mesh.N+1.)*(mesh.N+1.));
+}
@@ -43,6 +43,15 @@ advectionSettings_t::advectionSettings_t(comm_t _comm):
              "1.0",
              "Multiplier for timestep stability bound");
 
+  newSetting("ADAPTIVE TIME STEP",
+             "FALSE",
+             "Periodically recompute the time step from the CFL bound",
+             {"TRUE", "FALSE"});
+
+  newSetting("TIME STEP UPDATE INTERVAL",
+             "10",
+             "Number of time steps between time step updates");
+
   newSetting("START TIME",
              "0",
              "Start time for time integration");
@@ -62,6 +71,13 @@ advectionSettings_t::advectionSettings_t(comm_t _comm):
 
   newSetting("OUTPUT FILE NAME",
              "advection");
+
+  newSetting("HALO COMPRESSION",
+             "FALSE",
+             "Round trace halo data to single precision for MPI exchanges",
+             {"TRUE", "FALSE"});
+
+  TimeStepper::AddSettings(*this);
 }
 
 void advectionSettings_t::report() {
@@ -70,11 +86,16 @@ void advectionSettings_t::report() {
     std::cout << "Advection Settings:\n\n";
     reportSetting("DATA FILE");
     reportSetting("TIME INTEGRATOR");
+    reportSetting("ADAPTIVE TIME STEP");
+    if (compareSetting("ADAPTIVE TIME STEP", "TRUE"))
+      reportSetting("TIME STEP UPDATE INTERVAL");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
     reportSetting("OUTPUT INTERVAL");
     reportSetting("OUTPUT TO FILE");
     reportSetting("OUTPUT FILE NAME");
+    reportSetting("HALO COMPRESSION");
+    TimeStepper::ReportSettings(*this);
   }
 }
 
@@ -45,6 +45,7 @@ void advection_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   /*setup trace halo exchange */
   traceHalo = mesh.HaloTraceSetup(1); //one field
+  traceHalo.compressed = settings.compareSetting("HALO COMPRESSION", "TRUE");
 
   //setup timeStepper
   if (settings.compareSetting("TIME INTEGRATOR","AB3")){
@@ -60,6 +61,8 @@ void advection_t::Setup(platform_t& _platform, mesh_t& _mesh,
                                            mesh.totalHaloPairs,
                                            mesh.Np, 1, platform, comm);
   }
+  timeStepper.EnableCheckpointing();
+  timeStepper.EnableAdaptiveTimeStep();
 
   // compute samples of q at interpolation nodes
   q.malloc(Nlocal+Nhalo);
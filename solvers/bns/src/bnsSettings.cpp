@@ -91,6 +91,13 @@ bnsSettings_t::bnsSettings_t(comm_t& _comm):
 
   newSetting("OUTPUT FILE NAME",
              "bns");
+
+  newSetting("HALO COMPRESSION",
+             "FALSE",
+             "Round trace halo data to single precision for MPI exchanges",
+             {"TRUE", "FALSE"});
+
+  TimeStepper::AddSettings(*this);
 }
 
 void bnsSettings_t::report() {
@@ -111,6 +118,8 @@ void bnsSettings_t::report() {
     reportSetting("OUTPUT INTERVAL");
     reportSetting("OUTPUT TO FILE");
     reportSetting("OUTPUT FILE NAME");
+    reportSetting("HALO COMPRESSION");
+    TimeStepper::ReportSettings(*this);
   }
 }
 
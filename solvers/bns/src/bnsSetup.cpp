@@ -111,6 +111,9 @@ void bns_t::Setup(platform_t& _platform, mesh_t& _mesh,
     mesh.MultiRateSetup(EtoDT);
     mesh.MultiRatePmlSetup();
     multirateTraceHalo = mesh.MultiRateHaloTraceSetup(Nfields);
+    for (int lev=0;lev<mesh.mrNlevels;lev++) {
+      multirateTraceHalo[lev].compressed = settings.compareSetting("HALO COMPRESSION", "TRUE");
+    }
   }
 
   if (settings.compareSetting("TIME INTEGRATOR","MRAB3")){
@@ -156,12 +159,14 @@ void bns_t::Setup(platform_t& _platform, mesh_t& _mesh,
   } else {
     LIBP_FORCE_ABORT("Requested TIME INTEGRATOR not found.");
   }
+  timeStepper.EnableCheckpointing();
 
   //setup linear algebra module
   platform.linAlg().InitKernels({"innerProd"});
 
   /*setup trace halo exchange */
   traceHalo = mesh.HaloTraceSetup(Nfields);
+  traceHalo.compressed = settings.compareSetting("HALO COMPRESSION", "TRUE");
 
   // compute samples of q at interpolation nodes
   q.malloc(Nlocal+Nhalo, 0.0);
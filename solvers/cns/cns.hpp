@@ -30,6 +30,7 @@ SOFTWARE.
 #include "core.hpp"
 #include "platform.hpp"
 #include "mesh.hpp"
+#include "mesh/meshVTU.hpp"
 #include "solver.hpp"
 #include "timeStepper.hpp"
 #include "linAlg.hpp"
@@ -50,6 +51,7 @@ public:
 class cns_t: public solver_t {
 public:
   mesh_t mesh;
+  vtuWriter_t vtu;
 
   int Nfields;
   int Ngrads;
@@ -57,6 +59,8 @@ public:
   dfloat mu;
   dfloat gamma;
 
+  dfloat hmin; //smallest element length, for the viscous time step limit
+
   int cubature;
   int isothermal;
 
@@ -105,11 +109,13 @@ public:
 
   void Report(dfloat time, int tstep) override;
 
-  void PlotFields(memory<dfloat> Q, memory<dfloat> V, std::string fileName);
+  void PlotFields(memory<dfloat> Q, memory<dfloat> V, const std::string fileName, const int frame=-1);
 
   void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
 
   dfloat MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T);
+
+  dfloat MaxTimeStep(deviceMemory<dfloat>& o_Q, const dfloat T);
 };
 
 #endif
@@ -41,19 +41,14 @@ void cns_t::Run(){
                          mesh.o_z,
                          o_q);
 
-  dfloat cfl=1.0;
-  settings.getSetting("CFL NUMBER", cfl);
-
   // set time step
-  dfloat hmin = mesh.MinCharacteristicLength();
-  dfloat vmax = MaxWaveSpeed(o_q, startTime);
-
-  dfloat dtAdv  = cfl/(vmax*(mesh.N+1.)*(mesh.N+1.));
-  dfloat dtVisc = cfl*pow(hmin, 2)/(pow(mesh.N+1,4)*mu);
-
-  dfloat dt = std::min(dtAdv, dtVisc);
+  dfloat dt = MaxTimeStep(o_q, startTime);
   timeStepper.SetTimeStep(dt);
 
+  //rounding error and timing of the single precision trace exchange
+  if (fieldTraceHalo.compressed)
+    fieldTraceHalo.ReportCompression(o_q, 1);
+
   timeStepper.Run(*this, o_q, startTime, finalTime);
 
   // output norm of final solution
@@ -69,3 +64,16 @@ void cns_t::Run(){
   }
 
 }
+
+dfloat cns_t::MaxTimeStep(deviceMemory<dfloat>& o_Q, const dfloat T){
+
+  dfloat cfl=1.0;
+  settings.getSetting("CFL NUMBER", cfl);
+
+  dfloat vmax = MaxWaveSpeed(o_Q, T);
+
+  dfloat dtAdv  = cfl/(vmax*(mesh.N+1.)*(mesh.N+1.));
+  dfloat dtVisc = cfl*pow(hmin, 2)/(pow(mesh.N+1,4)*mu);
+
+  return std::min(dtAdv, dtVisc);
+}
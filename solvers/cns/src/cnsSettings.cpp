@@ -61,6 +61,15 @@ cnsSettings_t::cnsSettings_t(comm_t _comm):
              "1.0",
              "Multiplier for timestep stability bound");
 
+  newSetting("ADAPTIVE TIME STEP",
+             "FALSE",
+             "Periodically recompute the time step from the CFL bound",
+             {"TRUE", "FALSE"});
+
+  newSetting("TIME STEP UPDATE INTERVAL",
+             "10",
+             "Number of time steps between time step updates");
+
   newSetting("START TIME",
              "0",
              "Start time for time integration");
@@ -80,6 +89,13 @@ cnsSettings_t::cnsSettings_t(comm_t _comm):
 
   newSetting("OUTPUT FILE NAME",
              "cns");
+
+  newSetting("HALO COMPRESSION",
+             "FALSE",
+             "Round trace halo data to single precision for MPI exchanges",
+             {"TRUE", "FALSE"});
+
+  TimeStepper::AddSettings(*this);
 }
 
 void cnsSettings_t::report() {
@@ -93,11 +109,16 @@ void cnsSettings_t::report() {
     reportSetting("ISOTHERMAL");
     reportSetting("ADVECTION TYPE");
     reportSetting("TIME INTEGRATOR");
+    reportSetting("ADAPTIVE TIME STEP");
+    if (compareSetting("ADAPTIVE TIME STEP", "TRUE"))
+      reportSetting("TIME STEP UPDATE INTERVAL");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
     reportSetting("OUTPUT INTERVAL");
     reportSetting("OUTPUT TO FILE");
     reportSetting("OUTPUT FILE NAME");
+    reportSetting("HALO COMPRESSION");
+    TimeStepper::ReportSettings(*this);
   }
 }
 
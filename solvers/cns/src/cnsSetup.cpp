@@ -41,6 +41,9 @@ void cns_t::Setup(platform_t& _platform, mesh_t& _mesh,
   settings.getSetting("VISCOSITY", mu);
   settings.getSetting("GAMMA", gamma);
 
+  //the mesh is static, so find the smallest element length once
+  hmin = mesh.MinCharacteristicLength();
+
   cubature   = (settings.compareSetting("ADVECTION TYPE", "CUBATURE")) ? 1:0;
   isothermal = (settings.compareSetting("ISOTHERMAL", "TRUE")) ? 1:0;
 
@@ -74,6 +77,8 @@ void cns_t::Setup(platform_t& _platform, mesh_t& _mesh,
                                            mesh.totalHaloPairs,
                                            mesh.Np, Nfields, platform, comm);
   }
+  timeStepper.EnableCheckpointing();
+  timeStepper.EnableAdaptiveTimeStep();
 
   //setup linear algebra module
   platform.linAlg().InitKernels({"innerProd", "max"});
@@ -82,6 +87,10 @@ void cns_t::Setup(platform_t& _platform, mesh_t& _mesh,
   fieldTraceHalo = mesh.HaloTraceSetup(Nfields);
   gradTraceHalo  = mesh.HaloTraceSetup(Ngrads);
 
+  const bool compressHalo = settings.compareSetting("HALO COMPRESSION", "TRUE");
+  fieldTraceHalo.compressed = compressHalo;
+  gradTraceHalo.compressed  = compressHalo;
+
   // compute samples of q at interpolation nodes
   q.malloc(NlocalFields+NhaloFields);
   o_q = platform.malloc<dfloat>(q);
@@ -30,6 +30,7 @@ SOFTWARE.
 #include "core.hpp"
 #include "platform.hpp"
 #include "mesh.hpp"
+#include "mesh/meshVTU.hpp"
 #include "solver.hpp"
 #include "linAlg.hpp"
 #include "precon.hpp"
@@ -56,6 +57,7 @@ void ellipticAddSettings(settings_t& settings,
 class elliptic_t: public solver_t {
 public:
   mesh_t mesh;
+  vtuWriter_t vtu;
 
   dlong Ndofs, Nhalo;
   int Nfields;
@@ -65,7 +67,23 @@ public:
 
   int disc_ipdg, disc_c0;
 
+  bool cubatureAx=false; // over-integrate C0 Ax on hexes
+
+  //C0 hex elements whose geometric factors are computed from vertices.
+  // Trilinear elements are ordered first in each gather element list
+  bool trilinearAx=false;
+  dlong NlocalTrilinear=0, NglobalTrilinear=0;
+  deviceMemory<dlong> o_localGatherElementList;
+  deviceMemory<dlong> o_globalGatherElementList;
+  deviceMemory<dfloat> o_EXYZ;
+  deviceMemory<dfloat> o_gllzw;
+
   deviceMemory<dfloat> o_AqL;
+  deviceMemory<dfloat> o_AqLBatch; //local Ax workspace for batched Operator
+
+  //geometric factors streamed by the C0 Ax kernel. Coarse multigrid
+  // levels may hold single precision copies (see "defines/gfloat")
+  deviceMemory<char> o_AxwJ, o_Axggeo;
 
   ogs::halo_t traceHalo;
 
@@ -103,6 +121,8 @@ public:
 
   kernel_t maskKernel;
   kernel_t partialAxKernel;
+  kernel_t partialCubatureAxKernel;
+  kernel_t partialTrilinearAxKernel;
   kernel_t partialGradientKernel;
   kernel_t partialIpdgKernel;
 
@@ -120,15 +140,29 @@ public:
 
   void BoundarySetup();
 
+  void TrilinearSetup();
+
   void Run();
 
   int Solve(linearSolver_t& linearSolver, deviceMemory<dfloat> &o_x, deviceMemory<dfloat> &o_r,
             const dfloat tol, const int MAXIT, const int verbose);
 
-  void PlotFields(memory<dfloat>& Q, std::string fileName);
+  void PlotFields(memory<dfloat>& Q, const std::string fileName, const int frame=-1);
 
   void Operator(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq);
 
+  //apply the operator to several vectors with batched communication
+  void Operator(std::vector<deviceMemory<dfloat>>& o_qs,
+                std::vector<deviceMemory<dfloat>>& o_Aqs);
+
+  void PartialAx(const dlong start, const dlong end, const dlong Ntrilinear,
+                 deviceMemory<dlong>& o_elementList, deviceMemory<dfloat>& o_q,
+                 deviceMemory<dfloat>& o_Aq);
+
+  void ReportOperatorThroughput();
+
+  void AxAutotune(properties_t kernelInfo, const std::string gfloatName);
+
   void BuildOperatorMatrixIpdg(parAlmond::parCOO& A);
   void BuildOperatorMatrixContinuous(parAlmond::parCOO& A);
 
@@ -41,6 +41,8 @@ public:
   JacobiPrecon() = default;
   JacobiPrecon(elliptic_t& elliptic);
   void Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr);
+  bool Diagonal(deviceMemory<dfloat>& o_D);
+  bool UpdateLambda(const dfloat lambda);
 };
 
 //Inverse Mass Matrix preconditioner
@@ -77,9 +79,16 @@ public:
   ParAlmondPrecon() = default;
   ParAlmondPrecon(elliptic_t& elliptic);
   void Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr);
+
+  //rebuild the matrix for a new lambda and update the AMG hierarchy numerically
+  bool UpdateLambda(const dfloat lambda);
 };
 
-// Matrix-free p-Multigrid levels followed by AMG
+// Matrix-free p-Multigrid levels followed by AMG.
+// The level smoothers, their eigenvalue bounds and the coarse AMG are built
+// for the lambda at setup and are not updated if lambda changes later, e.g.
+// in ins velocity solves after a time step change. They go stale, which
+// costs iterations but does not change the solution
 class MultiGridPrecon: public operator_t {
 private:
   elliptic_t elliptic;
@@ -121,15 +130,43 @@ public:
   void Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr);
 };
 
+// Additive Schwarz with element patches extended one node into each
+//  neighbor. Each patch problem is approximated by a separable box operator
+//  and solved exactly with fast diagonalization (Quad2D and Hex3D only)
+class FDMPrecon: public operator_t {
+private:
+  elliptic_t elliptic;
+  mesh_t mesh;
+
+  //1D generalized eigenvectors and per-element inverse eigenvalue sums
+  memory<double> WR;
+  deviceMemory<dfloat> o_V, o_invL;
+
+  deviceMemory<dfloat> o_rL;
+
+  kernel_t fdmKernel, maskKernel;
+
+public:
+  FDMPrecon() = default;
+  FDMPrecon(elliptic_t& elliptic);
+  void Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr);
+
+  //shift the patch eigenvalues to a new lambda
+  bool UpdateLambda(const dfloat lambda);
+
+private:
+  void SetupInverseEigenvalues(const double lambda);
+};
+
 
 class MGLevel: public parAlmond::multigridLevel {
 public:
   elliptic_t elliptic;
   mesh_t mesh;
 
-  //prologation
+  //prologation. Device copy is stored as gfloat (see MULTIGRID PRECISION)
   memory<dfloat> P;
-  deviceMemory<dfloat> o_P;
+  deviceMemory<char> o_P;
 
   kernel_t coarsenKernel, partialCoarsenKernel;
   kernel_t prolongateKernel, partialProlongateKernel;
@@ -140,12 +177,16 @@ public:
 
   //smoothing params
   typedef enum {JACOBI=1,
-                CHEBYSHEV=2} SmootherType;
+                CHEBYSHEV=2,
+                LOCALPATCH=3} SmootherType;
   SmootherType stype;
 
   dfloat lambda1, lambda0;
   int ChebyshevIterations;
 
+  //wall time of SetupSmoother, slowest rank
+  double smootherSetupTime=0.0;
+
   static dlong NsmootherResidual, Nscratch;
   static memory<dfloat> smootherResidual;
   static deviceMemory<dfloat> o_smootherResidual;
@@ -156,6 +197,9 @@ public:
   //jacobi data
   deviceMemory<dfloat> o_invDiagA;
 
+  //local patch smoother
+  FDMPrecon patchPrecon;
+
   //build a p-multigrid level and connect it to the next one
   MGLevel() = default;
   MGLevel(elliptic_t& _elliptic,
@@ -176,6 +220,9 @@ public:
   void smoothJacobi    (deviceMemory<dfloat> &o_r, deviceMemory<dfloat> &o_X, bool xIsZero);
   void smoothChebyshev (deviceMemory<dfloat> &o_r, deviceMemory<dfloat> &o_X, bool xIsZero);
 
+  //Sr = S*r, where S is the inverse diagonal or the sum of element patch solves
+  void smootherApply(deviceMemory<dfloat> &o_r, deviceMemory<dfloat> &o_Sr);
+
   void Report();
 
   void SetupSmoother();
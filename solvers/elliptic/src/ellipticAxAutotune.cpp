@@ -0,0 +1,182 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.hpp"
+#include "timer.hpp"
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+struct axVariant_t {
+  std::string kernelName;
+  int Nblock;
+};
+
+std::string AxTuningFileName(platform_t& platform) {
+  return platform.getCacheDir() + "/ellipticAxAutotune.txt";
+}
+
+/* Find a cached variant for this key. Returns -1 if none is found */
+int ReadAxTuning(const std::string fileName, const std::string key,
+                 const std::vector<axVariant_t>& variants) {
+  std::ifstream file(fileName);
+  std::string line;
+  int choice = -1;
+  while (std::getline(file, line)) {
+    std::istringstream entry(line);
+    std::string type, mode, N, precision, kernelName;
+    int Nblock;
+    if (!(entry >> type >> mode >> N >> precision >> kernelName >> Nblock)) continue;
+    if (type + " " + mode + " " + N + " " + precision != key) continue;
+
+    for (size_t n=0;n<variants.size();++n) {
+      if (variants[n].kernelName==kernelName && variants[n].Nblock==Nblock)
+        choice = static_cast<int>(n);
+    }
+  }
+  return choice;
+}
+
+} //namespace
+
+/* Time the Hex3D C0 Ax kernel variants on this mesh and keep the fastest
+   in partialAxKernel. Choices are cached on disk keyed by element type,
+   thread model, degree, and geometric factor precision */
+void elliptic_t::AxAutotune(properties_t kernelInfo, const std::string gfloatName) {
+
+  if (!disc_c0 || cubatureAx || mesh.elementType!=Mesh::HEXAHEDRA) return;
+  if (!settings.compareSetting("ELLIPTIC AX AUTOTUNE", "TRUE")) return;
+
+  const std::string fileName = DELLIPTIC "/okl/ellipticAxHex3D.okl";
+  const std::string mode = platform.device.mode();
+  const bool cpuMode = (mode=="Serial" || mode=="OpenMP");
+
+  const int maxThreads = 1024;
+  const int Nq = mesh.Nq;
+
+  std::vector<axVariant_t> variants;
+  variants.push_back({"ellipticPartialAxHex3D", 1});
+  for (int Nblock=2;Nblock<=8;Nblock*=2) {
+    if (Nq*Nq*Nblock <= maxThreads)
+      variants.push_back({"ellipticPartialAxHex3D_vBlock", Nblock});
+  }
+  if (Nq*Nq*Nq <= maxThreads)
+    variants.push_back({"ellipticPartialAxHex3D_v3D", 1});
+  if (cpuMode)
+    variants.push_back({"ellipticPartialAxHex3D_vSerial", 1});
+
+  const std::string key = "Hex3D " + mode + " " + std::to_string(mesh.N) + " " + gfloatName;
+  const std::string tuningFile = AxTuningFileName(platform);
+
+  int choice = -1;
+  if (mesh.rank==0) choice = ReadAxTuning(tuningFile, key, variants);
+  comm.Bcast(choice, 0);
+
+  if (choice>=0) {
+    kernelInfo["defines/" "p_NblockAx"]= variants[choice].Nblock;
+    partialAxKernel = platform.buildKernel(fileName, variants[choice].kernelName,
+                                           kernelInfo);
+    if (mesh.rank==0)
+      printf("Ax autotune (N=%d): using cached %s, Nblock=%d\n",
+             mesh.N, variants[choice].kernelName.c_str(), variants[choice].Nblock);
+    return;
+  }
+
+  const int Ncold = 5;
+  const int Ntests = 20;
+
+  const dlong Ng = ogsMasked.Ngather + gHalo.Nhalo;
+  deviceMemory<dfloat> o_q = platform.malloc<dfloat>(Ng);
+  platform.linAlg().set(Ng, 1.0, o_q);
+
+  //only the isoparametric elements use partialAxKernel
+  auto partialAx = [&]() {
+    PartialAx(NlocalTrilinear, mesh.NlocalGatherElements, NlocalTrilinear,
+              o_localGatherElementList, o_q, o_AqL);
+    PartialAx(NglobalTrilinear, mesh.NglobalGatherElements, NglobalTrilinear,
+              o_globalGatherElementList, o_q, o_AqL);
+  };
+
+  hlong Niso = mesh.Nelements - (NlocalTrilinear + NglobalTrilinear);
+  comm.Allreduce(Niso);
+
+  const double Np = mesh.Np;
+  const double flopsPerElement = Np*(12.0*Nq + 18.0);
+  const double geoBytesPerElement = (mesh.Nelements>0) ?
+        static_cast<double>(o_AxwJ.size()+o_Axggeo.size())/mesh.Nelements : 0.0;
+  const double bytesPerElement = Np*(sizeof(dlong) + 2*sizeof(dfloat)) + geoBytesPerElement;
+
+  if (mesh.rank==0)
+    printf("Ax autotune (N=%d, %s, %s geometric factors):\n",
+           mesh.N, mode.c_str(), gfloatName.c_str());
+
+  double bestTime = std::numeric_limits<double>::max();
+  kernel_t bestKernel;
+  for (size_t n=0;n<variants.size();++n) {
+    kernelInfo["defines/" "p_NblockAx"]= variants[n].Nblock;
+    partialAxKernel = platform.buildKernel(fileName, variants[n].kernelName,
+                                           kernelInfo);
+
+    for (int c=0;c<Ncold;++c) partialAx();
+
+    timePoint_t start = GlobalPlatformTime(platform);
+    for (int t=0;t<Ntests;++t) partialAx();
+    timePoint_t end = GlobalPlatformTime(platform);
+
+    //every rank must make the same choice
+    double elapsed = ElapsedTime(start, end)/Ntests;
+    comm.Allreduce(elapsed, Comm::Max);
+
+    if (mesh.rank==0) {
+      const double gflops = Niso*flopsPerElement/(1.0e9*elapsed);
+      const double gbytes = Niso*bytesPerElement/(1.0e9*elapsed);
+      printf("   %-32s Nblock=%d  time per Ax=%5.3e s, %7.2f GFLOP/s, %7.2f GB/s\n",
+             variants[n].kernelName.c_str(), variants[n].Nblock,
+             elapsed, gflops, gbytes);
+    }
+
+    if (elapsed < bestTime) {
+      bestTime = elapsed;
+      bestKernel = partialAxKernel;
+      choice = static_cast<int>(n);
+    }
+  }
+  partialAxKernel = bestKernel;
+
+  if (mesh.rank==0) {
+    printf("   Ax kernel selected: %s, Nblock=%d\n",
+           variants[choice].kernelName.c_str(), variants[choice].Nblock);
+
+    std::ofstream file(tuningFile, std::ios::app);
+    LIBP_WARNING("Cannot write Ax autotune cache file: " << tuningFile,
+                 !file.is_open());
+    if (file.is_open()) {
+      file << key << " " << variants[choice].kernelName
+           << " " << variants[choice].Nblock << "\n";
+    }
+  }
+}
@@ -26,82 +26,63 @@
 
 #include "elliptic.hpp"
 
+/*apply local Ax to elements [start,end) of a gather element list whose
+  first Ntrilinear entries are trilinear hexes. The result is written to
+  the local (unassembled) vector o_Aq*/
+void elliptic_t::PartialAx(const dlong start, const dlong end, const dlong Ntrilinear,
+                           deviceMemory<dlong>& o_elementList, deviceMemory<dfloat>& o_q,
+                           deviceMemory<dfloat>& o_Aq){
+
+  const dlong triEnd = std::min(end, Ntrilinear);
+  if (triEnd>start) {
+    partialTrilinearAxKernel(triEnd-start,
+                             o_elementList+start,
+                             o_GlobalToLocal,
+                             o_EXYZ, o_gllzw,
+                             mesh.o_D, mesh.o_S,
+                             mesh.o_MM, lambda, o_q, o_Aq);
+  }
+
+  const dlong isoStart = std::max(start, Ntrilinear);
+  if (end>isoStart) {
+    if (cubatureAx) {
+      partialCubatureAxKernel(end-isoStart,
+                              o_elementList+isoStart,
+                              o_GlobalToLocal,
+                              mesh.o_cubwJ, mesh.o_cubggeo,
+                              mesh.o_cubD, mesh.o_cubInterp,
+                              lambda, o_q, o_Aq);
+    } else {
+      partialAxKernel(end-isoStart,
+                      o_elementList+isoStart,
+                      o_GlobalToLocal,
+                      o_AxwJ, o_Axggeo,
+                      mesh.o_D, mesh.o_S,
+                      mesh.o_MM, lambda, o_q, o_Aq);
+    }
+  }
+}
+
 void elliptic_t::Operator(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_Aq){
 
   if(disc_c0){
-    // int mapType = (mesh.elementType==Mesh::HEXAHEDRA &&
-    //                mesh.settings.compareSetting("ELEMENT MAP", "TRILINEAR")) ? 1:0;
-
-    // int integrationType = (mesh.elementType==Mesh::HEXAHEDRA &&
-    //                        settings.compareSetting("ELLIPTIC INTEGRATION", "CUBATURE")) ? 1:0;
 
     gHalo.ExchangeStart(o_q, 1);
 
-    if(mesh.NlocalGatherElements/2){
-      // if(integrationType==0) { // GLL or non-hex
-        // if(mapType==0)
-          partialAxKernel(mesh.NlocalGatherElements/2,
-                          mesh.o_localGatherElementList,
-                          o_GlobalToLocal,
-                          mesh.o_wJ, mesh.o_ggeo,
-                          mesh.o_D, mesh.o_S,
-                          mesh.o_MM, lambda, o_q, o_AqL);
-        /* NC: disabling until we re-add treatment of affine elements
-        else
-          partialAxKernel(mesh.NlocalGatherElements, mesh.o_localGatherElementList,
-                          mesh.o_EXYZ, mesh.o_gllzw, mesh.o_D, mesh.o_S, mesh.o_MM, lambda, o_q, o_Aq);
-        */
-      // } else {
-      //   partialCubatureAxKernel(mesh.NlocalGatherElements,
-      //                           mesh.o_localGatherElementList,
-      //                           mesh.o_cubggeo,
-      //                           mesh.o_cubD,
-      //                           mesh.o_cubInterpT,
-      //                           lambda,
-      //                           o_q,
-      //                           o_Aq);
-      // }
-    }
+    PartialAx(0, mesh.NlocalGatherElements/2, NlocalTrilinear,
+              o_localGatherElementList, o_q, o_AqL);
 
     // finalize halo exchange
     gHalo.ExchangeFinish(o_q, 1);
 
-    if(mesh.NglobalGatherElements) {
-
-      // if(integrationType==0) { // GLL or non-hex
-        // if(mapType==0)
-          partialAxKernel(mesh.NglobalGatherElements,
-                          mesh.o_globalGatherElementList,
-                          o_GlobalToLocal,
-                          mesh.o_wJ, mesh.o_ggeo,
-                          mesh.o_D, mesh.o_S,
-                          mesh.o_MM, lambda, o_q, o_AqL);
-        /* NC: disabling until we re-add treatment of affine elements
-        else
-          partialAxKernel(mesh.NglobalGatherElements, mesh.o_globalGatherElementList,
-                          mesh.o_EXYZ, mesh.o_gllzw, mesh.o_D, mesh.o_S, mesh.o_MM, lambda, o_q, o_Aq);
-        */
-      // } else {
-      //   partialCubatureAxKernel(mesh.NglobalGatherElements,
-      //                           mesh.o_globalGatherElementList,
-      //                           mesh.o_cubggeo,
-      //                           mesh.o_cubD,
-      //                           mesh.o_cubInterpT,
-      //                           lambda, o_q, o_Aq);
-      // }
-    }
+    PartialAx(0, mesh.NglobalGatherElements, NglobalTrilinear,
+              o_globalGatherElementList, o_q, o_AqL);
 
     //gather result to Aq
     ogsMasked.GatherStart(o_Aq, o_AqL, 1, ogs::Add, ogs::Trans);
 
-    if((mesh.NlocalGatherElements+1)/2){
-      partialAxKernel((mesh.NlocalGatherElements+1)/2,
-                      mesh.o_localGatherElementList+(mesh.NlocalGatherElements/2),
-                      o_GlobalToLocal,
-                      mesh.o_wJ, mesh.o_ggeo,
-                      mesh.o_D, mesh.o_S,
-                      mesh.o_MM, lambda, o_q, o_AqL);
-    }
+    PartialAx(mesh.NlocalGatherElements/2, mesh.NlocalGatherElements, NlocalTrilinear,
+              o_localGatherElementList, o_q, o_AqL);
 
     ogsMasked.GatherFinish(o_Aq, o_AqL, 1, ogs::Add, ogs::Trans);
 
@@ -157,3 +138,43 @@ void elliptic_t::Operator(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_Aq)
   }
 }
 
+
+/*apply the operator to several vectors at once. For C0 discretizations the
+  halo values of all the vectors are moved with one exchange, and the local
+  results are assembled with one gather, so the number of messages does not
+  grow with the number of vectors*/
+void elliptic_t::Operator(std::vector<deviceMemory<dfloat>>& o_qs,
+                          std::vector<deviceMemory<dfloat>>& o_Aqs){
+
+  const int Nf = static_cast<int>(o_qs.size());
+
+  if (!disc_c0) {
+    //the IPDG operator exchanges gradients through a single workspace
+    for (int f=0;f<Nf;++f) {
+      Operator(o_qs[f], o_Aqs[f]);
+    }
+    return;
+  }
+
+  //one local Ax buffer per vector
+  const dlong Ntotal = mesh.Np*mesh.Nelements;
+  if (o_AqLBatch.length() < static_cast<size_t>(Nf*Ntotal))
+    o_AqLBatch = platform.malloc<dfloat>(Nf*Ntotal);
+
+  std::vector<deviceMemory<dfloat>> o_AqLs(Nf);
+  for (int f=0;f<Nf;++f) {
+    o_AqLs[f] = o_AqLBatch + f*Ntotal;
+  }
+
+  gHalo.Exchange(o_qs);
+
+  for (int f=0;f<Nf;++f) {
+    PartialAx(0, mesh.NlocalGatherElements, NlocalTrilinear,
+              o_localGatherElementList, o_qs[f], o_AqLs[f]);
+    PartialAx(0, mesh.NglobalGatherElements, NglobalTrilinear,
+              o_globalGatherElementList, o_qs[f], o_AqLs[f]);
+  }
+
+  //gather all the results to Aq
+  ogsMasked.Gather(o_Aqs, o_AqLs, ogs::Add, ogs::Trans);
+}
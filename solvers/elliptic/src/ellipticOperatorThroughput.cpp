@@ -0,0 +1,112 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.hpp"
+#include "timer.hpp"
+
+/* Time the local C0 Ax kernel over all elements and report its
+   floating point and memory throughput */
+void elliptic_t::ReportOperatorThroughput(){
+
+  if (!disc_c0) return;
+
+  const int Ntests = 20;
+
+  const dlong Ng = ogsMasked.Ngather + gHalo.Nhalo;
+  deviceMemory<dfloat> o_q = platform.malloc<dfloat>(Ng);
+  platform.linAlg().set(Ng, 1.0, o_q);
+
+  auto partialAx = [&]() {
+    PartialAx(0, mesh.NlocalGatherElements, NlocalTrilinear,
+              o_localGatherElementList, o_q, o_AqL);
+    PartialAx(0, mesh.NglobalGatherElements, NglobalTrilinear,
+              o_globalGatherElementList, o_q, o_AqL);
+  };
+
+  //warm up
+  partialAx();
+
+  timePoint_t start = GlobalPlatformTime(platform);
+  for (int n=0;n<Ntests;++n) {
+    partialAx();
+  }
+  timePoint_t end = GlobalPlatformTime(platform);
+  const double elapsed = ElapsedTime(start, end)/Ntests;
+
+  hlong Ntrilinear = NlocalTrilinear + NglobalTrilinear;
+  mesh.comm.Allreduce(Ntrilinear);
+
+  /*Operation counts per element*/
+  double flopsPerElement=0.0, bytesPerElement=0.0;
+  if (mesh.elementType==Mesh::HEXAHEDRA) {
+    const double Nq = mesh.Nq;
+    const double Np = mesh.Np;
+    if (cubatureAx) {
+      const double cubNq = mesh.cubNq;
+      const double cubNp = mesh.cubNp;
+      //interpolation and projection, one direction at a time
+      const double interp = 2.0*(Nq*Nq*cubNq*Nq + Nq*cubNq*cubNq*Nq + cubNp*Nq);
+      //gradient, geometric factors, mass term and weak divergence
+      flopsPerElement = 2.0*interp + cubNp*(12.0*cubNq + 18.0);
+      bytesPerElement = Np*(sizeof(dlong) + 2*sizeof(dfloat))
+                       + cubNp*(mesh.Nggeo+1)*sizeof(dfloat);
+    } else {
+      flopsPerElement = Np*(12.0*Nq + 18.0);
+      bytesPerElement = Np*(sizeof(dlong) + 2*sizeof(dfloat))
+                       + Np*(mesh.Nggeo+1)*sizeof(dfloat);
+
+      //trilinear elements recompute geometric factors from 24 vertex coordinates
+      const double fraction = static_cast<double>(Ntrilinear)/mesh.NelementsGlobal;
+      flopsPerElement += fraction*Np*150.0;
+      bytesPerElement -= fraction*(Np*(mesh.Nggeo+1) - 24)*sizeof(dfloat);
+    }
+  } else {
+    /*Dense element operators*/
+    const double Np = mesh.Np;
+    flopsPerElement = 2.0*Np*Np*mesh.dim*(mesh.dim+1) + 2.0*Np*Np;
+    bytesPerElement = Np*(sizeof(dlong) + 2*sizeof(dfloat))
+                     + mesh.Nggeo*sizeof(dfloat);
+  }
+
+  const double NelementsGlobal = static_cast<double>(mesh.NelementsGlobal);
+  const double gflops = NelementsGlobal*flopsPerElement/(1.0e9*elapsed);
+  const double gbytes = NelementsGlobal*bytesPerElement/(1.0e9*elapsed);
+
+  if (mesh.rank==0) {
+    printf("Ax (%s): N=%d, elements=" hlongFormat " (" hlongFormat " trilinear), time per Ax=%g s, %g GFLOP/s, %g GB/s\n",
+           cubatureAx ? "cubature" : "collocation",
+           mesh.N,
+           mesh.NelementsGlobal,
+           Ntrilinear,
+           elapsed, gflops, gbytes);
+  }
+
+  //gather-scatter of the masked C0 vector
+  ogsMasked.ReportThroughput();
+
+  //batched gather-scatter and halo exchange against one call per vector
+  ogsMasked.CheckBatch();
+}
@@ -0,0 +1,192 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "elliptic.hpp"
+#include "ellipticPrecon.hpp"
+
+// Additive Schwarz with element patches extended one node into each neighbor
+void FDMPrecon::Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr) {
+
+  if (elliptic.disc_c0) {
+    //restrict to element patches, solve each patch, and sum the results
+    elliptic.ogsMasked.Scatter(o_rL, o_r, 1, ogs::NoTrans);
+
+    if (elliptic.Nmasked)
+      maskKernel(elliptic.Nmasked, elliptic.o_maskIds, o_rL);
+
+    if (mesh.Nelements)
+      fdmKernel(mesh.Nelements, o_V, o_invL, o_rL, o_rL);
+
+    elliptic.ogsMasked.Gather(o_Mr, o_rL, 1, ogs::Add, ogs::Trans);
+  } else {
+    if (mesh.Nelements)
+      fdmKernel(mesh.Nelements, o_V, o_invL, o_r, o_Mr);
+  }
+
+  // zero mean of RHS
+  if(elliptic.allNeumann) elliptic.ZeroMean(o_Mr);
+}
+
+// Each element patch problem is approximated by the separable operator on a
+//  box with the element's average edge lengths, and inverted exactly with
+//  fast diagonalization of the 1D GLL stiffness and mass matrices.
+// In each direction the patch extends one node into the neighboring
+//  elements, with homogeneous Dirichlet conditions on the neighbors'
+//  interior nodes (Lottes and Fischer). The shared end nodes then see the
+//  stiffness and mass of both elements, and the patch operator is positive
+//  definite even when lambda=0
+FDMPrecon::FDMPrecon(elliptic_t& _elliptic):
+  elliptic(_elliptic), mesh(_elliptic.mesh) {
+
+  if (!(   mesh.elementType==Mesh::HEXAHEDRA
+        || (mesh.elementType==Mesh::QUADRILATERALS && mesh.dim==2))) {
+    LIBP_FORCE_ABORT("FDM patch solves only supported for Quad2D and Hex3D elements");
+  }
+
+  const int Nq = mesh.Nq;
+
+  //1D stiffness matrix on the reference element, S = D^T W D
+  memory<double> S1D(Nq*Nq, 0.0);
+  for (int i=0;i<Nq;i++) {
+    for (int j=0;j<Nq;j++) {
+      double sij = 0.0;
+      for (int k=0;k<Nq;k++)
+        sij += mesh.gllw[k]*mesh.D[k*Nq+i]*mesh.D[k*Nq+j];
+      S1D[i*Nq+j] = sij;
+    }
+  }
+
+  //extend into the neighbors. Only the shared node of each neighbor is
+  // free, so it adds the neighbor's end diagonal of S and W
+  memory<double> W1D(Nq);
+  for (int i=0;i<Nq;i++) W1D[i] = mesh.gllw[i];
+  const double S00 = S1D[0];
+  const double SNN = S1D[(Nq-1)*Nq+(Nq-1)];
+  S1D[0]                 += SNN;
+  S1D[(Nq-1)*Nq+(Nq-1)]  += S00;
+  W1D[0]    += mesh.gllw[Nq-1];
+  W1D[Nq-1] += mesh.gllw[0];
+
+  //generalized eigenproblem S v = lambda W v, with W the diagonal mass.
+  // Solve the symmetric problem W^{-1/2} S W^{-1/2} u = lambda u instead
+  memory<double> A1D(Nq*Nq);
+  for (int i=0;i<Nq;i++)
+    for (int j=0;j<Nq;j++)
+      A1D[i*Nq+j] = S1D[i*Nq+j]/sqrt(W1D[i]*W1D[j]);
+
+  memory<double> U(Nq*Nq), WI(Nq);
+  WR.malloc(Nq);
+  linAlg_t::matrixEigenVectors(Nq, A1D, U, WR, WI);
+
+  //V = W^{-1/2} U, normalized so V^T W V = I
+  memory<dfloat> V(Nq*Nq);
+  for (int m=0;m<Nq;m++) {
+    double norm = 0.0;
+    for (int n=0;n<Nq;n++) norm += U[n*Nq+m]*U[n*Nq+m];
+    norm = sqrt(norm);
+    for (int n=0;n<Nq;n++)
+      V[n*Nq+m] = static_cast<dfloat>(U[n*Nq+m]/(norm*sqrt(W1D[n])));
+  }
+
+  o_V = elliptic.platform.malloc<dfloat>(V);
+
+  SetupInverseEigenvalues(elliptic.lambda);
+
+  if (elliptic.disc_c0)
+    o_rL = elliptic.platform.malloc<dfloat>(mesh.Nelements*mesh.Np);
+
+  //build kernels
+  properties_t kernelInfo = mesh.props; //copy base occa properties
+
+  std::string suffix = (mesh.elementType==Mesh::HEXAHEDRA) ? "Hex3D" : "Quad2D";
+
+  fdmKernel = elliptic.platform.buildKernel(DELLIPTIC "/okl/ellipticPreconFDM" + suffix + ".okl",
+                                            "ellipticPreconFDM" + suffix, kernelInfo);
+
+  if (elliptic.disc_c0)
+    maskKernel = elliptic.platform.buildKernel(DELLIPTIC "/okl/ellipticMask.okl",
+                                               "mask", kernelInfo);
+}
+
+//per element inverse eigenvalues of the box approximation. With edge
+// lengths h the 1D operators are (2/h)S and (h/2)W, so the eigenvalues
+// scale by 4/h^2 and the eigenvectors by sqrt(2/h)
+void FDMPrecon::SetupInverseEigenvalues(const double lambda) {
+
+  const int Nq = mesh.Nq;
+
+  memory<dfloat> invL(mesh.Nelements*mesh.Np);
+
+  auto edge = [&](const dlong e, const int a, const int b) {
+    const dlong id = e*mesh.Nverts;
+    const double dx = mesh.EX[id+b] - mesh.EX[id+a];
+    const double dy = mesh.EY[id+b] - mesh.EY[id+a];
+    const double dz = (mesh.dim==3) ? mesh.EZ[id+b] - mesh.EZ[id+a] : 0.0;
+    return sqrt(dx*dx+dy*dy+dz*dz);
+  };
+
+  for (dlong e=0;e<mesh.Nelements;e++) {
+    if (mesh.elementType==Mesh::HEXAHEDRA) {
+      const double hr = 0.25*(edge(e,0,1)+edge(e,3,2)+edge(e,4,5)+edge(e,7,6));
+      const double hs = 0.25*(edge(e,0,3)+edge(e,1,2)+edge(e,4,7)+edge(e,5,6));
+      const double ht = 0.25*(edge(e,0,4)+edge(e,1,5)+edge(e,2,6)+edge(e,3,7));
+      const double scale = 8.0/(hr*hs*ht);
+
+      for (int c=0;c<Nq;c++) {
+        for (int b=0;b<Nq;b++) {
+          for (int a=0;a<Nq;a++) {
+            const double L = 4.0*WR[a]/(hr*hr) + 4.0*WR[b]/(hs*hs)
+                           + 4.0*WR[c]/(ht*ht) + lambda;
+            invL[e*mesh.Np + c*Nq*Nq + b*Nq + a] = scale/L;
+          }
+        }
+      }
+    } else {
+      const double hr = 0.5*(edge(e,0,1)+edge(e,3,2));
+      const double hs = 0.5*(edge(e,0,3)+edge(e,1,2));
+      const double scale = 4.0/(hr*hs);
+
+      for (int b=0;b<Nq;b++) {
+        for (int a=0;a<Nq;a++) {
+          const double L = 4.0*WR[a]/(hr*hr) + 4.0*WR[b]/(hs*hs) + lambda;
+          invL[e*mesh.Np + b*Nq + a] = scale/L;
+        }
+      }
+    }
+  }
+
+  if (o_invL.length()==invL.length()) {
+    o_invL.copyFrom(invL);
+  } else {
+    o_invL = elliptic.platform.malloc<dfloat>(invL);
+  }
+}
+
+//only the eigenvalue shift depends on lambda
+bool FDMPrecon::UpdateLambda(const dfloat lambda) {
+  elliptic.lambda = lambda;
+  SetupInverseEigenvalues(lambda);
+  return true;
+}
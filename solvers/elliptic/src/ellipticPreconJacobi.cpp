@@ -39,6 +39,21 @@ JacobiPrecon::JacobiPrecon(elliptic_t& _elliptic):
   o_invDiagA = elliptic.platform.malloc<dfloat>(invDiagA);
 }
 
+//refill the diagonal in place, since solvers may hold o_invDiagA
+bool JacobiPrecon::UpdateLambda(const dfloat lambda) {
+
+  elliptic.lambda = lambda;
+
+  memory<dfloat> diagA   (elliptic.Ndofs);
+  memory<dfloat> invDiagA(elliptic.Ndofs);
+  elliptic.BuildOperatorDiagonal(diagA);
+  for (dlong n=0;n<elliptic.Ndofs;n++)
+    invDiagA[n] = 1.0/diagA[n];
+
+  o_invDiagA.copyFrom(invDiagA);
+  return true;
+}
+
 void JacobiPrecon::Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr) {
 
   linAlg_t& linAlg = elliptic.platform.linAlg();
@@ -49,3 +64,11 @@ void JacobiPrecon::Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_M
   // zero mean of RHS
   if(elliptic.allNeumann) elliptic.ZeroMean(o_Mr);
 }
+
+bool JacobiPrecon::Diagonal(deviceMemory<dfloat>& o_D) {
+  //the zero mean projection is not pointwise
+  if(elliptic.allNeumann) return false;
+
+  o_D = o_invDiagA;
+  return true;
+}
@@ -26,6 +26,7 @@ SOFTWARE.
 
 #include "elliptic.hpp"
 #include "ellipticPrecon.hpp"
+#include "timer.hpp"
 
 void MGLevel::Operator(deviceMemory<dfloat>& o_X, deviceMemory<dfloat>& o_Ax) {
   elliptic.Operator(o_X,o_Ax);
@@ -127,11 +128,20 @@ void MGLevel::prolongate(deviceMemory<dfloat>& o_X, deviceMemory<dfloat>& o_Px)
 void MGLevel::smooth(deviceMemory<dfloat>& o_RHS, deviceMemory<dfloat>& o_X, bool x_is_zero) {
   if (stype==JACOBI) {
     smoothJacobi(o_RHS, o_X, x_is_zero);
-  } else if (stype==CHEBYSHEV) {
+  } else if (stype==CHEBYSHEV || stype==LOCALPATCH) {
     smoothChebyshev(o_RHS, o_X, x_is_zero);
   }
 }
 
+void MGLevel::smootherApply(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Sr) {
+
+  if (stype==LOCALPATCH) {
+    patchPrecon.Operator(o_r, o_Sr);
+  } else {
+    platform.linAlg().amxpy(elliptic.Ndofs, 1.0, o_invDiagA, o_r, 0.0, o_Sr);
+  }
+}
+
 void MGLevel::smoothJacobi(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_X, bool xIsZero) {
 
   linAlg_t& linAlg = platform.linAlg();
@@ -168,7 +178,7 @@ void MGLevel::smoothChebyshev (deviceMemory<dfloat>& o_r, deviceMemory<dfloat>&
 
   if(xIsZero){ //skip the Ax if x is zero
     //res = S*r
-    linAlg.amxpy(elliptic.Ndofs, 1.0, o_invDiagA, o_r, 0.f, o_RES);
+    smootherApply(o_r, o_RES);
 
     //d = invTheta*res
     linAlg.axpy(elliptic.Ndofs, invTheta, o_RES, 0.f, o_d);
@@ -176,7 +186,7 @@ void MGLevel::smoothChebyshev (deviceMemory<dfloat>& o_r, deviceMemory<dfloat>&
     //res = S*(r-Ax)
     Operator(o_X,o_RES);
     linAlg.axpy(elliptic.Ndofs, 1.f, o_r, -1.f, o_RES);
-    linAlg.amx(elliptic.Ndofs, 1.f, o_invDiagA, o_RES);
+    smootherApply(o_RES, o_RES);
 
     //d = invTheta*res
     linAlg.axpy(elliptic.Ndofs, invTheta, o_RES, 0.f, o_d);
@@ -191,7 +201,12 @@ void MGLevel::smoothChebyshev (deviceMemory<dfloat>& o_r, deviceMemory<dfloat>&
 
     //r_k+1 = r_k - SAd_k
     Operator(o_d,o_Ad);
-    linAlg.amxpy(elliptic.Ndofs, -1.f, o_invDiagA, o_Ad, 1.f, o_RES);
+    if (stype==LOCALPATCH) {
+      smootherApply(o_Ad, o_Ad);
+      linAlg.axpy(elliptic.Ndofs, -1.f, o_Ad, 1.f, o_RES);
+    } else {
+      linAlg.amxpy(elliptic.Ndofs, -1.f, o_invDiagA, o_Ad, 1.f, o_RES);
+    }
 
     rho_np1 = 1.0/(2.*sigma-rho_n);
     dfloat rhoDivDelta = 2.0*rho_np1/delta;
@@ -231,7 +246,11 @@ MGLevel::MGLevel(elliptic_t& _elliptic,
   elliptic(_elliptic),
   mesh(_elliptic.mesh) {
 
+  timePoint_t start = GlobalPlatformTime(platform, mesh.comm);
   SetupSmoother();
+  timePoint_t end = GlobalPlatformTime(platform, mesh.comm);
+  smootherSetupTime = ElapsedTime(start, end);
+
   AllocateStorage();
 
   if (   mesh.elementType==Mesh::QUADRILATERALS
@@ -242,11 +261,22 @@ MGLevel::MGLevel(elliptic_t& _elliptic,
   } else { //Mesh::TETRAHEDRA
     mesh.DegreeRaiseMatrixTet3D(Nc, mesh.N, P);
   }
-  o_P = elliptic.platform.malloc<dfloat>(P);
 
   //build kernels
   properties_t kernelInfo = elliptic.platform.props();
 
+  //transfer operators can be stored in single precision. Level vectors stay
+  // in double, so the conversion happens in registers inside the kernels
+  if (settings.compareSetting("MULTIGRID PRECISION","FLOAT")) {
+    memory<float> Pf(P.length());
+    for (size_t n=0;n<P.length();n++) Pf[n] = static_cast<float>(P[n]);
+    o_P = elliptic.platform.malloc<float>(Pf);
+    kernelInfo["defines/" "gfloat"]= "float";
+  } else {
+    o_P = elliptic.platform.malloc<dfloat>(P);
+    kernelInfo["defines/" "gfloat"]= dfloatString;
+  }
+
   // set kernel name suffix
   std::string suffix;
   if(mesh.elementType==Mesh::TRIANGLES)
@@ -332,18 +362,59 @@ void MGLevel::Report() {
     strcpy(smootherString, "Damped Jacobi   ");
   else if (stype==CHEBYSHEV)
     strcpy(smootherString, "Chebyshev       ");
+  else if (stype==LOCALPATCH)
+    strcpy(smootherString, "Patch+Chebyshev ");
+
+  //operator applications per smoothing step
+  const int NsmootherIterations = (stype==JACOBI) ? 1 : ChebyshevIterations+1;
+
+  //time a smoothing step with a nonzero initial guess, as in a V-cycle
+  const int Ntests = 10;
+  memory<dfloat> ones(Ncols, 1.0);
+  memory<dfloat> zeros(Ncols, 0.0);
+  deviceMemory<dfloat> o_r = platform.malloc<dfloat>(ones);
+  deviceMemory<dfloat> o_x = platform.malloc<dfloat>(zeros);
+
+  smooth(o_r, o_x, false); //warm up
+
+  timePoint_t start = GlobalPlatformTime(platform, mesh.comm);
+  for (int n=0;n<Ntests;++n) {
+    smooth(o_r, o_x, false);
+  }
+  timePoint_t end = GlobalPlatformTime(platform, mesh.comm);
+  const double smoothTime = ElapsedTime(start, end)/Ntests;
+
+  double setupTime = smootherSetupTime;
+  mesh.comm.Allreduce(setupTime, Comm::Max);
 
   //This setup can be called by many subcommunicators, so only
   // print on the global root.
   if (mesh.rank==0){
     printf(      "|    pMG     |    %10lld  |    %10d  |   Matrix-free   |   %s|\n", (long long int)totalNrows, minNrows, smootherString);
-    printf("      |            |                |    %10d  |     Degree %2d   |                   |\n", maxNrows, mesh.N);
-    printf("      |            |                |    %10d  |                 |                   |\n", (int) avgNrows);
+    printf("      |            |                |    %10d  |     Degree %2d   |   %2d Ax per smooth|\n", maxNrows, mesh.N, NsmootherIterations);
+    printf("      |            |                |    %10d  |                 |   Setup %8.2e s|\n", (int) avgNrows, setupTime);
+    printf("      |            |                |                |                 |  Smooth %8.2e s|\n", smoothTime);
   }
 }
 
 void MGLevel::SetupSmoother() {
 
+  if (elliptic.settings.compareSetting("MULTIGRID SMOOTHER","LOCALPATCH")) {
+    stype = LOCALPATCH;
+
+    patchPrecon = FDMPrecon(elliptic);
+
+    ChebyshevIterations = 2; //default to degree 2
+    elliptic.settings.getSetting("MULTIGRID CHEBYSHEV DEGREE", ChebyshevIterations);
+
+    //estimate the max eigenvalue of S*A
+    dfloat rho = maxEigSmoothAx();
+
+    lambda1 = rho;
+    lambda0 = rho/10.;
+    return;
+  }
+
   //set up the fine problem smoothing
   memory<dfloat> diagA   (Nrows);
   memory<dfloat> invDiagA(Nrows);
@@ -428,9 +499,9 @@ dfloat MGLevel::maxEigSmoothAx(){
   linAlg.axpy(N, 1./norm_vo, o_Vx, 0.f, o_V[0]);
 
   for(int j=0; j<k; j++){
-    // v[j+1] = invD*(A*v[j])
+    // v[j+1] = S*(A*v[j])
     Operator(o_V[j],o_AVx);
-    linAlg.amxpy(N, 1.0, o_invDiagA, o_AVx, 0.0, o_V[j+1]);
+    smootherApply(o_AVx, o_V[j+1]);
 
     // modified Gram-Schmidth
     for(int i=0; i<=j; i++){
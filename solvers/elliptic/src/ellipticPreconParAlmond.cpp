@@ -72,3 +72,21 @@ ParAlmondPrecon::ParAlmondPrecon(elliptic_t& _elliptic):
   dlong parAlmondNhalo = parAlmondNcols - parAlmondNrows;
   _elliptic.Nhalo = std::max(_elliptic.Nhalo, parAlmondNhalo);
 }
+
+//lambda only changes matrix values, so the aggregates and prolongators of
+// the existing hierarchy are reused
+bool ParAlmondPrecon::UpdateLambda(const dfloat lambda) {
+
+  elliptic.lambda = lambda;
+
+  parAlmond::parCOO A(elliptic.platform, elliptic.mesh.comm);
+  if (settings.compareSetting("DISCRETIZATION", "IPDG")) {
+    elliptic.BuildOperatorMatrixIpdg(A);
+  } else if (settings.compareSetting("DISCRETIZATION", "CONTINUOUS")) {
+    elliptic.BuildOperatorMatrixContinuous(A);
+  }
+
+  parAlmond.AMGUpdate(A);
+
+  return true;
+}
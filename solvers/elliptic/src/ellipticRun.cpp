@@ -42,6 +42,10 @@ void elliptic_t::Run(){
     linearSolver.Setup<LinearSolver::nbpcg>(Ndofs, Nhalo, platform, settings, comm);
   } else if (settings.compareSetting("LINEAR SOLVER","NBFPCG")){
     linearSolver.Setup<LinearSolver::nbfpcg>(Ndofs, Nhalo, platform, settings, comm);
+  } else if (settings.compareSetting("LINEAR SOLVER","PIPECG")){
+    linearSolver.Setup<LinearSolver::pipecg>(Ndofs, Nhalo, platform, settings, comm);
+  } else if (settings.compareSetting("LINEAR SOLVER","SSTEPCG")){
+    linearSolver.Setup<LinearSolver::sstepcg>(Ndofs, Nhalo, platform, settings, comm);
   } else if (settings.compareSetting("LINEAR SOLVER","PCG")){
     linearSolver.Setup<LinearSolver::pcg>(Ndofs, Nhalo, platform, settings, comm);
   } else if (settings.compareSetting("LINEAR SOLVER","PGMRES")){
@@ -176,6 +180,44 @@ void elliptic_t::Run(){
                 mesh.o_z,
                 o_mapB,
                 o_rL);
+
+    if (cubatureAx) {
+      //rhsBCKernel lifts the Dirichlet data with the collocation operator,
+      // but A is over-integrated. Swap the lift for the cubature one by
+      // applying both operators elementwise to the lifted boundary vector
+      const dlong Nlocal = mesh.Np*mesh.Nelements;
+      memory<dfloat> bL(Nlocal, 0.0);
+      memory<dlong> localIds(Nlocal);
+      memory<dlong> elementIds(mesh.Nelements);
+      for (dlong n=0;n<Nlocal;++n) localIds[n] = n;
+      for (dlong e=0;e<mesh.Nelements;++e) elementIds[e] = e;
+
+      deviceMemory<dfloat> o_bL = platform.malloc<dfloat>(bL);
+      deviceMemory<dfloat> o_AbL = platform.malloc<dfloat>(bL);
+      deviceMemory<dlong> o_localIds = platform.malloc<dlong>(localIds);
+      deviceMemory<dlong> o_elementIds = platform.malloc<dlong>(elementIds);
+
+      addBCKernel(mesh.Nelements,
+                  mesh.o_x,
+                  mesh.o_y,
+                  mesh.o_z,
+                  o_mapB,
+                  o_bL);
+
+      if (mesh.Nelements) {
+        partialAxKernel(mesh.Nelements, o_elementIds, o_localIds,
+                        o_AxwJ, o_Axggeo,
+                        mesh.o_D, mesh.o_S,
+                        mesh.o_MM, lambda, o_bL, o_AbL);
+        platform.linAlg().axpy(Nlocal, 1.0, o_AbL, 1.0, o_rL);
+
+        partialCubatureAxKernel(mesh.Nelements, o_elementIds, o_localIds,
+                                mesh.o_cubwJ, mesh.o_cubggeo,
+                                mesh.o_cubD, mesh.o_cubInterp,
+                                lambda, o_bL, o_AbL);
+        platform.linAlg().axpy(Nlocal, -1.0, o_AbL, 1.0, o_rL);
+      }
+    }
   }
 
   // gather rhs to globalDofs if c0
@@ -187,6 +229,8 @@ void elliptic_t::Run(){
   int maxIter = 5000;
   int verbose = settings.compareSetting("VERBOSE", "TRUE") ? 1 : 0;
 
+  if (verbose) ReportOperatorThroughput();
+
   timePoint_t start = GlobalPlatformTime(platform);
 
   //call the solver
@@ -228,10 +272,7 @@ void elliptic_t::Run(){
     // output field files
     std::string name;
     settings.getSetting("OUTPUT FILE NAME", name);
-    char fname[BUFSIZ];
-    sprintf(fname, "%s_%04d.vtu", name.c_str(), mesh.rank);
-
-    PlotFields(xL, fname);
+    PlotFields(xL, name);
   }
 
   // output norm of final solution
@@ -61,10 +61,24 @@ void ellipticAddSettings(settings_t& settings,
                       "Type of Finite Element Discretization",
                       {"CONTINUOUS", "IPDG"});
 
+  settings.newSetting(prefix+"ELLIPTIC INTEGRATION",
+                      "GLL",
+                      "Quadrature for the C0 operator on hexahedra",
+                      {"GLL", "CUBATURE"});
+
+  settings.newSetting(prefix+"ELLIPTIC AX AUTOTUNE",
+                      "FALSE",
+                      "Time the Hex3D C0 Ax kernel variants at setup and use the fastest",
+                      {"TRUE", "FALSE"});
+
   settings.newSetting(prefix+"LINEAR SOLVER",
                       "PCG",
                       "Iterative Linear Solver to use for solve",
-                      {"PCG", "FPCG", "NBPCG", "NBFPCG", "PGMRES", "PMINRES"});
+                      {"PCG", "FPCG", "NBPCG", "NBFPCG", "PIPECG", "SSTEPCG", "PGMRES", "PMINRES"});
+
+  settings.newSetting(prefix+"LINEAR SOLVER S-STEP",
+                      "4",
+                      "Number of CG steps taken per block by SSTEPCG (at most 8)");
 
   settings.newSetting(prefix+"LINEAR SOLVER STOPPING CRITERION",
                       "ABS/REL-INITRESID",
@@ -74,7 +88,7 @@ void ellipticAddSettings(settings_t& settings,
   settings.newSetting(prefix+"PRECONDITIONER",
                       "NONE",
                       "Preconditioning Strategy",
-                      {"NONE", "JACOBI", "MASSMATRIX", "PARALMOND", "MULTIGRID", "SEMFEM", "OAS"});
+                      {"NONE", "JACOBI", "MASSMATRIX", "PARALMOND", "MULTIGRID", "SEMFEM", "OAS", "FDM"});
 
   /* MULTIGRID options */
   settings.newSetting(prefix+"MULTIGRID COARSENING",
@@ -85,12 +99,17 @@ void ellipticAddSettings(settings_t& settings,
   settings.newSetting(prefix+"MULTIGRID SMOOTHER",
                       "CHEBYSHEV",
                       "p-Multigrid smoother",
-                      {"DAMPEDJACOBI", "CHEBYSHEV"});
+                      {"DAMPEDJACOBI", "CHEBYSHEV", "LOCALPATCH"});
 
   settings.newSetting(prefix+"MULTIGRID CHEBYSHEV DEGREE",
                       "2",
                       "Smoothing iterations in Chebyshev smoother");
 
+  settings.newSetting(prefix+"MULTIGRID PRECISION",
+                      "DOUBLE",
+                      "Storage precision of geometric factors and transfer operators on coarse p-Multigrid levels",
+                      {"DOUBLE", "FLOAT"});
+
   settings.newSetting(prefix+"VERBOSE",
                       "FALSE",
                       "Enable verbose output",
@@ -105,14 +124,22 @@ void ellipticSettings_t::report() {
 
     reportSetting("LAMBDA");
     reportSetting("DISCRETIZATION");
+    if (compareSetting("DISCRETIZATION","CONTINUOUS")) {
+      reportSetting("ELLIPTIC INTEGRATION");
+      reportSetting("ELLIPTIC AX AUTOTUNE");
+    }
     reportSetting("LINEAR SOLVER");
+    if (compareSetting("LINEAR SOLVER","SSTEPCG"))
+      reportSetting("LINEAR SOLVER S-STEP");
     reportSetting("PRECONDITIONER");
 
     if (compareSetting("PRECONDITIONER","MULTIGRID")) {
       reportSetting("MULTIGRID COARSENING");
       reportSetting("MULTIGRID SMOOTHER");
-      if (compareSetting("MULTIGRID SMOOTHER","CHEBYSHEV"))
+      if (compareSetting("MULTIGRID SMOOTHER","CHEBYSHEV")
+        ||compareSetting("MULTIGRID SMOOTHER","LOCALPATCH"))
         reportSetting("MULTIGRID CHEBYSHEV DEGREE");
+      reportSetting("MULTIGRID PRECISION");
     }
 
     if (compareSetting("PRECONDITIONER","MULTIGRID")
@@ -85,6 +85,14 @@ void elliptic_t::Setup(platform_t& _platform, mesh_t& _mesh,
     o_AqL = platform.malloc<dfloat>(Ntotal);
   }
 
+  // over-integrated Ax needs cubature geometric factors
+  cubatureAx = settings.compareSetting("ELLIPTIC INTEGRATION", "CUBATURE");
+  if (cubatureAx) {
+    LIBP_ABORT("Cubature integration is only supported for CONTINUOUS discretizations on hexahedra",
+               !disc_c0 || mesh.elementType!=Mesh::HEXAHEDRA);
+    mesh.CubatureSetup();
+  }
+
   // OCCA build stuff
   properties_t kernelInfo = mesh.props; //copy base occa properties
 
@@ -126,19 +134,34 @@ void elliptic_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   // Ax kernel
   if (settings.compareSetting("DISCRETIZATION","CONTINUOUS")) {
+    //the fine level always streams double precision geometric factors
+    kernelInfo["defines/" "gfloat"]= dfloatString;
+    kernelInfo["defines/" "p_NblockAx"]= 1;
+    o_AxwJ = mesh.o_wJ;
+    o_Axggeo = mesh.o_ggeo;
+
     fileName   = oklFilePrefix + "ellipticAx" + suffix + oklFileSuffix;
-    if(mesh.elementType==Mesh::HEXAHEDRA){
-      if(mesh.settings.compareSetting("ELEMENT MAP", "TRILINEAR"))
-        kernelName = "ellipticPartialAxTrilinear" + suffix;
-      else
-        kernelName = "ellipticPartialAx" + suffix;
-    } else{
-      kernelName = "ellipticPartialAx" + suffix;
-    }
+    kernelName = "ellipticPartialAx" + suffix;
 
     partialAxKernel = platform.buildKernel(fileName, kernelName,
                                            kernelInfo);
 
+    TrilinearSetup();
+    if (trilinearAx) {
+      kernelName = "ellipticPartialAxTrilinear" + suffix;
+      partialTrilinearAxKernel = platform.buildKernel(fileName, kernelName,
+                                                      kernelInfo);
+    }
+
+    AxAutotune(kernelInfo, dfloatString);
+
+    if (cubatureAx) {
+      fileName   = oklFilePrefix + "ellipticCubatureAx" + suffix + oklFileSuffix;
+      kernelName = "ellipticCubaturePartialAx" + suffix;
+      partialCubatureAxKernel = platform.buildKernel(fileName, kernelName,
+                                                     kernelInfo);
+    }
+
   } else if (settings.compareSetting("DISCRETIZATION","IPDG")) {
     int Nmax = std::max(mesh.Np, mesh.Nfaces*mesh.Nfp);
     kernelInfo["defines/" "p_Nmax"]= Nmax;
@@ -175,6 +198,8 @@ void elliptic_t::Setup(platform_t& _platform, mesh_t& _mesh,
     precon.Setup<SEMFEMPrecon>(*this);
   else if(settings.compareSetting("PRECONDITIONER", "OAS"))
     precon.Setup<OASPrecon>(*this);
+  else if(settings.compareSetting("PRECONDITIONER", "FDM"))
+    precon.Setup<FDMPrecon>(*this);
   else if(settings.compareSetting("PRECONDITIONER", "NONE"))
     precon.Setup<IdentityPrecon>(Ndofs);
 }
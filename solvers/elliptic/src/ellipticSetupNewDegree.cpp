@@ -37,6 +37,9 @@ elliptic_t elliptic_t::SetupNewDegree(mesh_t& meshC){
 
   elliptic.mesh = meshC;
 
+  //coarse levels use GLL collocation
+  elliptic.cubatureAx = false;
+
   /*setup trace halo exchange */
   elliptic.traceHalo = meshC.HaloTraceSetup(Nfields);
 
@@ -100,19 +103,42 @@ elliptic_t elliptic_t::SetupNewDegree(mesh_t& meshC){
 
   // Ax kernel
   if (settings.compareSetting("DISCRETIZATION","CONTINUOUS")) {
-    fileName   = oklFilePrefix + "ellipticAx" + suffix + oklFileSuffix;
-    if(meshC.elementType==Mesh::HEXAHEDRA){
-      if(mesh.settings.compareSetting("ELEMENT MAP", "TRILINEAR"))
-        kernelName = "ellipticPartialAxTrilinear" + suffix;
-      else
-        kernelName = "ellipticPartialAx" + suffix;
-    } else{
-      kernelName = "ellipticPartialAx" + suffix;
+    kernelInfo["defines/" "p_NblockAx"]= 1;
+
+    const bool floatGeo = settings.compareSetting("PRECONDITIONER","MULTIGRID")
+                       && settings.compareSetting("MULTIGRID PRECISION","FLOAT");
+    if (floatGeo) {
+      //coarse multigrid levels stream single precision geometric factors
+      kernelInfo["defines/" "gfloat"]= "float";
+
+      memory<float> wJf(meshC.wJ.length());
+      for (size_t n=0;n<meshC.wJ.length();n++) wJf[n] = static_cast<float>(meshC.wJ[n]);
+      memory<float> ggeof(meshC.ggeo.length());
+      for (size_t n=0;n<meshC.ggeo.length();n++) ggeof[n] = static_cast<float>(meshC.ggeo[n]);
+
+      elliptic.o_AxwJ = platform.malloc<float>(wJf);
+      elliptic.o_Axggeo = platform.malloc<float>(ggeof);
+    } else {
+      kernelInfo["defines/" "gfloat"]= dfloatString;
+      elliptic.o_AxwJ = meshC.o_wJ;
+      elliptic.o_Axggeo = meshC.o_ggeo;
     }
 
+    fileName   = oklFilePrefix + "ellipticAx" + suffix + oklFileSuffix;
+    kernelName = "ellipticPartialAx" + suffix;
+
     elliptic.partialAxKernel = platform.buildKernel(fileName, kernelName,
                                             kernelInfo);
 
+    elliptic.TrilinearSetup();
+    if (elliptic.trilinearAx) {
+      kernelName = "ellipticPartialAxTrilinear" + suffix;
+      elliptic.partialTrilinearAxKernel = platform.buildKernel(fileName, kernelName,
+                                                               kernelInfo);
+    }
+
+    elliptic.AxAutotune(kernelInfo, floatGeo ? "float" : dfloatString);
+
   } else if (settings.compareSetting("DISCRETIZATION","IPDG")) {
     int Nmax = std::max(meshC.Np, meshC.Nfaces*meshC.Nfp);
     kernelInfo["defines/" "p_Nmax"]= Nmax;
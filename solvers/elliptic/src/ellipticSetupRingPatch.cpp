@@ -57,6 +57,10 @@ elliptic_t elliptic_t::SetupRingPatch(mesh_t& meshPatch){
 
   if (settings.compareSetting("DISCRETIZATION", "CONTINUOUS")) {
     elliptic.Ndofs = elliptic.ogsMasked.Ngather*Nfields;
+
+    //element lists and geometry for the patch's Ax
+    if (elliptic.cubatureAx) elliptic.mesh.CubatureSetup();
+    elliptic.TrilinearSetup();
   } else {
     elliptic.Ndofs = meshPatch.Nelements*meshPatch.Np*Nfields;
   }
@@ -0,0 +1,142 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.hpp"
+
+/* Find the hex elements whose nodes are the trilinear image of their vertices.
+   These elements compute their geometric factors on the fly in the Ax kernel
+   from EXYZ, so only 24 vertex coordinates are streamed instead of the
+   7 geometric factors per node. Trilinear elements are placed first in the
+   solver's copies of the local/global gather element lists. */
+void elliptic_t::TrilinearSetup(){
+
+  trilinearAx = disc_c0
+                && !cubatureAx
+                && mesh.elementType==Mesh::HEXAHEDRA
+                && !mesh.settings.compareSetting("ELEMENT MAP", "ISOPARAMETRIC");
+
+  if (!trilinearAx) {
+    NlocalTrilinear = 0;
+    NglobalTrilinear = 0;
+    o_localGatherElementList = mesh.o_localGatherElementList;
+    o_globalGatherElementList = mesh.o_globalGatherElementList;
+    return;
+  }
+
+  const int Nq = mesh.Nq;
+  const int Np = mesh.Np;
+  const int Nverts = mesh.Nverts;
+
+  /*check each element's nodes against the trilinear map of its vertices*/
+  memory<int> isTrilinear(mesh.Nelements);
+
+  #pragma omp parallel for
+  for(dlong e=0;e<mesh.Nelements;++e){
+    const dfloat *xe = mesh.EX.ptr() + e*Nverts;
+    const dfloat *ye = mesh.EY.ptr() + e*Nverts;
+    const dfloat *ze = mesh.EZ.ptr() + e*Nverts;
+
+    //element size for the tolerance
+    dfloat h = 0.0;
+    for(int v=1;v<Nverts;++v){
+      h = std::max(h, std::abs(xe[v]-xe[0]));
+      h = std::max(h, std::abs(ye[v]-ye[0]));
+      h = std::max(h, std::abs(ze[v]-ze[0]));
+    }
+    const dfloat tol = 1000*std::numeric_limits<dfloat>::epsilon()*h;
+
+    dfloat err = 0.0;
+    for(int k=0;k<Nq;++k){
+      for(int j=0;j<Nq;++j){
+        for(int i=0;i<Nq;++i){
+          const dfloat rn = mesh.gllz[i];
+          const dfloat sn = mesh.gllz[j];
+          const dfloat tn = mesh.gllz[k];
+
+          const dfloat c[8] = {(1-rn)*(1-sn)*(1-tn), (1+rn)*(1-sn)*(1-tn),
+                               (1+rn)*(1+sn)*(1-tn), (1-rn)*(1+sn)*(1-tn),
+                               (1-rn)*(1-sn)*(1+tn), (1+rn)*(1-sn)*(1+tn),
+                               (1+rn)*(1+sn)*(1+tn), (1-rn)*(1+sn)*(1+tn)};
+
+          dfloat xn = 0.0, yn = 0.0, zn = 0.0;
+          for(int v=0;v<Nverts;++v){
+            xn += 0.125*c[v]*xe[v];
+            yn += 0.125*c[v]*ye[v];
+            zn += 0.125*c[v]*ze[v];
+          }
+
+          const dlong id = e*Np + i + j*Nq + k*Nq*Nq;
+          err = std::max(err, std::abs(xn-mesh.x[id]));
+          err = std::max(err, std::abs(yn-mesh.y[id]));
+          err = std::max(err, std::abs(zn-mesh.z[id]));
+        }
+      }
+    }
+    isTrilinear[e] = (err<=tol) ? 1 : 0;
+  }
+
+  /*reorder the gather element lists with the trilinear elements first*/
+  auto sortList = [&](const dlong N, const memory<dlong> list,
+                      deviceMemory<dlong>& o_list) {
+    memory<dlong> sorted(N);
+    dlong cnt = 0;
+    for(dlong n=0;n<N;++n) if ( isTrilinear[list[n]]) sorted[cnt++] = list[n];
+    const dlong Ntri = cnt;
+    for(dlong n=0;n<N;++n) if (!isTrilinear[list[n]]) sorted[cnt++] = list[n];
+    o_list = platform.malloc<dlong>(sorted);
+    return Ntri;
+  };
+
+  NlocalTrilinear  = sortList(mesh.NlocalGatherElements,
+                              mesh.localGatherElementList,
+                              o_localGatherElementList);
+  NglobalTrilinear = sortList(mesh.NglobalGatherElements,
+                              mesh.globalGatherElementList,
+                              o_globalGatherElementList);
+
+  /*vertex coordinates, packed per element as [x(0:7) y(0:7) z(0:7)]*/
+  memory<dfloat> EXYZ(mesh.Nelements*Nverts*mesh.dim);
+  for(dlong e=0;e<mesh.Nelements;++e){
+    for(int v=0;v<Nverts;++v){
+      EXYZ[e*Nverts*mesh.dim + 0*Nverts + v] = mesh.EX[e*Nverts+v];
+      EXYZ[e*Nverts*mesh.dim + 1*Nverts + v] = mesh.EY[e*Nverts+v];
+      EXYZ[e*Nverts*mesh.dim + 2*Nverts + v] = mesh.EZ[e*Nverts+v];
+    }
+  }
+  o_EXYZ = platform.malloc<dfloat>(EXYZ);
+
+  memory<dfloat> gllzw(2*Nq);
+  gllzw.copyFrom(mesh.gllz, Nq, 0);
+  gllzw.copyFrom(mesh.gllw, Nq, Nq);
+  o_gllzw = platform.malloc<dfloat>(gllzw);
+
+  hlong Ntrilinear = NlocalTrilinear + NglobalTrilinear;
+  mesh.comm.Allreduce(Ntrilinear);
+  if (mesh.rank==0 && settings.compareSetting("VERBOSE", "TRUE")) {
+    printf("Trilinear Ax: " hlongFormat " of " hlongFormat " elements (N=%d)\n",
+           Ntrilinear, mesh.NelementsGlobal, mesh.N);
+  }
+}
@@ -30,6 +30,7 @@
 #include "core.hpp"
 #include "platform.hpp"
 #include "mesh.hpp"
+#include "mesh/meshVTU.hpp"
 #include "solver.hpp"
 #include "timeStepper.hpp"
 #include "linAlg.hpp"
@@ -71,6 +72,7 @@ public:
 class fpe_t: public solver_t {
 public:
   mesh_t mesh;
+  vtuWriter_t vtu;
   timeStepper_t timeStepper;
 
   ogs::halo_t traceHalo;
@@ -122,7 +124,7 @@ public:
 
   void Report(dfloat time, int tstep);
 
-  void PlotFields(memory<dfloat>& Q, std::string fileName);
+  void PlotFields(memory<dfloat>& Q, const std::string fileName, const int frame=-1);
 
   dfloat MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T);
 
@@ -81,6 +81,8 @@ fpeSettings_t::fpeSettings_t(comm_t& _comm):
   newSetting("OUTPUT FILE NAME",
              "fpe");
 
+  TimeStepper::AddSettings(*this);
+
   ellipticAddSettings(*this, "ELLIPTIC ");
   parAlmond::AddSettings(*this, "ELLIPTIC ");
 }
@@ -104,11 +106,14 @@ void fpeSettings_t::report() {
     reportSetting("OUTPUT INTERVAL");
     reportSetting("OUTPUT TO FILE");
     reportSetting("OUTPUT FILE NAME");
+    TimeStepper::ReportSettings(*this);
 
     std::cout << "\nElliptic Solver Settings:\n\n";
 
     reportSetting("ELLIPTIC DISCRETIZATION");
     reportSetting("ELLIPTIC LINEAR SOLVER");
+    if (compareSetting("ELLIPTIC LINEAR SOLVER","SSTEPCG"))
+      reportSetting("ELLIPTIC LINEAR SOLVER S-STEP");
     reportSetting("ELLIPTIC PRECONDITIONER");
 
     if (compareSetting("ELLIPTIC PRECONDITIONER","MULTIGRID")) {
@@ -75,6 +75,7 @@ void fpe_t::Setup(platform_t& _platform, mesh_t& _mesh,
                                            mesh.Np, 1, platform, comm);
     gamma = timeStepper.GetGamma();
   }
+  timeStepper.EnableCheckpointing();
 
   Nsubcycles=1;
   if (settings.compareSetting("TIME INTEGRATOR","SSBDF3"))
@@ -113,6 +114,12 @@ void fpe_t::Setup(platform_t& _platform, mesh_t& _mesh,
     } else if (ellipticSettings.compareSetting("LINEAR SOLVER","NBFPCG")){
       linearSolver.Setup<LinearSolver::nbfpcg>(elliptic.Ndofs, elliptic.Nhalo,
                                               platform, ellipticSettings, comm);
+    } else if (ellipticSettings.compareSetting("LINEAR SOLVER","PIPECG")){
+      linearSolver.Setup<LinearSolver::pipecg>(elliptic.Ndofs, elliptic.Nhalo,
+                                              platform, ellipticSettings, comm);
+    } else if (ellipticSettings.compareSetting("LINEAR SOLVER","SSTEPCG")){
+      linearSolver.Setup<LinearSolver::sstepcg>(elliptic.Ndofs, elliptic.Nhalo,
+                                              platform, ellipticSettings, comm);
     } else if (ellipticSettings.compareSetting("LINEAR SOLVER","PCG")){
       linearSolver.Setup<LinearSolver::pcg>(elliptic.Ndofs, elliptic.Nhalo,
                                               platform, ellipticSettings, comm);
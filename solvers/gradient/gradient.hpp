@@ -30,6 +30,7 @@ SOFTWARE.
 #include "core.hpp"
 #include "platform.hpp"
 #include "mesh.hpp"
+#include "mesh/meshVTU.hpp"
 #include "solver.hpp"
 
 #define DGRADIENT LIBP_DIR"/solvers/gradient/"
@@ -48,6 +49,7 @@ public:
 class gradient_t: public solver_t {
 public:
   mesh_t mesh;
+  vtuWriter_t vtu;
 
   int Nfields;
 
@@ -77,7 +79,7 @@ public:
 
   void Report();
 
-  void PlotFields();
+  void PlotFields(const std::string fileName, const int frame=-1);
 };
 
 #endif
@@ -44,6 +44,6 @@ void gradient_t::Report(){
     o_gradq.copyTo(gradq);
 
     // output field files
-    PlotFields();
+    PlotFields("gradient");
   }
 }
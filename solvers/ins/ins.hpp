@@ -30,6 +30,7 @@
 #include "core.hpp"
 #include "platform.hpp"
 #include "mesh.hpp"
+#include "mesh/meshVTU.hpp"
 #include "solver.hpp"
 #include "timeStepper.hpp"
 #include "linAlg.hpp"
@@ -78,9 +79,27 @@ public:
   void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
 };
 
+//Applies one velocity operator, or its preconditioner, to each
+// component of a block vector
+class insVelocityBlock_t: public operator_t {
+public:
+  elliptic_t& elliptic;
+  int Nfields;
+  dlong Nstride;
+  bool applyPrecon;
+
+  insVelocityBlock_t(elliptic_t& _elliptic, const int _Nfields,
+                     const dlong _Nstride, const bool _applyPrecon):
+    elliptic(_elliptic), Nfields(_Nfields),
+    Nstride(_Nstride), applyPrecon(_applyPrecon) {}
+
+  void Operator(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq);
+};
+
 class ins_t: public solver_t {
 public:
   mesh_t mesh;
+  vtuWriter_t vtu;
   timeStepper_t timeStepper;
 
   ogs::halo_t vTraceHalo;
@@ -95,6 +114,13 @@ public:
   linearSolver_t wLinearSolver;
   linearSolver_t pLinearSolver;
 
+  //solve all velocity components at once with uSolver's operator and
+  // preconditioner. vLinearSolver then holds the block solver
+  int vBlockSolve=0;
+
+  //lambda the velocity preconditioners were last built for
+  dfloat vPreconLambda;
+
   int NVfields, NTfields;
 
   int NiterU, NiterV, NiterW, NiterP;
@@ -106,6 +132,8 @@ public:
   dfloat nu;
   dfloat vTau, pTau;
 
+  dfloat hmin; //smallest element length, for time step limits
+
   memory<dfloat> u, p;
   deviceMemory<dfloat> o_u, o_p;
 
@@ -123,6 +151,10 @@ public:
 
   deviceMemory<dfloat> o_GUH, o_GVH, o_GWH;
   deviceMemory<dfloat> o_GrhsU, o_GrhsV, o_GrhsW;
+
+  //storage behind the velocity components in a block solve
+  deviceMemory<dfloat> o_UHblock, o_rhsUblock;
+  deviceMemory<dfloat> o_GUHblock, o_GrhsUblock;
   deviceMemory<dfloat> o_GrhsP, o_GP, o_GPI;
 
   //subcycling
@@ -170,10 +202,14 @@ public:
 
   void Report(dfloat time, int tstep);
 
-  void PlotFields(memory<dfloat>& U, memory<dfloat>& P, memory<dfloat>& V, std::string fileName);
+  void CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields);
+
+  void PlotFields(memory<dfloat>& U, memory<dfloat>& P, memory<dfloat>& V, const std::string fileName, const int frame=-1);
 
   dfloat MaxWaveSpeed(deviceMemory<dfloat>& o_U, const dfloat T);
 
+  dfloat MaxTimeStep(deviceMemory<dfloat>& o_U, const dfloat T);
+
   // void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
 
   void rhs_imex_f(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
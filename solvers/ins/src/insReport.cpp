@@ -51,9 +51,6 @@ void ins_t::Report(dfloat time, int tstep){
     // output field files
     std::string name;
     settings.getSetting("OUTPUT FILE NAME", name);
-    char fname[BUFSIZ];
-    sprintf(fname, "%s_%04d_%04d.vtu", name.c_str(), mesh.rank, frame++);
-
-    PlotFields(u, p, Vort, std::string(fname));
+    PlotFields(u, p, Vort, name, frame++);
   }
 }
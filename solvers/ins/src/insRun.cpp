@@ -41,24 +41,10 @@ void ins_t::Run(){
                          o_u,
                          o_p);
 
-  dfloat cfl=1.0;
-  settings.getSetting("CFL NUMBER", cfl);
-
   // set time step
-  dfloat hmin = mesh.MinCharacteristicLength();
-  dfloat vmax = MaxWaveSpeed(o_u, startTime);
-
-  dfloat dtAdvc = cfl/(vmax*(mesh.N+1.)*(mesh.N+1.));
-  dfloat dtDiff = nu>0.0 ? cfl*pow(hmin, 2)/(pow(mesh.N+1,4)*nu) : 1.0e9;
-
-  dfloat dt = 0.0;
-  if (settings.compareSetting("TIME INTEGRATOR","EXTBDF3")) {
-    dt = dtAdvc;
-  } else if (settings.compareSetting("TIME INTEGRATOR","SSBDF3")) {
-    dt = Nsubcycles*dtAdvc;
-    subStepper.SetTimeStep(dtAdvc);
-  } else {
-    dt = std::min(dtAdvc, dtDiff);
+  dfloat dt = MaxTimeStep(o_u, startTime);
+  if (settings.compareSetting("TIME INTEGRATOR","SSBDF3")) {
+    subStepper.SetTimeStep(dt/Nsubcycles);
   }
 
   timeStepper.SetTimeStep(dt);
@@ -78,3 +64,27 @@ void ins_t::Run(){
   }
 
 }
+
+dfloat ins_t::MaxTimeStep(deviceMemory<dfloat>& o_U, const dfloat T){
+
+  dfloat cfl=1.0;
+  settings.getSetting("CFL NUMBER", cfl);
+
+  dfloat vmax = MaxWaveSpeed(o_U, T);
+
+  dfloat dtAdvc = cfl/(vmax*(mesh.N+1.)*(mesh.N+1.));
+  dfloat dtDiff = nu>0.0 ? cfl*pow(hmin, 2)/(pow(mesh.N+1,4)*nu) : 1.0e9;
+
+  if (settings.compareSetting("TIME INTEGRATOR","EXTBDF3")) {
+    return dtAdvc;
+  } else if (settings.compareSetting("TIME INTEGRATOR","SSBDF3")) {
+    return Nsubcycles*dtAdvc;
+  } else {
+    return std::min(dtAdvc, dtDiff);
+  }
+}
+
+//the pressure is carried between steps
+void ins_t::CheckpointFields(std::vector<deviceMemory<dfloat>>& o_fields) {
+  o_fields.push_back(o_p);
+}
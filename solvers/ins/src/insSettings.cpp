@@ -57,6 +57,15 @@ insSettings_t::insSettings_t(comm_t& _comm):
              "1.0",
              "Multiplier for timestep stability bound");
 
+  newSetting("ADAPTIVE TIME STEP",
+             "FALSE",
+             "Periodically recompute the time step from the CFL bound",
+             {"TRUE", "FALSE"});
+
+  newSetting("TIME STEP UPDATE INTERVAL",
+             "10",
+             "Number of time steps between time step updates");
+
   newSetting("NUMBER OF SUBCYCLES",
              "1",
              "Ratio of full timestep size to subcycling step size");
@@ -86,6 +95,13 @@ insSettings_t::insSettings_t(comm_t& _comm):
   newSetting("OUTPUT FILE NAME",
              "ins");
 
+  TimeStepper::AddSettings(*this);
+
+  newSetting("VELOCITY BLOCK SOLVE",
+             "FALSE",
+             "Solve all velocity components together with one shared preconditioner",
+             {"TRUE", "FALSE"});
+
   ellipticAddSettings(*this, "VELOCITY ");
   parAlmond::AddSettings(*this, "VELOCITY ");
   InitialGuess::AddSettings(*this, "VELOCITY ");
@@ -110,16 +126,25 @@ void insSettings_t::report() {
       reportSetting("SUBCYCLING TIME INTEGRATOR");
     }
 
+    reportSetting("ADAPTIVE TIME STEP");
+    if (compareSetting("ADAPTIVE TIME STEP", "TRUE"))
+      reportSetting("TIME STEP UPDATE INTERVAL");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
     reportSetting("OUTPUT INTERVAL");
     reportSetting("OUTPUT TO FILE");
     reportSetting("OUTPUT FILE NAME");
+    TimeStepper::ReportSettings(*this);
 
     std::cout << "\nVelocity Solver Settings:\n\n";
 
     reportSetting("VELOCITY DISCRETIZATION");
+    if (compareSetting("VELOCITY DISCRETIZATION","CONTINUOUS"))
+      reportSetting("VELOCITY ELLIPTIC AX AUTOTUNE");
+    reportSetting("VELOCITY BLOCK SOLVE");
     reportSetting("VELOCITY LINEAR SOLVER");
+    if (compareSetting("VELOCITY LINEAR SOLVER","SSTEPCG"))
+      reportSetting("VELOCITY LINEAR SOLVER S-STEP");
     reportSetting("VELOCITY INITIAL GUESS STRATEGY");
     reportSetting("VELOCITY INITIAL GUESS HISTORY SPACE DIMENSION");
     reportSetting("VELOCITY PRECONDITIONER");
@@ -127,8 +152,10 @@ void insSettings_t::report() {
     if (compareSetting("VELOCITY PRECONDITIONER","MULTIGRID")) {
       reportSetting("VELOCITY MULTIGRID COARSENING");
       reportSetting("VELOCITY MULTIGRID SMOOTHER");
-      if (compareSetting("VELOCITY MULTIGRID SMOOTHER","CHEBYSHEV"))
+      if (compareSetting("VELOCITY MULTIGRID SMOOTHER","CHEBYSHEV")
+        ||compareSetting("VELOCITY MULTIGRID SMOOTHER","LOCALPATCH"))
         reportSetting("VELOCITY MULTIGRID CHEBYSHEV DEGREE");
+      reportSetting("VELOCITY MULTIGRID PRECISION");
     }
 
     if (compareSetting("VELOCITY PRECONDITIONER","MULTIGRID")
@@ -141,7 +168,11 @@ void insSettings_t::report() {
     std::cout << "\nPressure Solver Settings:\n\n";
 
     reportSetting("PRESSURE DISCRETIZATION");
+    if (compareSetting("PRESSURE DISCRETIZATION","CONTINUOUS"))
+      reportSetting("PRESSURE ELLIPTIC AX AUTOTUNE");
     reportSetting("PRESSURE LINEAR SOLVER");
+    if (compareSetting("PRESSURE LINEAR SOLVER","SSTEPCG"))
+      reportSetting("PRESSURE LINEAR SOLVER S-STEP");
     reportSetting("PRESSURE INITIAL GUESS STRATEGY");
     reportSetting("PRESSURE INITIAL GUESS HISTORY SPACE DIMENSION");
     reportSetting("PRESSURE PRECONDITIONER");
@@ -149,8 +180,10 @@ void insSettings_t::report() {
     if (compareSetting("PRESSURE PRECONDITIONER","MULTIGRID")) {
       reportSetting("PRESSURE MULTIGRID COARSENING");
       reportSetting("PRESSURE MULTIGRID SMOOTHER");
-      if (compareSetting("PRESSURE MULTIGRID SMOOTHER","CHEBYSHEV"))
+      if (compareSetting("PRESSURE MULTIGRID SMOOTHER","CHEBYSHEV")
+        ||compareSetting("PRESSURE MULTIGRID SMOOTHER","LOCALPATCH"))
         reportSetting("PRESSURE MULTIGRID CHEBYSHEV DEGREE");
+      reportSetting("PRESSURE MULTIGRID PRECISION");
     }
 
     if (compareSetting("PRESSURE PRECONDITIONER","MULTIGRID")
@@ -67,11 +67,16 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
                                            mesh.Np, NVfields, platform, comm);
     gamma = timeStepper.GetGamma();
   }
+  timeStepper.EnableCheckpointing();
+  timeStepper.EnableAdaptiveTimeStep();
 
   Nsubcycles=1;
   if (settings.compareSetting("TIME INTEGRATOR","SSBDF3"))
     settings.getSetting("NUMBER OF SUBCYCLES", Nsubcycles);
 
+  //the mesh is static, so find the smallest element length once
+  hmin = mesh.MinCharacteristicLength();
+
   //Setup velocity Elliptic solvers
   dlong uNlocal=0, vNlocal=0, wNlocal=0;
   dlong uNhalo=0, vNhalo=0, wNhalo=0;
@@ -118,32 +123,77 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
     vSettings = _settings.extractVelocitySettings();
 
-    //make a guess at dt for the lambda value
-    //TODO: we should allow preconditioners to be re-setup if lambda is updated
-    dfloat hmin = mesh.MinCharacteristicLength();
+    //make a guess at dt for the lambda value. VelocitySolve updates
+    // preconditioners which support it once the actual lambda is known
     dfloat dtAdvc = Nsubcycles*hmin/((mesh.N+1.)*(mesh.N+1.));
     dfloat lambda = gamma/(dtAdvc*nu);
+    vPreconLambda = lambda;
+
+    //a block velocity solve shares one operator and preconditioner, so
+    // every velocity component must see the same boundary conditions
+    vBlockSolve = settings.compareSetting("VELOCITY BLOCK SOLVE", "TRUE") ? 1 : 0;
+    if (vBlockSolve) {
+      int mixedBCs = 0;
+      for (dlong n=0;n<mesh.Nelements*mesh.Nfaces;++n) {
+        const int bc = mesh.EToB[n];
+        if (bc>0 && bc<NBCTypes) {
+          if (uBCType[bc]!=vBCType[bc]) mixedBCs = 1;
+          if (mesh.dim==3 && uBCType[bc]!=wBCType[bc]) mixedBCs = 1;
+        }
+      }
+      comm.Allreduce(mixedBCs, Comm::Max);
+
+      if (mixedBCs) {
+        if (mesh.rank==0)
+          printf("Warning: velocity components have different boundary conditions, using separate velocity solves\n");
+        vBlockSolve = 0;
+      }
+    }
+
+    if (vBlockSolve) {
+      LIBP_ABORT("Block velocity solve requires VELOCITY LINEAR SOLVER = PCG",
+                 !vSettings.compareSetting("LINEAR SOLVER","PCG"));
+      LIBP_ABORT("Block velocity solve does not support projection initial guesses",
+                 vSettings.compareSetting("INITIAL GUESS STRATEGY", "CLASSIC")
+               ||vSettings.compareSetting("INITIAL GUESS STRATEGY", "QR"));
+    }
+
     uSolver.Setup(platform, mesh, vSettings,
                   lambda, NBCTypes, uBCType);
-    vSolver.Setup(platform, mesh, vSettings,
-                  lambda, NBCTypes, vBCType);
-    if (mesh.dim == 3)
-      wSolver.Setup(platform, mesh, vSettings,
-                    lambda, NBCTypes, wBCType);
+    if (!vBlockSolve) {
+      vSolver.Setup(platform, mesh, vSettings,
+                    lambda, NBCTypes, vBCType);
+      if (mesh.dim == 3)
+        wSolver.Setup(platform, mesh, vSettings,
+                      lambda, NBCTypes, wBCType);
+    }
 
     vTau = uSolver.tau;
 
     vDisc_c0 = settings.compareSetting("VELOCITY DISCRETIZATION", "CONTINUOUS") ? 1 : 0;
 
-    uNlocal = uSolver.Ndofs;
-    vNlocal = vSolver.Ndofs;
-    if (mesh.dim == 3) wNlocal = wSolver.Ndofs;
+    if (vBlockSolve) {
+      //all components share uSolver's dofs
+      uNlocal = vNlocal = wNlocal = uSolver.Ndofs;
+      uNhalo  = vNhalo  = wNhalo  = uSolver.Nhalo;
+    } else {
+      uNlocal = uSolver.Ndofs;
+      vNlocal = vSolver.Ndofs;
+      if (mesh.dim == 3) wNlocal = wSolver.Ndofs;
+
+      uNhalo = uSolver.Nhalo;
+      vNhalo = vSolver.Nhalo;
+      if (mesh.dim == 3) wNhalo = wSolver.Nhalo;
+    }
 
-    uNhalo = uSolver.Nhalo;
-    vNhalo = vSolver.Nhalo;
-    if (mesh.dim == 3) wNhalo = wSolver.Nhalo;
+    //block vectors hold the components back to back
+    const dlong Nblock = NVfields*(uNlocal+uNhalo);
 
-    if (vSettings.compareSetting("LINEAR SOLVER","NBPCG")){
+    if (vBlockSolve) {
+
+      vLinearSolver.Setup<LinearSolver::blockpcg>(uNlocal, uNhalo, NVfields, platform, vSettings, comm);
+
+    } else if (vSettings.compareSetting("LINEAR SOLVER","NBPCG")){
 
       uLinearSolver.Setup<LinearSolver::nbpcg>(uNlocal, uNhalo, platform, vSettings, comm);
       vLinearSolver.Setup<LinearSolver::nbpcg>(vNlocal, vNhalo, platform, vSettings, comm);
@@ -157,6 +207,20 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
       if (mesh.dim==3)
         wLinearSolver.Setup<LinearSolver::nbfpcg>(wNlocal, wNhalo, platform, vSettings, comm);
 
+    } else if (vSettings.compareSetting("LINEAR SOLVER","PIPECG")){
+
+      uLinearSolver.Setup<LinearSolver::pipecg>(uNlocal, uNhalo, platform, vSettings, comm);
+      vLinearSolver.Setup<LinearSolver::pipecg>(vNlocal, vNhalo, platform, vSettings, comm);
+      if (mesh.dim==3)
+        wLinearSolver.Setup<LinearSolver::pipecg>(wNlocal, wNhalo, platform, vSettings, comm);
+
+    } else if (vSettings.compareSetting("LINEAR SOLVER","SSTEPCG")){
+
+      uLinearSolver.Setup<LinearSolver::sstepcg>(uNlocal, uNhalo, platform, vSettings, comm);
+      vLinearSolver.Setup<LinearSolver::sstepcg>(vNlocal, vNhalo, platform, vSettings, comm);
+      if (mesh.dim==3)
+        wLinearSolver.Setup<LinearSolver::sstepcg>(wNlocal, wNhalo, platform, vSettings, comm);
+
     } else if (vSettings.compareSetting("LINEAR SOLVER","PCG")){
 
       uLinearSolver.Setup<LinearSolver::pcg>(uNlocal, uNhalo, platform, vSettings, comm);
@@ -179,7 +243,17 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
         wLinearSolver.Setup<LinearSolver::pminres>(wNlocal, wNhalo, platform, vSettings, comm);
     }
 
-    if (vSettings.compareSetting("INITIAL GUESS STRATEGY", "NONE")) {
+    if (vBlockSolve) {
+
+      if (vSettings.compareSetting("INITIAL GUESS STRATEGY", "NONE")) {
+        vLinearSolver.SetupInitialGuess<InitialGuess::Default>(Nblock, platform, vSettings, comm);
+      } else if (vSettings.compareSetting("INITIAL GUESS STRATEGY", "ZERO")) {
+        vLinearSolver.SetupInitialGuess<InitialGuess::Zero>(Nblock, platform, vSettings, comm);
+      } else if (vSettings.compareSetting("INITIAL GUESS STRATEGY", "EXTRAP")) {
+        vLinearSolver.SetupInitialGuess<InitialGuess::Extrap>(Nblock, platform, vSettings, comm);
+      }
+
+    } else if (vSettings.compareSetting("INITIAL GUESS STRATEGY", "NONE")) {
 
       uLinearSolver.SetupInitialGuess<InitialGuess::Default>(uNlocal, platform, vSettings, comm);
       vLinearSolver.SetupInitialGuess<InitialGuess::Default>(vNlocal, platform, vSettings, comm);
@@ -262,6 +336,10 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
       pLinearSolver.Setup<LinearSolver::nbpcg>(pNlocal, pNhalo, platform, pSettings, comm);
     } else if (pSettings.compareSetting("LINEAR SOLVER","NBFPCG")){
       pLinearSolver.Setup<LinearSolver::nbfpcg>(pNlocal, pNhalo, platform, pSettings, comm);
+    } else if (pSettings.compareSetting("LINEAR SOLVER","PIPECG")){
+      pLinearSolver.Setup<LinearSolver::pipecg>(pNlocal, pNhalo, platform, pSettings, comm);
+    } else if (pSettings.compareSetting("LINEAR SOLVER","SSTEPCG")){
+      pLinearSolver.Setup<LinearSolver::sstepcg>(pNlocal, pNhalo, platform, pSettings, comm);
     } else if (pSettings.compareSetting("LINEAR SOLVER","PCG")){
       pLinearSolver.Setup<LinearSolver::pcg>(pNlocal, pNhalo, platform, pSettings, comm);
     } else if (pSettings.compareSetting("LINEAR SOLVER","PGMRES")){
@@ -314,17 +392,52 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
   //extra buffers for solvers
   if (settings.compareSetting("TIME INTEGRATOR","EXTBDF3")
     ||settings.compareSetting("TIME INTEGRATOR","SSBDF3")) {
-    o_UH = platform.malloc<dfloat>(Nlocal+Nhalo, u);
-    o_VH = platform.malloc<dfloat>(Nlocal+Nhalo, u);
-    if (mesh.dim==3)
-      o_WH = platform.malloc<dfloat>(Nlocal+Nhalo, u);
+    if (vBlockSolve && !vDisc_c0) {
+      //components are views into one block vector
+      const dlong Nstride = uNlocal+uNhalo;
+      memory<dfloat> zeros(NVfields*Nstride, 0.0);
+      o_UHblock = platform.malloc<dfloat>(zeros);
+      o_rhsUblock = platform.malloc<dfloat>(zeros);
+
+      o_UH = o_UHblock;
+      o_VH = o_UHblock + Nstride;
+      if (mesh.dim==3)
+        o_WH = o_UHblock + 2*Nstride;
+
+      o_rhsU = o_rhsUblock;
+      o_rhsV = o_rhsUblock + Nstride;
+      if (mesh.dim==3)
+        o_rhsW = o_rhsUblock + 2*Nstride;
+    } else {
+      o_UH = platform.malloc<dfloat>(Nlocal+Nhalo, u);
+      o_VH = platform.malloc<dfloat>(Nlocal+Nhalo, u);
+      if (mesh.dim==3)
+        o_WH = platform.malloc<dfloat>(Nlocal+Nhalo, u);
+
+      o_rhsU = platform.malloc<dfloat>(Nlocal+Nhalo, u);
+      o_rhsV = platform.malloc<dfloat>(Nlocal+Nhalo, u);
+      if (mesh.dim==3)
+        o_rhsW = platform.malloc<dfloat>(Nlocal+Nhalo, u);
+    }
 
-    o_rhsU = platform.malloc<dfloat>(Nlocal+Nhalo, u);
-    o_rhsV = platform.malloc<dfloat>(Nlocal+Nhalo, u);
-    if (mesh.dim==3)
-      o_rhsW = platform.malloc<dfloat>(Nlocal+Nhalo, u);
+    if (vDisc_c0 && vBlockSolve) {
+      //components are views into one block vector
+      const dlong Nstride = uNlocal+uNhalo;
+      memory<dfloat> zeros(NVfields*Nstride, 0.0);
+      o_GUHblock = platform.malloc<dfloat>(zeros);
+      o_GrhsUblock = platform.malloc<dfloat>(zeros);
+
+      o_GUH = o_GUHblock;
+      o_GVH = o_GUHblock + Nstride;
+      if (mesh.dim==3)
+        o_GWH = o_GUHblock + 2*Nstride;
+
+      o_GrhsU = o_GrhsUblock;
+      o_GrhsV = o_GrhsUblock + Nstride;
+      if (mesh.dim==3)
+        o_GrhsW = o_GrhsUblock + 2*Nstride;
 
-    if (vDisc_c0) {
+    } else if (vDisc_c0) {
       o_GUH = platform.malloc<dfloat>(uNlocal+uNhalo, u);
       o_GVH = platform.malloc<dfloat>(vNlocal+vNhalo, u);
       if (mesh.dim==3)
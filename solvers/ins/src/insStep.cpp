@@ -28,8 +28,8 @@ SOFTWARE.
 
 dfloat ins_t::MaxWaveSpeed(deviceMemory<dfloat>& o_U, const dfloat T){
 
-  //Note: if this is on the critical path in the future, we should pre-allocate this
-  deviceMemory<dfloat> o_maxSpeed = platform.malloc<dfloat>(mesh.Nelements);
+  //scratch buffer, recycled through the platform workspace
+  scratchMemory<dfloat> o_maxSpeed = platform.reserve<dfloat>(mesh.Nelements);
 
   maxWaveSpeedKernel(mesh.Nelements,
                      mesh.o_vgeo,
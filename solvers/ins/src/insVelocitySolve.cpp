@@ -65,11 +65,55 @@ void ins_t::VelocitySolve(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_RHS
   int verbose = 0;
 
   uSolver.lambda = gamma/nu;
-  vSolver.lambda = gamma/nu;
-  wSolver.lambda = gamma/nu;
+  if (!vBlockSolve) {
+    vSolver.lambda = gamma/nu;
+    wSolver.lambda = gamma/nu;
+  }
+
+  //lambda changes with the BDF order during startup and with the time
+  // step. Refresh the preconditioners once it drifts from the value they
+  // were built for. Those without an update keep their setup lambda
+  const dfloat lambdaTol = 0.1;
+  if (std::abs(gamma/nu - vPreconLambda) > lambdaTol*vPreconLambda) {
+    vPreconLambda = gamma/nu;
+    uSolver.precon.UpdateLambda(vPreconLambda);
+    if (!vBlockSolve) {
+      vSolver.precon.UpdateLambda(vPreconLambda);
+      if (mesh.dim==3)
+        wSolver.precon.UpdateLambda(vPreconLambda);
+    }
+  }
 
   //  Solve lambda*U - Laplacian*U = rhs
-  if (vDisc_c0){
+  if (vBlockSolve) {
+    //all components share uSolver's operator and preconditioner
+    const dlong Nstride = uSolver.Ndofs + uSolver.Nhalo;
+    insVelocityBlock_t A(uSolver, NVfields, Nstride, false);
+    insVelocityBlock_t M(uSolver, NVfields, Nstride, true);
+
+    if (vDisc_c0){
+      //gather all components with a single halo exchange
+      std::vector<deviceMemory<dfloat>> o_rhs  = {o_rhsU, o_rhsV};
+      std::vector<deviceMemory<dfloat>> o_Grhs = {o_GrhsU, o_GrhsV};
+      if (mesh.dim==3) {
+        o_rhs.push_back(o_rhsW);
+        o_Grhs.push_back(o_GrhsW);
+      }
+      uSolver.ogsMasked.Gather(o_Grhs, o_rhs, ogs::Add, ogs::Trans);
+
+      NiterU = vLinearSolver.Solve(A, M, o_GUHblock, o_GrhsUblock, velTOL, maxIter, verbose);
+
+      uSolver.ogsMasked.Scatter(o_UH, o_GUH, 1, ogs::NoTrans);
+      uSolver.ogsMasked.Scatter(o_VH, o_GVH, 1, ogs::NoTrans);
+      if (mesh.dim==3)
+        uSolver.ogsMasked.Scatter(o_WH, o_GWH, 1, ogs::NoTrans);
+    } else {
+      NiterU = vLinearSolver.Solve(A, M, o_UHblock, o_rhsUblock, velTOL, maxIter, verbose);
+    }
+    NiterV = NiterU;
+    NiterW = NiterU;
+
+  } else if (vDisc_c0){
     // gather, solve, scatter
     uSolver.ogsMasked.Gather(o_GrhsU, o_rhsU, 1, ogs::Add, ogs::Trans);
     NiterU = uSolver.Solve(uLinearSolver, o_GUH, o_GrhsU, velTOL, maxIter, verbose);
@@ -108,3 +152,21 @@ void ins_t::VelocitySolve(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_RHS
                   o_WH,
                   o_U);
 }
+
+void insVelocityBlock_t::Operator(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq) {
+  std::vector<deviceMemory<dfloat>> o_qs(Nfields);
+  std::vector<deviceMemory<dfloat>> o_Aqs(Nfields);
+  for (int f=0;f<Nfields;++f) {
+    o_qs[f]  = o_q  + f*Nstride;
+    o_Aqs[f] = o_Aq + f*Nstride;
+  }
+
+  if (applyPrecon) {
+    for (int f=0;f<Nfields;++f) {
+      elliptic.precon.Operator(o_qs[f], o_Aqs[f]);
+    }
+  } else {
+    //one exchange and one gather for all components
+    elliptic.Operator(o_qs, o_Aqs);
+  }
+}
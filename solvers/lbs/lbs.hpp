@@ -30,6 +30,7 @@
 #include "core.hpp"
 #include "platform.hpp"
 #include "mesh.hpp"
+#include "mesh/meshVTU.hpp"
 #include "solver.hpp"
 #include "timeStepper.hpp"
 #include "linAlg.hpp"
@@ -50,6 +51,7 @@ public:
 class lbs_t: public solver_t {
 public:
   mesh_t mesh;
+  vtuWriter_t vtu;
 
   int Nfields;
   int Nmacro;
@@ -133,7 +135,7 @@ public:
 
   void Report(dfloat time, int tstep);
 
-  void PlotFields(memory<dfloat>& Q, memory<dfloat>& V, std::string fileName);
+  void PlotFields(memory<dfloat>& Q, memory<dfloat>& V, const std::string fileName, const int frame=-1);
 
   dfloat MaxWaveSpeed();
 
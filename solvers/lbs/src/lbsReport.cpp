@@ -53,10 +53,7 @@ void lbs_t::Report(dfloat time, int tstep){
     // output field files
     std::string name;
     settings.getSetting("OUTPUT FILE NAME", name);
-    char fname[BUFSIZ];
-    sprintf(fname, "%s_%04d_%04d.vtu", name.c_str(), mesh.rank, frame++);
-
     // PlotFields(o_q, Vort, fname);
-    PlotFields(U, Vort, std::string(fname));
+    PlotFields(U, Vort, name, frame++);
   }
 }
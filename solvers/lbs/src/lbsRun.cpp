@@ -77,6 +77,10 @@ void lbs_t::Run(){
 #endif
   timeStepper.SetTimeStep(dt);
 
+  //rounding error and timing of the single precision trace exchange
+  if (traceHalo.compressed)
+    traceHalo.ReportCompression(o_q, 1);
+
   timeStepper.Run(*this, o_q, startTime, finalTime);
 
 
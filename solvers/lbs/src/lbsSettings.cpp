@@ -92,6 +92,13 @@ lbsSettings_t::lbsSettings_t(comm_t& _comm):
 
   newSetting("OUTPUT FILE NAME",
              "lbs");
+
+  newSetting("HALO COMPRESSION",
+             "FALSE",
+             "Round trace halo data to single precision for MPI exchanges",
+             {"TRUE", "FALSE"});
+
+  TimeStepper::AddSettings(*this);
 }
 
 void lbsSettings_t::report() {
@@ -112,6 +119,8 @@ void lbsSettings_t::report() {
     reportSetting("OUTPUT INTERVAL");
     reportSetting("OUTPUT TO FILE");
     reportSetting("OUTPUT FILE NAME");
+    reportSetting("HALO COMPRESSION");
+    TimeStepper::ReportSettings(*this);
   }
 }
 
@@ -68,6 +68,7 @@ void lbs_t::Setup(platform_t& _platform, mesh_t& _mesh,
   }else {
     LIBP_FORCE_ABORT("Requested TIME INTEGRATOR not found.");
   }
+  timeStepper.EnableCheckpointing();
 
   
   //setup linear algebra module
@@ -75,6 +76,7 @@ void lbs_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   /*setup trace halo exchange */
   traceHalo = mesh.HaloTraceSetup(Nfields);
+  traceHalo.compressed = settings.compareSetting("HALO COMPRESSION", "TRUE");
 
   // compute samples of q at interpolation nodes
   q.malloc(Nlocal+Nhalo, 0.0);
@@ -98,7 +98,7 @@ def writeSetup(filename, settings):
   file.write(str_settings)
   file.close()
 
-def test(name, cmd, settings, referenceNorm, ranks=1):
+def test(name, cmd, settings, referenceNorm, ranks=1, checkOutput=None):
 
   #create input file
   writeSetup("setup",settings)
@@ -128,7 +128,16 @@ def test(name, cmd, settings, referenceNorm, ranks=1):
     failed=0;
     if "Solution norm = " in output:
       norm = float(output.split()[3])
-      if abs(norm - referenceNorm) < TOL:
+      if abs(norm - referenceNorm) < TOL and checkOutput is not None \
+         and not checkOutput(run.stdout.decode()):
+        #failed solver specific output check
+        print(bcolors.FAIL + "FAIL" + bcolors.ENDC)
+        print(bcolors.WARNING + name + " stdout:" + bcolors.ENDC)
+        print(run.stdout.decode())
+        #save the setup for reproducibility
+        writeSetup(name,settings)
+        failed = 1
+      elif abs(norm - referenceNorm) < TOL:
         print(bcolors.PASS + "PASS" + bcolors.ENDC)
       else:
         #failed residual check
@@ -35,7 +35,9 @@ def advectionSettings(rcformat="2.0", data_file=advectionData2D,
                      mesh="BOX", dim=2, element=4, nx=10, ny=10, nz=10, boundary_flag=-1,
                      degree=4, thread_model=device, platform_number=0, device_number=0,
                       time_integrator="DOPRI5", cfl=1.0, start_time=0.0, final_time=1.0,
-                      output_to_file="FALSE"):
+                      output_to_file="FALSE", halo_compression="FALSE",
+                      checkpoint_interval=0, restart_file="NONE",
+                      adaptive_time_step="FALSE", time_step_update_interval=10):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
           setting_t("MESH FILE", mesh),
@@ -53,7 +55,26 @@ def advectionSettings(rcformat="2.0", data_file=advectionData2D,
           setting_t("CFL NUMBER", cfl),
           setting_t("START TIME", start_time),
           setting_t("FINAL TIME", final_time),
-          setting_t("OUTPUT TO FILE", output_to_file)]
+          setting_t("OUTPUT TO FILE", output_to_file),
+          setting_t("HALO COMPRESSION", halo_compression),
+          setting_t("CHECKPOINT INTERVAL", checkpoint_interval),
+          setting_t("RESTART FILE", restart_file),
+          setting_t("ADAPTIVE TIME STEP", adaptive_time_step),
+          setting_t("TIME STEP UPDATE INTERVAL", time_step_update_interval)]
+
+#the compressed trace exchange must round, but only to single precision
+def haloCompressionCheck(output):
+  match = re.search(r"max rounding error \S+ \(relative (\S+)\)", output)
+  if match is None:
+    return False
+  relativeError = float(match.group(1))
+  return relativeError > 0.0 and relativeError < 1.0e-6
+
+def checkpointWriteCheck(output):
+  return "Wrote checkpoint checkpoint_000010.chk" in output
+
+def checkpointRestartCheck(output):
+  return "Restarting from checkpoint checkpoint_000010.chk at time step 10" in output
 
 def main():
   failCount=0;
@@ -83,9 +104,41 @@ def main():
                     settings=advectionSettings(element=3,data_file=advectionData2D,dim=2,output_to_file="TRUE"),
                     referenceNorm=0.723627520020827)
 
+  failCount += test(name="testAdvectionTri_MPI_HaloCompression", ranks=4,
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,dim=2,
+                                               halo_compression="TRUE"),
+                    referenceNorm=0.723627520020827,
+                    checkOutput=haloCompressionCheck)
+
+  #the wave speed is constant, so recomputing the step from the CFL bound
+  # must reproduce the fixed step AB3 run
+  failCount += test(name="testAdvectionTri_AB3_AdaptiveTimeStep",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,dim=2,
+                                               time_integrator="AB3", cfl=0.25,
+                                               adaptive_time_step="TRUE",
+                                               time_step_update_interval=5),
+                    referenceNorm=0.723972801309193)
+
+  #write checkpoints, then resume from one and finish with the same norm
+  failCount += test(name="testAdvectionQuad_Checkpoint",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=4,data_file=advectionData2D,dim=2,
+                                               checkpoint_interval=10),
+                    referenceNorm=0.722791610885232,
+                    checkOutput=checkpointWriteCheck)
+
+  failCount += test(name="testAdvectionQuad_Restart",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=4,data_file=advectionData2D,dim=2,
+                                               restart_file="checkpoint_000010.chk"),
+                    referenceNorm=0.722791610885232,
+                    checkOutput=checkpointRestartCheck)
+
   #clean up
   for file_name in os.listdir(testDir):
-    if file_name.endswith('.vtu'):
+    if file_name.endswith('.vtu') or file_name.endswith('.chk'):
       os.remove(testDir + "/" + file_name)
 
   return failCount
@@ -35,10 +35,14 @@ def ellipticSettings(rcformat="2.0", data_file=ellipticData2D,
                      mesh="BOX", dim=2, element=4, nx=10, ny=10, nz=10, boundary_flag=1,
                      degree=4, thread_model=device, platform_number=0, device_number=0,
                      Lambda=1.0,
+                     element_map="ISOPARAMETRIC",
                      discretization="CONTINUOUS",
+                     integration="GLL",
+                     ax_autotune="FALSE",
                      linear_solver="PCG",
                      precon="MULTIGRID",
                      multigrid_smoother="CHEBYSHEV",
+                     multigrid_precision="DOUBLE",
                      paralmond_cycle="VCYCLE",
                      paralmond_strength="SYMMETRIC",
                      paralmond_aggregation="UNSMOOTHED",
@@ -49,6 +53,7 @@ def ellipticSettings(rcformat="2.0", data_file=ellipticData2D,
           setting_t("MESH FILE", mesh),
           setting_t("MESH DIMENSION", dim),
           setting_t("ELEMENT TYPE", element),
+          setting_t("ELEMENT MAP", element_map),
           setting_t("BOX NX", nx),
           setting_t("BOX NY", ny),
           setting_t("BOX NZ", nz),
@@ -61,9 +66,12 @@ def ellipticSettings(rcformat="2.0", data_file=ellipticData2D,
           setting_t("PLATFORM NUMBER", platform_number),
           setting_t("DEVICE NUMBER", device_number),
           setting_t("DISCRETIZATION", discretization),
+          setting_t("ELLIPTIC INTEGRATION", integration),
+          setting_t("ELLIPTIC AX AUTOTUNE", ax_autotune),
           setting_t("LINEAR SOLVER", linear_solver),
           setting_t("PRECONDITIONER", precon),
           setting_t("MULTIGRID SMOOTHER", multigrid_smoother),
+          setting_t("MULTIGRID PRECISION", multigrid_precision),
           setting_t("PARALMOND CYCLE", paralmond_cycle),
           setting_t("PARALMOND STRENGTH", paralmond_strength),
           setting_t("PARALMOND AGGREGATION", paralmond_aggregation),
@@ -97,6 +105,18 @@ def main():
                     settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3, precon="NONE"),
                     referenceNorm=0.353553390458384)
 
+  failCount += test(name="testEllipticHex_C0_Trilinear",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3, precon="NONE",
+                                              element_map="TRILINEAR"),
+                    referenceNorm=0.353553390458384)
+
+  failCount += test(name="testEllipticHex_C0_Cubature",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3, precon="NONE",
+                                              integration="CUBATURE"),
+                    referenceNorm=0.353553390458384)
+
   failCount += test(name="testEllipticQuad3D_C0",
                     cmd=ellipticBin,
                     settings=ellipticSettings(element=4,data_file=ellipticData3D,mesh="sphereQuad.msh", dim=3, precon="NONE"),
@@ -152,6 +172,21 @@ def main():
                     settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
                                               precon="MULTIGRID"),
                     referenceNorm=0.500000001211135)
+  failCount += test(name="testEllipticQuad_C0_Multigrid_Patch",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
+                                              precon="MULTIGRID", multigrid_smoother="LOCALPATCH"),
+                    referenceNorm=0.500000001211135)
+  failCount += test(name="testEllipticQuad_C0_FDM",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
+                                              precon="FDM"),
+                    referenceNorm=0.500000001211135)
+  failCount += test(name="testEllipticQuad_C0_FDM_Poisson",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
+                                              precon="FDM", Lambda=0.0),
+                    referenceNorm=0.500000001211135)
   failCount += test(name="testEllipticQuad_C0_Semfem",
                     cmd=ellipticBin,
                     settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
@@ -211,6 +246,26 @@ def main():
                     settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
                                               precon="MULTIGRID"),
                     referenceNorm=0.353553400508458)
+  failCount += test(name="testEllipticHex_C0_Multigrid_Float",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                              precon="MULTIGRID", multigrid_precision="FLOAT"),
+                    referenceNorm=0.353553400508458)
+  failCount += test(name="testEllipticHex_C0_Multigrid_Patch",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                              precon="MULTIGRID", multigrid_smoother="LOCALPATCH"),
+                    referenceNorm=0.353553400508458)
+  failCount += test(name="testEllipticHex_C0_AxAutotune",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                              ax_autotune="TRUE"),
+                    referenceNorm=0.353553400508458)
+  failCount += test(name="testEllipticHex_C0_FDM",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                              precon="FDM"),
+                    referenceNorm=0.353553400508458)
   failCount += test(name="testEllipticHex_C0_Semfem",
                     cmd=ellipticBin,
                     settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
@@ -262,6 +317,19 @@ def main():
                                               precon="NONE", discretization="IPDG"),
                     referenceNorm=0.499999999969716)
 
+  failCount += test(name="testEllipticQuad_Ipdg_FDM",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
+                                              precon="FDM", discretization="IPDG"),
+                    referenceNorm=0.499999999969716)
+
+  failCount += test(name="testEllipticQuad_Ipdg_FDM_Poisson",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
+                                              precon="FDM", discretization="IPDG",
+                                              Lambda=0.0),
+                    referenceNorm=0.499999999969716)
+
   failCount += test(name="testEllipticTet_Ipdg",
                     cmd=ellipticBin,
                     settings=ellipticSettings(element=6,data_file=ellipticData3D,dim=3,
@@ -423,6 +491,13 @@ def main():
                                               precon="MULTIGRID", discretization="IPDG", output_to_file="TRUE"),
                     referenceNorm=0.500000001211135)
 
+  #verbose run also checks batched gather-scatter against separate calls
+  failCount += test(name="testEllipticTri_C0_Multigrid_MPI_Verbose", ranks=4,
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,
+                                              precon="MULTIGRID", output_to_file="TRUE"),
+                    referenceNorm=0.500000001211135)
+
   failCount += test(name="testEllipticTri_C0_OAS_MPI", ranks=4,
                     cmd=ellipticBin,
                     settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,
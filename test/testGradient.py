@@ -34,7 +34,7 @@ gradientData3D = gradientDir + "/data/gradientCos3D.h"
 def gradientSettings(rcformat="2.0", data_file=gradientData2D,
                      mesh="BOX", dim=2, element=4, nx=10, ny=10, nz=10, boundary_flag=1,
                      degree=4, thread_model=device, platform_number=0, device_number=0,
-                     paradogs_partitioning="NONE",
+                     paradogs_partitioning="NONE", mesh_cache="NONE", mesh_reader="SERIAL",
                      output_to_file="FALSE"):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
@@ -50,6 +50,8 @@ def gradientSettings(rcformat="2.0", data_file=gradientData2D,
           setting_t("PLATFORM NUMBER", platform_number),
           setting_t("DEVICE NUMBER", device_number),
           setting_t("PARADOGS PARTITIONING", paradogs_partitioning),
+          setting_t("MESH CACHE FILE", mesh_cache),
+          setting_t("MESH FILE READER", mesh_reader),
           setting_t("OUTPUT TO FILE", output_to_file)]
 
 def main():
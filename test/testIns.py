@@ -40,6 +40,7 @@ def insSettings(rcformat="2.0", data_file=insData2D,
                num_subcycles=4, subcycle_integrator="DOPRI5",
                velocity_discretization="CONTINUOUS",
                velocity_linear_solver="PCG",
+               velocity_block_solve="FALSE",
                velocity_precon="JACOBI",
                velocity_multigrid_smoother="CHEBYSHEV",
                velocity_paralmond_cycle="VCYCLE",
@@ -77,6 +78,7 @@ def insSettings(rcformat="2.0", data_file=insData2D,
           setting_t("FINAL TIME", final_time),
           setting_t("VELOCITY DISCRETIZATION", velocity_discretization),
           setting_t("VELOCITY LINEAR SOLVER", velocity_linear_solver),
+          setting_t("VELOCITY BLOCK SOLVE", velocity_block_solve),
           setting_t("VELOCITY PRECONDITIONER", velocity_precon),
           setting_t("VELOCITY MULTIGRID SMOOTHER", velocity_multigrid_smoother),
           setting_t("VELOCITY PARALMOND CYCLE", velocity_paralmond_cycle),
@@ -202,6 +204,27 @@ def main():
                                          time_integrator="SSBDF3"),
                     referenceNorm=1.17790533322325)
 
+  #test block velocity solve, which should match the component-wise solves
+  failCount += test(name="testInsQuad_block",
+                    cmd=insBin,
+                    settings=insSettings(element=4,data_file=insData2D,dim=2,
+                                         velocity_block_solve="TRUE"),
+                    referenceNorm=0.818161265312564)
+
+  failCount += test(name="testInsHex_block",
+                    cmd=insBin,
+                    settings=insSettings(element=12,data_file=insData3D,dim=3,
+                                         nx=6, ny=6, nz=6, degree=2,
+                                         velocity_block_solve="TRUE"),
+                    referenceNorm=1.19564704164048)
+
+  #test AMG velocity preconditioner, updated numerically as lambda changes
+  failCount += test(name="testInsQuad_ParAlmond",
+                    cmd=insBin,
+                    settings=insSettings(element=4,data_file=insData2D,dim=2,
+                                         velocity_precon="PARALMOND"),
+                    referenceNorm=0.818161265312564)
+
   #test wth MPI
   failCount += test(name="testInsTri_MPI", ranks=4,
                     cmd=insBin,
@@ -56,6 +56,18 @@ def main():
                                               precon="NONE", linear_solver="NBFPCG"),
                     referenceNorm=0.500000001211135)
 
+  failCount += test(name="testLinearSolver_PIPECG",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,
+                                              precon="NONE", linear_solver="PIPECG"),
+                    referenceNorm=0.500000001211135)
+
+  failCount += test(name="testLinearSolver_SSTEPCG",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,
+                                              precon="NONE", linear_solver="SSTEPCG"),
+                    referenceNorm=0.500000001211135)
+
   failCount += test(name="testLinearSolver_PGMRES",
                     cmd=ellipticBin,
                     settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,
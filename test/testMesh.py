@@ -29,6 +29,12 @@
 from test import *
 from testGradient import *
 
+def meshCacheWriteCheck(output):
+  return "Wrote mesh cache" in output
+
+def meshCacheReadCheck(output):
+  return "Loaded mesh cache" in output
+
 def main():
   failCount=0;
 
@@ -113,6 +119,45 @@ def main():
                                               mesh=testDir+"/cubeHex.msh"),
                     referenceNorm=0.942816869518335)
 
+  #the MPI-IO reader must match the serial reader
+  failCount += test(name="testMeshTri_ReadMsh_MPIIO", ranks=4,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=3,data_file=gradientData2D,dim=2,
+                                              mesh=testDir+"/squareTri.msh",
+                                              mesh_reader="MPIIO"),
+                    referenceNorm=0.580787485719841)
+
+  failCount += test(name="testMeshHex_ReadMsh_MPIIO", ranks=4,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=12,data_file=gradientData3D,dim=3,
+                                              mesh=testDir+"/cubeHex.msh",
+                                              mesh_reader="MPIIO"),
+                    referenceNorm=0.942816869518335)
+
+  #run a BOX mesh twice, the second run loads the mesh from the cache
+  for file_name in os.listdir(testDir):
+    if file_name.startswith('meshCache') and file_name.endswith('.bin'):
+      os.remove(testDir + "/" + file_name)
+
+  failCount += test(name="testMeshQuad_CacheWrite",
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=4,data_file=gradientData2D,dim=2,
+                                              mesh_cache=testDir+"/meshCache"),
+                    referenceNorm=4.44288293763069,
+                    checkOutput=meshCacheWriteCheck)
+
+  failCount += test(name="testMeshQuad_CacheRead",
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=4,data_file=gradientData2D,dim=2,
+                                              mesh_cache=testDir+"/meshCache"),
+                    referenceNorm=4.44288293763069,
+                    checkOutput=meshCacheReadCheck)
+
+  #clean up
+  for file_name in os.listdir(testDir):
+    if file_name.startswith('meshCache') and file_name.endswith('.bin'):
+      os.remove(testDir + "/" + file_name)
+
   return failCount
 
 if __name__ == "__main__":